@@ -11,6 +11,7 @@
 #include <concepts>
 #include <pp_allocator.h>
 #include <not_implemented.h>
+#include <fixed_big_int.h>
 
 namespace __detail
 {
@@ -108,6 +109,11 @@ public:
 
     big_int(pp_allocator<unsigned int> = pp_allocator<unsigned int>());
 
+    /** Copies limbs of a compile-time value, nothing is parsed at runtime
+     */
+    template<size_t N>
+    big_int(fixed_big_int<N> const &value, pp_allocator<unsigned int> = pp_allocator<unsigned int>());
+
     explicit operator bool() const noexcept; //false if 0 , else true
 
     big_int& operator++() &;
@@ -135,6 +141,17 @@ public:
 
     big_int& multiply_assign(const big_int& other, multiplication_rule rule = multiplication_rule::trivial) &;
 
+    /** Needs about half of the partial products of a general multiplication,
+     *  used by operator* and multiply_assign when both operands are the same object
+     */
+    big_int square() const;
+
+    big_int square(multiplication_rule rule) const;
+
+    /** Left-to-right binary exponentiation
+     */
+    big_int pow(uint64_t exponent) const;
+
     big_int& operator/=(const big_int& other) &;
 
     big_int& divide_assign(const big_int& other, division_rule rule = division_rule::trivial) &;
@@ -181,6 +198,12 @@ public:
     std::string to_string() const;
 
     friend big_int multiply_karatsuba(const big_int &a, const big_int &b);
+
+    friend big_int square_karatsuba(const big_int &a);
+
+    friend class modular_context;
+
+    friend class big_int_batch;
 };
 
 template<class alloc>
@@ -224,7 +247,17 @@ big_int::big_int(Num d, pp_allocator<unsigned int> allocator) : _sign(d >= 0), _
 
 }
 
-big_int operator""_bi(unsigned long long n);
+template<size_t N>
+big_int::big_int(fixed_big_int<N> const &value, pp_allocator<unsigned int> allocator)
+    : _sign(value.sign()), _digits(value.digits().begin(), value.digits().begin() + value.size(), allocator) {}
+
+/** Literal of any length, parsed during compilation
+ */
+template<char... Chars>
+big_int operator""_bi()
+{
+    return big_int(__detail::big_int_literal<Chars...>::value);
+}
 
 constexpr std::size_t karatsuba = 32;
 
@@ -0,0 +1,84 @@
+#ifndef MP_OS_BIG_INT_BATCH_H
+#define MP_OS_BIG_INT_BATCH_H
+
+#include <vector>
+#include <compare>
+#include <span>
+#include <string>
+#include <ranges>
+#include <big_int.h>
+
+/** Many independent big_int values in structure-of-arrays form.
+ *  Magnitudes of all numbers lie back to back in one limb buffer,
+ *  number i occupies limbs [offsets[i], offsets[i + 1]), so batch kernels
+ *  walk contiguous memory instead of one heap vector per number.
+ *  Every stored magnitude is trimmed and has at least one limb, zero is positive, as in big_int.
+ */
+class big_int_batch final
+{
+    std::vector<unsigned int, pp_allocator<unsigned int>> _limbs;
+    std::vector<size_t, pp_allocator<size_t>> _offsets;
+    std::vector<unsigned char, pp_allocator<unsigned char>> _signs; // 1 +  0 -
+
+public:
+
+    explicit big_int_batch(pp_allocator<unsigned int> allocator = pp_allocator<unsigned int>());
+
+    template<std::ranges::input_range Range>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, big_int const &>
+    explicit big_int_batch(Range &&numbers, pp_allocator<unsigned int> allocator = pp_allocator<unsigned int>());
+
+    size_t size() const noexcept;
+
+    bool empty() const noexcept;
+
+    void reserve(size_t numbers, size_t limbs);
+
+    void clear() noexcept;
+
+    void push_back(big_int const &value);
+
+    /** Materializes one number
+     */
+    big_int operator[](size_t index) const;
+
+    std::span<unsigned int const> digits(size_t index) const noexcept;
+
+    bool sign(size_t index) const noexcept;
+
+    /** Element-wise sum, throws std::invalid_argument on size mismatch
+     */
+    big_int_batch operator+(big_int_batch const &other) const;
+
+    big_int_batch &operator+=(big_int_batch const &other) &;
+
+    /** Multiplies every number by the same scalar
+     */
+    big_int_batch &multiply_assign(long long scalar) &;
+
+    /** Element-wise this[i] <=> other[i], throws std::invalid_argument on size mismatch
+     */
+    std::vector<std::strong_ordering> compare(big_int_batch const &other) const;
+
+    /** Decimal representation of every number
+     */
+    std::vector<std::string> to_string() const;
+
+private:
+
+    size_t length(size_t index) const noexcept;
+
+    void push_back(unsigned int const *digits, size_t size, bool sign);
+};
+
+template<std::ranges::input_range Range>
+requires std::convertible_to<std::ranges::range_reference_t<Range>, big_int const &>
+big_int_batch::big_int_batch(Range &&numbers, pp_allocator<unsigned int> allocator)
+    : big_int_batch(allocator)
+{
+    for (auto &&number : numbers) {
+        push_back(number);
+    }
+}
+
+#endif //MP_OS_BIG_INT_BATCH_H
@@ -0,0 +1,362 @@
+#ifndef MP_OS_FIXED_BIG_INT_H
+#define MP_OS_FIXED_BIG_INT_H
+
+#include <array>
+#include <compare>
+#include <concepts>
+#include <stdexcept>
+
+/** Signed integer of N limbs (base 2^32, little-endian) usable in constant expressions.
+ *  Results that do not fit into N limbs throw std::overflow_error,
+ *  which makes such expressions ill-formed during constant evaluation.
+ */
+template<size_t N>
+class fixed_big_int final
+{
+    static_assert(N > 0, "fixed_big_int needs at least one limb");
+
+    bool _sign; // 1 +  0 -
+    std::array<unsigned int, N> _digits;
+
+    static constexpr size_t limb_bits = 8 * sizeof(unsigned int);
+
+public:
+
+    using value_type = unsigned int;
+
+    constexpr fixed_big_int() noexcept : _sign(true), _digits{} {}
+
+    template<std::integral Num>
+    constexpr fixed_big_int(Num d) : _sign(d >= 0), _digits{}
+    {
+        auto abs_d = static_cast<unsigned long long>(d);
+
+        if (d < 0) {
+            abs_d = 0ULL - abs_d;
+        }
+
+        for (size_t i = 0; abs_d; ++i, abs_d >>= limb_bits) {
+            if (i == N) {
+                throw std::overflow_error("Value does not fit into fixed_big_int");
+            }
+
+            _digits[i] = static_cast<unsigned int>(abs_d);
+        }
+    }
+
+    constexpr fixed_big_int(std::array<unsigned int, N> const &digits, bool sign = true) noexcept : _sign(sign), _digits(digits)
+    {
+        normalize_sign();
+    }
+
+    /** Implicit widening, so values of different widths mix in expressions
+     */
+    template<size_t M>
+    requires (M < N)
+    constexpr fixed_big_int(fixed_big_int<M> const &other) noexcept : _sign(other.sign()), _digits{}
+    {
+        for (size_t i = 0; i < M; ++i) {
+            _digits[i] = other.digits()[i];
+        }
+    }
+
+    static constexpr size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    /** Limbs up to the most significant non-zero one, at least one
+     */
+    constexpr size_t size() const noexcept
+    {
+        size_t size = N;
+
+        while (size > 1 && _digits[size - 1] == 0) {
+            --size;
+        }
+
+        return size;
+    }
+
+    constexpr std::array<unsigned int, N> const &digits() const noexcept
+    {
+        return _digits;
+    }
+
+    constexpr bool sign() const noexcept
+    {
+        return _sign;
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        for (auto digit : _digits) {
+            if (digit) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    constexpr fixed_big_int operator-() const noexcept
+    {
+        fixed_big_int result = *this;
+        result._sign = !_sign;
+        result.normalize_sign();
+        return result;
+    }
+
+    constexpr fixed_big_int &operator+=(fixed_big_int const &other) &
+    {
+        if (_sign == other._sign) {
+            add_magnitude(other._digits);
+        } else if (compare_magnitude(_digits, other._digits) >= 0) {
+            subtract_magnitude(_digits, other._digits);
+        } else {
+            auto digits = other._digits;
+            subtract_magnitude(digits, _digits);
+            _digits = digits;
+            _sign = other._sign;
+        }
+
+        normalize_sign();
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator-=(fixed_big_int const &other) &
+    {
+        return *this += -other;
+    }
+
+    constexpr fixed_big_int &operator*=(fixed_big_int const &other) &
+    {
+        std::array<unsigned int, N> result{};
+
+        for (size_t i = 0; i < N; ++i) {
+            unsigned long long carry = 0;
+
+            if (_digits[i] == 0) {
+                continue;
+            }
+
+            for (size_t j = 0; j < N; ++j) {
+                unsigned long long current = static_cast<unsigned long long>(_digits[i]) * other._digits[j] + carry;
+
+                if (i + j < N) {
+                    current += result[i + j];
+                    result[i + j] = static_cast<unsigned int>(current);
+                } else if (static_cast<unsigned int>(current)) {
+                    throw std::overflow_error("Product does not fit into fixed_big_int");
+                }
+
+                carry = current >> limb_bits;
+            }
+
+            if (carry) {
+                throw std::overflow_error("Product does not fit into fixed_big_int");
+            }
+        }
+
+        _digits = result;
+        _sign = _sign == other._sign;
+        normalize_sign();
+        return *this;
+    }
+
+    /** Multiplies by a single limb and adds a single limb, the building block of literal parsing
+     */
+    constexpr fixed_big_int &multiply_add(unsigned int multiplier, unsigned int addend) &
+    {
+        unsigned long long carry = addend;
+
+        for (auto &digit : _digits) {
+            carry += static_cast<unsigned long long>(digit) * multiplier;
+            digit = static_cast<unsigned int>(carry);
+            carry >>= limb_bits;
+        }
+
+        if (carry) {
+            throw std::overflow_error("Value does not fit into fixed_big_int");
+        }
+
+        return *this;
+    }
+
+    friend constexpr fixed_big_int operator+(fixed_big_int lhs, fixed_big_int const &rhs)
+    {
+        return lhs += rhs;
+    }
+
+    friend constexpr fixed_big_int operator-(fixed_big_int lhs, fixed_big_int const &rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    friend constexpr fixed_big_int operator*(fixed_big_int lhs, fixed_big_int const &rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    friend constexpr std::strong_ordering operator<=>(fixed_big_int const &lhs, fixed_big_int const &rhs) noexcept
+    {
+        if (lhs._sign != rhs._sign) {
+            return lhs._sign ? std::strong_ordering::greater : std::strong_ordering::less;
+        }
+
+        int order = compare_magnitude(lhs._digits, rhs._digits);
+        return lhs._sign ? order <=> 0 : 0 <=> order;
+    }
+
+    friend constexpr bool operator==(fixed_big_int const &lhs, fixed_big_int const &rhs) noexcept
+    {
+        return lhs._sign == rhs._sign && lhs._digits == rhs._digits;
+    }
+
+    /** Same value in a wider or narrower type, throws std::overflow_error if it does not fit
+     */
+    template<size_t M>
+    constexpr fixed_big_int<M> resize() const
+    {
+        std::array<unsigned int, M> digits{};
+
+        for (size_t i = 0; i < N; ++i) {
+            if (i < M) {
+                digits[i] = _digits[i];
+            } else if (_digits[i]) {
+                throw std::overflow_error("Value does not fit into fixed_big_int");
+            }
+        }
+
+        return fixed_big_int<M>(digits, _sign);
+    }
+
+private:
+
+    constexpr void normalize_sign() noexcept
+    {
+        if (!*this) {
+            _sign = true;
+        }
+    }
+
+    constexpr void add_magnitude(std::array<unsigned int, N> const &other)
+    {
+        unsigned long long carry = 0;
+
+        for (size_t i = 0; i < N; ++i) {
+            carry += static_cast<unsigned long long>(_digits[i]) + other[i];
+            _digits[i] = static_cast<unsigned int>(carry);
+            carry >>= limb_bits;
+        }
+
+        if (carry) {
+            throw std::overflow_error("Sum does not fit into fixed_big_int");
+        }
+    }
+
+    // lhs -= rhs for lhs >= rhs
+    static constexpr void subtract_magnitude(std::array<unsigned int, N> &lhs, std::array<unsigned int, N> const &rhs) noexcept
+    {
+        unsigned long long borrow = 0;
+
+        for (size_t i = 0; i < N; ++i) {
+            unsigned long long sub = rhs[i] + borrow;
+            borrow = lhs[i] < sub ? 1 : 0;
+            lhs[i] = static_cast<unsigned int>(lhs[i] - sub);
+        }
+    }
+
+    static constexpr int compare_magnitude(std::array<unsigned int, N> const &lhs, std::array<unsigned int, N> const &rhs) noexcept
+    {
+        for (size_t i = N; i-- > 0;) {
+            if (lhs[i] != rhs[i]) {
+                return lhs[i] < rhs[i] ? -1 : 1;
+            }
+        }
+
+        return 0;
+    }
+};
+
+namespace __detail
+{
+    constexpr unsigned int literal_digit(char c)
+    {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+
+        throw std::invalid_argument("Only integer literals are allowed");
+    }
+
+    /** Parses an integer literal (decimal, 0x, 0b, leading-zero octal, ' separators) at compile time
+     *  into the narrowest fixed_big_int holding it
+     */
+    template<char... Chars>
+    struct big_int_literal
+    {
+        static constexpr std::array<char, sizeof...(Chars)> text{Chars...};
+
+        static constexpr unsigned int radix = []
+        {
+            if (text.size() > 1 && text[0] == '0') {
+                if (text[1] == 'x' || text[1] == 'X') {
+                    return 16u;
+                }
+
+                if (text[1] == 'b' || text[1] == 'B') {
+                    return 2u;
+                }
+
+                return 8u;
+            }
+
+            return 10u;
+        }();
+
+        static constexpr size_t prefix = radix == 16 || radix == 2 ? 2 : 0;
+
+        // Every digit takes at most 4 bits
+        static constexpr size_t bound = (4 * (text.size() - prefix)) / (8 * sizeof(unsigned int)) + 1;
+
+        static constexpr fixed_big_int<bound> wide = []
+        {
+            fixed_big_int<bound> result;
+
+            for (size_t i = prefix; i < text.size(); ++i) {
+                if (text[i] == '\'') {
+                    continue;
+                }
+
+                unsigned int digit = literal_digit(text[i]);
+
+                if (digit >= radix) {
+                    throw std::invalid_argument("Digit is out of literal radix");
+                }
+
+                result.multiply_add(radix, digit);
+            }
+
+            return result;
+        }();
+
+        static constexpr fixed_big_int<wide.size()> value = wide.template resize<wide.size()>();
+    };
+}
+
+template<char... Chars>
+constexpr auto operator""_fbi()
+{
+    return __detail::big_int_literal<Chars...>::value;
+}
+
+#endif //MP_OS_FIXED_BIG_INT_H
@@ -0,0 +1,71 @@
+#ifndef MP_OS_MODULAR_CONTEXT_H
+#define MP_OS_MODULAR_CONTEXT_H
+
+#include <vector>
+#include <big_int.h>
+
+/** Arithmetic modulo a fixed big_int modulus.
+ *  Constants are computed once per modulus: Montgomery factor and R^2 mod m for odd moduli,
+ *  Barrett factor floor(b^2k / m) for any modulus (b = 2^32, k = limbs of m).
+ *  All results are in [0, m).
+ */
+class modular_context final
+{
+    using limbs = std::vector<unsigned int, pp_allocator<unsigned int>>;
+
+    limbs _modulus;
+    size_t _size;
+    bool _odd;
+
+    // -m^-1 mod b, used only when _odd
+    unsigned int _montgomery_factor;
+
+    // R^2 mod m with R = b^k
+    limbs _montgomery_r2;
+
+    // floor(b^2k / m)
+    limbs _barrett_factor;
+
+    big_int _modulus_value;
+
+public:
+
+    /** Throws std::invalid_argument if modulus < 2
+     */
+    explicit modular_context(big_int const &modulus);
+
+    big_int const &modulus() const noexcept;
+
+    /** Value mod m, negative values are mapped into [0, m) too
+     */
+    big_int reduce(big_int const &value) const;
+
+    big_int mod_mul(big_int const &lhs, big_int const &rhs) const;
+
+    /** Sliding-window exponentiation, in Montgomery domain for odd moduli and with Barrett reduction otherwise.
+     *  Negative exponent means power of the inverse.
+     */
+    big_int mod_pow(big_int const &base, big_int const &exponent) const;
+
+    /** Throws std::invalid_argument if value and modulus are not coprime
+     */
+    big_int mod_inverse(big_int const &value) const;
+
+private:
+
+    static bool is_odd(big_int const &value) noexcept;
+
+    limbs residue(big_int const &value) const;
+
+    limbs reduce_limbs(limbs const &value) const;
+
+    limbs barrett_reduce(limbs const &value) const;
+
+    limbs multiply_reduce(limbs const &lhs, limbs const &rhs) const;
+
+    void montgomery_multiply(unsigned int const *lhs, unsigned int const *rhs, unsigned int *result, unsigned int *scratch) const noexcept;
+
+    big_int to_big_int(limbs value) const;
+};
+
+#endif //MP_OS_MODULAR_CONTEXT_H
@@ -9,6 +9,7 @@
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <bit>
 
 unsigned long long BASE = 1ULL << (8 * sizeof(unsigned int));
 
@@ -22,6 +23,46 @@ void removing_zeros(std::vector<unsigned int, pp_allocator<unsigned int>> &digit
     }
 }
 
+// Schoolbook squaring: every cross product a[i] * a[j], i < j, is computed once and doubled
+std::vector<unsigned int, pp_allocator<unsigned int>> square_digits(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits) {
+    const size_t size = digits.size();
+    std::vector<unsigned int, pp_allocator<unsigned int>> result(2 * size, 0, digits.get_allocator());
+
+    for (size_t i = 0; i < size; ++i) {
+        unsigned long long carry = 0;
+
+        for (size_t j = i + 1; j < size; ++j) {
+            unsigned long long current = static_cast<unsigned long long>(digits[i]) * digits[j] + result[i + j] + carry;
+            result[i + j] = static_cast<unsigned int>(current);
+            carry = current >> 32;
+        }
+
+        result[i + size] = static_cast<unsigned int>(carry);
+    }
+
+    unsigned int top_bit = 0;
+
+    for (auto &digit : result) {
+        unsigned int next = digit >> 31;
+        digit = (digit << 1) | top_bit;
+        top_bit = next;
+    }
+
+    unsigned long long carry = 0;
+
+    for (size_t i = 0; i < size; ++i) {
+        unsigned long long current = static_cast<unsigned long long>(digits[i]) * digits[i] + result[2 * i] + carry;
+        result[2 * i] = static_cast<unsigned int>(current);
+
+        current = (current >> 32) + result[2 * i + 1];
+        result[2 * i + 1] = static_cast<unsigned int>(current);
+        carry = current >> 32;
+    }
+
+    removing_zeros(result);
+    return result;
+}
+
 // strong_ordering : less, equal, greater
 std::strong_ordering big_int::operator<=>(const big_int &other) const noexcept
 {
@@ -109,6 +150,10 @@ big_int big_int::operator-(const big_int &other) const
 
 big_int big_int::operator*(const big_int &other) const
 {
+    if (this == &other) {
+        return square();
+    }
+
     big_int tmp = *this;
     return tmp *= other;
 }
@@ -525,6 +570,11 @@ big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_
         return *this;
     }
 
+    if (this == &other) {
+        *this = square(rule);
+        return *this;
+    }
+
     if (is_zero(other._digits)) {
         _digits = {0};
         _sign = true;
@@ -573,6 +623,40 @@ big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_
     return *this;
 }
 
+big_int big_int::square() const
+{
+    return square(decide_mult(_digits.size()));
+}
+
+big_int big_int::square(big_int::multiplication_rule rule) const
+{
+    // No FFT squaring yet, Schonhage-Strassen falls back to Karatsuba
+    if (rule != multiplication_rule::trivial) {
+        return square_karatsuba(*this);
+    }
+
+    return big_int(square_digits(_digits));
+}
+
+big_int big_int::pow(uint64_t exponent) const
+{
+    if (exponent == 0) {
+        return big_int(1, _digits.get_allocator());
+    }
+
+    big_int result = *this;
+
+    for (int bit = std::bit_width(exponent) - 2; bit >= 0; --bit) {
+        result = result.square();
+
+        if ((exponent >> bit) & 1u) {
+            result *= *this;
+        }
+    }
+
+    return result;
+}
+
 big_int &big_int::divide_assign(const big_int &other, big_int::division_rule rule) &
 {
     if (is_zero(_digits)) {
@@ -711,11 +795,6 @@ big_int::division_rule big_int::decide_div(size_t rhs) const noexcept {
     return division_rule::trivial;
 }
 
-big_int operator""_bi(unsigned long long n)
-{
-    return {n};
-}
-
 big_int multiply_karatsuba(const big_int &a, const big_int &b) {
     if (a._digits.size() < karatsuba || b._digits.size() < karatsuba) {
         big_int result = a;
@@ -767,4 +846,34 @@ big_int multiply_karatsuba(const big_int &a, const big_int &b) {
 
     removing_zeros(z2._digits);
     return z2;
-}
\ No newline at end of file
+}
+
+big_int square_karatsuba(const big_int &a) {
+    if (a._digits.size() < karatsuba) {
+        return big_int(square_digits(a._digits));
+    }
+
+    // (h * B^m + l)^2 = h^2 * B^2m + ((h + l)^2 - h^2 - l^2) * B^m + l^2
+    size_t half_size = a._digits.size() / 2;
+
+    big_int low(a._digits.get_allocator()), high(a._digits.get_allocator());
+
+    low._digits.assign(a._digits.begin(), a._digits.begin() + static_cast<long long>(half_size));
+    high._digits.assign(a._digits.begin() + static_cast<long long>(half_size), a._digits.end());
+    removing_zeros(low._digits);
+
+    big_int z0 = square_karatsuba(low);
+    big_int z2 = square_karatsuba(high);
+
+    big_int sum = low;
+    sum.plus_assign(high);
+
+    big_int z1 = square_karatsuba(sum);
+    z1.minus_assign(z0);
+    z1.minus_assign(z2);
+
+    z0.plus_assign(z1, half_size);
+    z0.plus_assign(z2, 2 * half_size);
+
+    return z0;
+}
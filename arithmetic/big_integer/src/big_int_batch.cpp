@@ -0,0 +1,351 @@
+#include "../include/big_int_batch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    constexpr size_t limb_bits = 8 * sizeof(unsigned int);
+
+    constexpr unsigned int decimal_chunk = 1000000000u;
+    constexpr size_t decimal_chunk_digits = 9;
+
+    size_t trimmed(unsigned int const *digits, size_t size) noexcept
+    {
+        while (size > 1 && digits[size - 1] == 0) {
+            --size;
+        }
+
+        return size;
+    }
+
+    int compare_magnitudes(unsigned int const *lhs, size_t lhs_size, unsigned int const *rhs, size_t rhs_size) noexcept
+    {
+        if (lhs_size != rhs_size) {
+            return lhs_size < rhs_size ? -1 : 1;
+        }
+
+        for (size_t i = lhs_size; i-- > 0;) {
+            if (lhs[i] != rhs[i]) {
+                return lhs[i] < rhs[i] ? -1 : 1;
+            }
+        }
+
+        return 0;
+    }
+
+    // result = lhs + rhs, result has room for max(lhs_size, rhs_size) + 1 limbs; returns trimmed size
+    size_t add_magnitudes(unsigned int const *lhs, size_t lhs_size, unsigned int const *rhs, size_t rhs_size, unsigned int *result) noexcept
+    {
+        if (lhs_size < rhs_size) {
+            std::swap(lhs, rhs);
+            std::swap(lhs_size, rhs_size);
+        }
+
+        unsigned long long carry = 0;
+        size_t i = 0;
+
+        for (; i < rhs_size; ++i) {
+            carry += static_cast<unsigned long long>(lhs[i]) + rhs[i];
+            result[i] = static_cast<unsigned int>(carry);
+            carry >>= limb_bits;
+        }
+
+        for (; i < lhs_size; ++i) {
+            carry += lhs[i];
+            result[i] = static_cast<unsigned int>(carry);
+            carry >>= limb_bits;
+        }
+
+        result[i] = static_cast<unsigned int>(carry);
+
+        return trimmed(result, lhs_size + 1);
+    }
+
+    // result = lhs - rhs for lhs >= rhs, result has room for lhs_size limbs; returns trimmed size
+    size_t subtract_magnitudes(unsigned int const *lhs, size_t lhs_size, unsigned int const *rhs, size_t rhs_size, unsigned int *result) noexcept
+    {
+        unsigned long long borrow = 0;
+
+        for (size_t i = 0; i < lhs_size; ++i) {
+            unsigned long long sub = (i < rhs_size ? rhs[i] : 0ULL) + borrow;
+            borrow = lhs[i] < sub ? 1 : 0;
+            result[i] = static_cast<unsigned int>(lhs[i] - sub);
+        }
+
+        return trimmed(result, lhs_size);
+    }
+
+    // result = value * (high * b + low), result has room for size + 2 limbs; returns trimmed size
+    size_t multiply_magnitude(unsigned int const *value, size_t size, unsigned int low, unsigned int high, unsigned int *result) noexcept
+    {
+        unsigned long long carry = 0;
+
+        for (size_t i = 0; i < size; ++i) {
+            carry += static_cast<unsigned long long>(value[i]) * low;
+            result[i] = static_cast<unsigned int>(carry);
+            carry >>= limb_bits;
+        }
+
+        result[size] = static_cast<unsigned int>(carry);
+        result[size + 1] = 0;
+
+        if (high) {
+            carry = 0;
+
+            for (size_t i = 0; i < size; ++i) {
+                carry += static_cast<unsigned long long>(value[i]) * high + result[i + 1];
+                result[i + 1] = static_cast<unsigned int>(carry);
+                carry >>= limb_bits;
+            }
+
+            result[size + 1] = static_cast<unsigned int>(carry);
+        }
+
+        return trimmed(result, size + 2);
+    }
+
+    // value /= divisor in place, returns remainder
+    unsigned int divide_magnitude(unsigned int *value, size_t size, unsigned int divisor) noexcept
+    {
+        unsigned long long remainder = 0;
+
+        for (size_t i = size; i-- > 0;) {
+            unsigned long long current = (remainder << limb_bits) | value[i];
+            value[i] = static_cast<unsigned int>(current / divisor);
+            remainder = current % divisor;
+        }
+
+        return static_cast<unsigned int>(remainder);
+    }
+}
+
+// region big_int_batch implementation
+
+big_int_batch::big_int_batch(pp_allocator<unsigned int> allocator)
+    : _limbs(allocator), _offsets(1, 0, allocator), _signs(allocator) {}
+
+size_t big_int_batch::size() const noexcept
+{
+    return _signs.size();
+}
+
+bool big_int_batch::empty() const noexcept
+{
+    return _signs.empty();
+}
+
+void big_int_batch::reserve(size_t numbers, size_t limbs)
+{
+    _limbs.reserve(limbs);
+    _offsets.reserve(numbers + 1);
+    _signs.reserve(numbers);
+}
+
+void big_int_batch::clear() noexcept
+{
+    _limbs.clear();
+    _offsets.resize(1);
+    _signs.clear();
+}
+
+size_t big_int_batch::length(size_t index) const noexcept
+{
+    return _offsets[index + 1] - _offsets[index];
+}
+
+void big_int_batch::push_back(unsigned int const *digits, size_t size, bool sign)
+{
+    size = trimmed(digits, size);
+
+    _limbs.insert(_limbs.end(), digits, digits + size);
+    _offsets.push_back(_limbs.size());
+    _signs.push_back(sign || (size == 1 && digits[0] == 0));
+}
+
+void big_int_batch::push_back(big_int const &value)
+{
+    push_back(value._digits.data(), value._digits.size(), value._sign);
+}
+
+big_int big_int_batch::operator[](size_t index) const
+{
+    if (index >= size()) {
+        throw std::out_of_range("Batch index is out of range");
+    }
+
+    auto number = digits(index);
+
+    return big_int(std::vector<unsigned int, pp_allocator<unsigned int>>(number.begin(), number.end(), _limbs.get_allocator()), _signs[index]);
+}
+
+std::span<unsigned int const> big_int_batch::digits(size_t index) const noexcept
+{
+    return {_limbs.data() + _offsets[index], length(index)};
+}
+
+bool big_int_batch::sign(size_t index) const noexcept
+{
+    return _signs[index];
+}
+
+big_int_batch big_int_batch::operator+(big_int_batch const &other) const
+{
+    if (size() != other.size()) {
+        throw std::invalid_argument("Batches must have the same size");
+    }
+
+    big_int_batch result(_limbs.get_allocator());
+    result.reserve(size(), 0);
+
+    size_t capacity = 0;
+
+    for (size_t i = 0; i < size(); ++i) {
+        capacity += std::max(length(i), other.length(i)) + 1;
+    }
+
+    // Every result is written at the compacted cursor, its spare limbs are overwritten by the next one
+    result._limbs.resize(capacity);
+
+    unsigned int const *lhs_limbs = _limbs.data();
+    unsigned int const *rhs_limbs = other._limbs.data();
+    unsigned int *out = result._limbs.data();
+    size_t cursor = 0;
+
+    for (size_t i = 0; i < size(); ++i) {
+        unsigned int const *lhs = lhs_limbs + _offsets[i];
+        unsigned int const *rhs = rhs_limbs + other._offsets[i];
+        size_t lhs_size = length(i), rhs_size = other.length(i);
+
+        size_t written;
+        bool sign;
+
+        if (_signs[i] == other._signs[i]) {
+            written = add_magnitudes(lhs, lhs_size, rhs, rhs_size, out + cursor);
+            sign = _signs[i];
+        } else {
+            int order = compare_magnitudes(lhs, lhs_size, rhs, rhs_size);
+
+            if (order >= 0) {
+                written = subtract_magnitudes(lhs, lhs_size, rhs, rhs_size, out + cursor);
+                sign = _signs[i] || order == 0;
+            } else {
+                written = subtract_magnitudes(rhs, rhs_size, lhs, lhs_size, out + cursor);
+                sign = other._signs[i];
+            }
+        }
+
+        cursor += written;
+        result._offsets.push_back(cursor);
+        result._signs.push_back(sign);
+    }
+
+    result._limbs.resize(cursor);
+
+    return result;
+}
+
+big_int_batch &big_int_batch::operator+=(big_int_batch const &other) &
+{
+    *this = *this + other;
+    return *this;
+}
+
+big_int_batch &big_int_batch::multiply_assign(long long scalar) &
+{
+    bool negative = scalar < 0;
+    auto magnitude = negative ? 0ULL - static_cast<unsigned long long>(scalar) : static_cast<unsigned long long>(scalar);
+    auto low = static_cast<unsigned int>(magnitude);
+    auto high = static_cast<unsigned int>(magnitude >> limb_bits);
+
+    std::vector<unsigned int, pp_allocator<unsigned int>> limbs(_limbs.size() + 2 * size(), _limbs.get_allocator());
+
+    unsigned int const *in = _limbs.data();
+    unsigned int *out = limbs.data();
+    size_t cursor = 0;
+
+    for (size_t i = 0; i < size(); ++i) {
+        size_t written = multiply_magnitude(in + _offsets[i], length(i), low, high, out + cursor);
+
+        _offsets[i] = cursor;
+        cursor += written;
+        _signs[i] = (_signs[i] != negative) || (written == 1 && out[cursor - 1] == 0);
+    }
+
+    _offsets[size()] = cursor;
+    limbs.resize(cursor);
+    _limbs = std::move(limbs);
+
+    return *this;
+}
+
+std::vector<std::strong_ordering> big_int_batch::compare(big_int_batch const &other) const
+{
+    if (size() != other.size()) {
+        throw std::invalid_argument("Batches must have the same size");
+    }
+
+    std::vector<std::strong_ordering> result(size(), std::strong_ordering::equal);
+
+    for (size_t i = 0; i < size(); ++i) {
+        if (_signs[i] != other._signs[i]) {
+            result[i] = _signs[i] ? std::strong_ordering::greater : std::strong_ordering::less;
+            continue;
+        }
+
+        int order = compare_magnitudes(_limbs.data() + _offsets[i], length(i), other._limbs.data() + other._offsets[i], other.length(i));
+
+        if (!_signs[i]) {
+            order = -order;
+        }
+
+        result[i] = order <=> 0;
+    }
+
+    return result;
+}
+
+std::vector<std::string> big_int_batch::to_string() const
+{
+    std::vector<std::string> result;
+    result.reserve(size());
+
+    // Scratch buffers are shared by the whole batch
+    std::vector<unsigned int> scratch;
+    std::vector<unsigned int> chunks;
+
+    for (size_t i = 0; i < size(); ++i) {
+        auto number = digits(i);
+        scratch.assign(number.begin(), number.end());
+        chunks.clear();
+
+        size_t active = scratch.size();
+
+        // Peel off 9 decimal digits per short division instead of one
+        do {
+            chunks.push_back(divide_magnitude(scratch.data(), active, decimal_chunk));
+            active = trimmed(scratch.data(), active);
+        } while (active > 1 || scratch[0] != 0);
+
+        std::string text;
+        text.reserve(chunks.size() * decimal_chunk_digits + 1);
+
+        if (!_signs[i]) {
+            text += '-';
+        }
+
+        text += std::to_string(chunks.back());
+
+        for (size_t j = chunks.size() - 1; j-- > 0;) {
+            auto chunk = std::to_string(chunks[j]);
+            text.append(decimal_chunk_digits - chunk.size(), '0');
+            text += chunk;
+        }
+
+        result.push_back(std::move(text));
+    }
+
+    return result;
+}
+
+// endregion big_int_batch implementation
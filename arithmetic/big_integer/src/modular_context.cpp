@@ -0,0 +1,425 @@
+#include "../include/modular_context.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace
+{
+    using limbs = std::vector<unsigned int, pp_allocator<unsigned int>>;
+
+    constexpr size_t limb_bits = 8 * sizeof(unsigned int);
+
+    void trim(limbs &value)
+    {
+        while (!value.empty() && value.back() == 0) {
+            value.pop_back();
+        }
+    }
+
+    int compare_limbs(unsigned int const *lhs, unsigned int const *rhs, size_t size) noexcept
+    {
+        for (size_t i = size; i-- > 0;) {
+            if (lhs[i] != rhs[i]) {
+                return lhs[i] < rhs[i] ? -1 : 1;
+            }
+        }
+
+        return 0;
+    }
+
+    // lhs -= rhs over lhs_size limbs, rhs is zero-extended; returns final borrow
+    unsigned int subtract_limbs(unsigned int *lhs, size_t lhs_size, unsigned int const *rhs, size_t rhs_size) noexcept
+    {
+        unsigned long long borrow = 0;
+
+        for (size_t i = 0; i < lhs_size; ++i) {
+            unsigned long long sub = (i < rhs_size ? rhs[i] : 0ULL) + borrow;
+            borrow = lhs[i] < sub ? 1 : 0;
+            lhs[i] = static_cast<unsigned int>(lhs[i] - sub);
+        }
+
+        return static_cast<unsigned int>(borrow);
+    }
+
+    limbs multiply_limbs(limbs const &lhs, limbs const &rhs)
+    {
+        limbs result(lhs.size() + rhs.size(), 0, lhs.get_allocator());
+
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            unsigned long long carry = 0;
+            unsigned long long a = lhs[i];
+
+            if (a == 0) {
+                continue;
+            }
+
+            for (size_t j = 0; j < rhs.size(); ++j) {
+                unsigned long long current = a * rhs[j] + result[i + j] + carry;
+                result[i + j] = static_cast<unsigned int>(current);
+                carry = current >> limb_bits;
+            }
+
+            result[i + rhs.size()] = static_cast<unsigned int>(carry);
+        }
+
+        return result;
+    }
+
+    bool test_bit(limbs const &value, size_t bit) noexcept
+    {
+        return (value[bit / limb_bits] >> (bit % limb_bits)) & 1u;
+    }
+
+    size_t bit_length(limbs const &value) noexcept
+    {
+        for (size_t i = value.size(); i-- > 0;) {
+            if (value[i]) {
+                return i * limb_bits + (limb_bits - std::countl_zero(value[i]));
+            }
+        }
+
+        return 0;
+    }
+
+    /** Left-to-right sliding window: odd powers g, g^3, ..., g^(2^w - 1) are precomputed,
+     *  zero bits cost one squaring, every window costs w squarings and one multiplication.
+     */
+    template<typename multiply>
+    limbs sliding_window_pow(limbs const &base, limbs const &one, limbs const &exponent, multiply &&mul)
+    {
+        size_t bits = bit_length(exponent);
+
+        if (bits == 0) {
+            return one;
+        }
+
+        size_t window = bits <= 8 ? 1 : bits <= 24 ? 2 : bits <= 80 ? 3 : bits <= 240 ? 4 : bits <= 672 ? 5 : 6;
+
+        std::vector<limbs> odd_powers(size_t(1) << (window - 1), base);
+        limbs square = mul(base, base);
+
+        for (size_t i = 1; i < odd_powers.size(); ++i) {
+            odd_powers[i] = mul(odd_powers[i - 1], square);
+        }
+
+        limbs result = one;
+        bool started = false;
+        long long i = static_cast<long long>(bits) - 1;
+
+        while (i >= 0) {
+            if (!test_bit(exponent, i)) {
+                if (started) {
+                    result = mul(result, result);
+                }
+
+                --i;
+                continue;
+            }
+
+            long long j = std::max(i - static_cast<long long>(window) + 1, 0LL);
+
+            while (!test_bit(exponent, j)) {
+                ++j;
+            }
+
+            size_t value = 0;
+
+            for (long long bit = i; bit >= j; --bit) {
+                value = (value << 1) | (test_bit(exponent, bit) ? 1 : 0);
+
+                if (started) {
+                    result = mul(result, result);
+                }
+            }
+
+            result = started ? mul(result, odd_powers[value >> 1]) : odd_powers[value >> 1];
+            started = true;
+            i = j - 1;
+        }
+
+        return result;
+    }
+}
+
+bool modular_context::is_odd(big_int const &value) noexcept
+{
+    return value._digits[0] & 1u;
+}
+
+modular_context::modular_context(big_int const &modulus)
+    : _modulus(modulus._digits), _size(0), _odd(false), _montgomery_factor(0),
+      _montgomery_r2(modulus._digits.get_allocator()), _barrett_factor(modulus._digits.get_allocator()), _modulus_value(modulus)
+{
+    if (modulus < 2) {
+        throw std::invalid_argument("Modulus must be greater than 1");
+    }
+
+    trim(_modulus);
+    _size = _modulus.size();
+    _odd = is_odd(modulus);
+
+    // b^2k = q * m + r in one bitwise long division: q is the Barrett factor, r is R^2 mod m
+    size_t numerator_bits = 2 * _size * limb_bits;
+    limbs quotient(2 * _size + 1, 0, _modulus.get_allocator());
+    limbs remainder(_size + 1, 0, _modulus.get_allocator());
+
+    for (size_t bit = numerator_bits + 1; bit-- > 0;) {
+        unsigned int carry = bit == numerator_bits ? 1 : 0;
+
+        for (auto &digit : remainder) {
+            unsigned int next_carry = digit >> (limb_bits - 1);
+            digit = (digit << 1) | carry;
+            carry = next_carry;
+        }
+
+        if (remainder[_size] != 0 || compare_limbs(remainder.data(), _modulus.data(), _size) >= 0) {
+            subtract_limbs(remainder.data(), remainder.size(), _modulus.data(), _size);
+            quotient[bit / limb_bits] |= 1u << (bit % limb_bits);
+        }
+    }
+
+    trim(quotient);
+    _barrett_factor = std::move(quotient);
+
+    if (_odd) {
+        remainder.resize(_size);
+        _montgomery_r2 = std::move(remainder);
+
+        // Newton iteration doubles correct low bits: 1 -> 2 -> 4 -> ... -> 32
+        unsigned int inverse = 1;
+
+        for (int i = 0; i < 5; ++i) {
+            inverse *= 2 - _modulus[0] * inverse;
+        }
+
+        _montgomery_factor = 0u - inverse;
+    }
+}
+
+big_int const &modular_context::modulus() const noexcept
+{
+    return _modulus_value;
+}
+
+big_int modular_context::reduce(big_int const &value) const
+{
+    return to_big_int(residue(value));
+}
+
+big_int modular_context::mod_mul(big_int const &lhs, big_int const &rhs) const
+{
+    return to_big_int(multiply_reduce(residue(lhs), residue(rhs)));
+}
+
+big_int modular_context::mod_pow(big_int const &base, big_int const &exponent) const
+{
+    if (exponent < 0) {
+        return mod_pow(mod_inverse(base), 0_bi - exponent);
+    }
+
+    limbs const &exponent_digits = exponent._digits;
+
+    if (!_odd) {
+        limbs one(_size, 0, _modulus.get_allocator());
+        one[0] = 1;
+
+        return to_big_int(sliding_window_pow(residue(base), one, exponent_digits, [this](limbs const &lhs, limbs const &rhs)
+        {
+            return multiply_reduce(lhs, rhs);
+        }));
+    }
+
+    limbs scratch(_size + 2, 0, _modulus.get_allocator());
+
+    auto montgomery = [this, &scratch](limbs const &lhs, limbs const &rhs)
+    {
+        limbs result(_size, 0, _modulus.get_allocator());
+        montgomery_multiply(lhs.data(), rhs.data(), result.data(), scratch.data());
+        return result;
+    };
+
+    limbs plain_one(_size, 0, _modulus.get_allocator());
+    plain_one[0] = 1;
+
+    // x -> x * R mod m is a Montgomery product with R^2
+    limbs result = sliding_window_pow(montgomery(residue(base), _montgomery_r2), montgomery(plain_one, _montgomery_r2),
+                                      exponent_digits, montgomery);
+
+    return to_big_int(montgomery(result, plain_one));
+}
+
+big_int modular_context::mod_inverse(big_int const &value) const
+{
+    // Binary extended Euclid (HAC 14.61): only shifts and subtractions, C * x = v (mod m) holds throughout
+    big_int x = reduce(value);
+    big_int const &y = _modulus_value;
+
+    if (!x || (!is_odd(x) && !is_odd(y))) {
+        throw std::invalid_argument("Value is not invertible by this modulus");
+    }
+
+    big_int u = x, v = y;
+    big_int a = 1, b = 0, c = 0, d = 1;
+
+    while (u) {
+        while (!is_odd(u)) {
+            u >>= 1;
+
+            if (is_odd(a) || is_odd(b)) {
+                a += y;
+                b -= x;
+            }
+
+            a >>= 1;
+            b >>= 1;
+        }
+
+        while (!is_odd(v)) {
+            v >>= 1;
+
+            if (is_odd(c) || is_odd(d)) {
+                c += y;
+                d -= x;
+            }
+
+            c >>= 1;
+            d >>= 1;
+        }
+
+        if (u >= v) {
+            u -= v;
+            a -= c;
+            b -= d;
+        } else {
+            v -= u;
+            c -= a;
+            d -= b;
+        }
+    }
+
+    if (v != 1) {
+        throw std::invalid_argument("Value is not invertible by this modulus");
+    }
+
+    return reduce(c);
+}
+
+modular_context::limbs modular_context::residue(big_int const &value) const
+{
+    limbs result = reduce_limbs(value._digits);
+
+    if (!value._sign && std::any_of(result.begin(), result.end(), [](unsigned int digit) { return digit != 0; })) {
+        limbs negated = _modulus;
+        subtract_limbs(negated.data(), _size, result.data(), _size);
+        result = std::move(negated);
+    }
+
+    return result;
+}
+
+modular_context::limbs modular_context::reduce_limbs(limbs const &value) const
+{
+    if (value.size() <= 2 * _size) {
+        return barrett_reduce(value);
+    }
+
+    // r = (r * b^|chunk| + chunk) mod m, top chunk first; every step stays below b^2k
+    limbs result(_modulus.get_allocator());
+    size_t end = value.size();
+    size_t chunk = end % _size == 0 ? _size : end % _size;
+
+    while (end > 0) {
+        limbs current(value.begin() + static_cast<ptrdiff_t>(end - chunk), value.begin() + static_cast<ptrdiff_t>(end), _modulus.get_allocator());
+        current.insert(current.end(), result.begin(), result.end());
+        result = barrett_reduce(current);
+
+        end -= chunk;
+        chunk = _size;
+    }
+
+    return result;
+}
+
+modular_context::limbs modular_context::barrett_reduce(limbs const &value) const
+{
+    size_t k = _size;
+    limbs result(k + 1, 0, _modulus.get_allocator());
+
+    std::copy_n(value.begin(), std::min(value.size(), k + 1), result.begin());
+
+    if (value.size() > k - 1) {
+        // q3 = floor(floor(x / b^(k-1)) * mu / b^(k+1)), r = x - q3 * m (mod b^(k+1))
+        limbs high(value.begin() + static_cast<ptrdiff_t>(k - 1), value.end(), _modulus.get_allocator());
+        limbs estimate = multiply_limbs(high, _barrett_factor);
+
+        if (estimate.size() > k + 1) {
+            limbs quotient(estimate.begin() + static_cast<ptrdiff_t>(k + 1), estimate.end(), _modulus.get_allocator());
+            limbs product = multiply_limbs(quotient, _modulus);
+            subtract_limbs(result.data(), k + 1, product.data(), std::min(product.size(), k + 1));
+        }
+    }
+
+    // Barrett estimate is short by at most two
+    while (result[k] != 0 || compare_limbs(result.data(), _modulus.data(), k) >= 0) {
+        subtract_limbs(result.data(), k + 1, _modulus.data(), k);
+    }
+
+    result.resize(k);
+    return result;
+}
+
+modular_context::limbs modular_context::multiply_reduce(limbs const &lhs, limbs const &rhs) const
+{
+    return barrett_reduce(multiply_limbs(lhs, rhs));
+}
+
+void modular_context::montgomery_multiply(unsigned int const *lhs, unsigned int const *rhs, unsigned int *result, unsigned int *scratch) const noexcept
+{
+    // Coarsely integrated operand scanning: result = lhs * rhs * R^-1 mod m, lhs and rhs < m
+    size_t n = _size;
+    unsigned int const *m = _modulus.data();
+    unsigned int *t = scratch;
+
+    std::fill(t, t + n + 2, 0u);
+
+    for (size_t i = 0; i < n; ++i) {
+        unsigned long long carry = 0;
+        unsigned long long b = rhs[i];
+
+        for (size_t j = 0; j < n; ++j) {
+            unsigned long long current = lhs[j] * b + t[j] + carry;
+            t[j] = static_cast<unsigned int>(current);
+            carry = current >> limb_bits;
+        }
+
+        unsigned long long current = t[n] + carry;
+        t[n] = static_cast<unsigned int>(current);
+        t[n + 1] = static_cast<unsigned int>(current >> limb_bits);
+
+        unsigned long long q = static_cast<unsigned int>(t[0] * _montgomery_factor);
+        carry = (q * m[0] + t[0]) >> limb_bits;
+
+        for (size_t j = 1; j < n; ++j) {
+            current = q * m[j] + t[j] + carry;
+            t[j - 1] = static_cast<unsigned int>(current);
+            carry = current >> limb_bits;
+        }
+
+        current = t[n] + carry;
+        t[n - 1] = static_cast<unsigned int>(current);
+        t[n] = t[n + 1] + static_cast<unsigned int>(current >> limb_bits);
+    }
+
+    if (t[n] != 0 || compare_limbs(t, m, n) >= 0) {
+        subtract_limbs(t, n, m, n);
+    }
+
+    std::copy_n(t, n, result);
+}
+
+big_int modular_context::to_big_int(limbs value) const
+{
+    trim(value);
+    return big_int(std::move(value), true);
+}
@@ -165,6 +165,21 @@ TEST(positive_tests_kar, test7)
     delete logger;
 }
 
+TEST(positive_tests_kar, test8)
+{
+    // 40 limbs, squaring goes through Karatsuba
+    big_int bigint_1("4977414122938492192881464029729961679802517669640314331069754317413863193300588672960378941038799444233797200629740876278809425638436874294137213623651683084623545115805694417048191856898335577690331770093271154442020977681305435856437590481321498962517248672813060123683011804992094505499691756946329466238029256908317387659245893361869285485179777099016847012698558309358412176001");
+    big_int expected("24774651351227559473350661463325337306773615885659979061891612262231599457265160184161375299511485623757853218934776946204343257802517875860535813582497532054921369710690202069405090230063565808731367665995626546306001248687480369474978773502165047951327193325883243080985377214102928252485273381108876707342210095363818196517320467601766404809226477639084440552268830651150227233851288894923357958902262021077777396527446490513676194546065564011267588688499799332293964985356642136991830962530993601288071501380412409431003677030392507829529098281614511178363475962303756766451637024921915068716987779642366911947366885908603013702197175403150208322376647534017404223166374081635438391163552522437190243121043363726334460394379878231753006336997172523771800352001");
+
+    EXPECT_EQ(bigint_1.square(), expected);
+    EXPECT_EQ(bigint_1.square(big_int::multiplication_rule::trivial), expected);
+    EXPECT_EQ(bigint_1 * bigint_1, expected);
+
+    bigint_1 *= bigint_1;
+
+    EXPECT_EQ(bigint_1, expected);
+}
+
 int main(
     int argc,
     char **argv)
@@ -231,6 +231,30 @@ TEST(positive_tests, test9)
     delete logger;
 }
 
+TEST(positive_tests, test10)
+{
+    constexpr auto constant = 340282366920938463463374607431768211457_fbi;
+
+    static_assert(constant.size() == 5);
+    static_assert(constant - 1_fbi == fixed_big_int<5>(18446744073709551616_fbi) * 18446744073709551616_fbi);
+    static_assert(-0x1'0000'0000_fbi < 0xFFFF'FFFF_fbi);
+
+    EXPECT_EQ(340282366920938463463374607431768211457_bi, big_int("340282366920938463463374607431768211457"));
+    EXPECT_EQ(0x1'0000'0000'0000'0000_bi, big_int("18446744073709551616"));
+    EXPECT_EQ(0b101_bi + 017_bi, 20);
+    EXPECT_EQ(0_bi, 0);
+    EXPECT_EQ(big_int(-constant), big_int("-340282366920938463463374607431768211457"));
+}
+
+TEST(positive_tests, test11)
+{
+    EXPECT_EQ(big_int(3).pow(800), big_int("4977414122938492192881464029729961679802517669640314331069754317413863193300588672960378941038799444233797200629740876278809425638436874294137213623651683084623545115805694417048191856898335577690331770093271154442020977681305435856437590481321498962517248672813060123683011804992094505499691756946329466238029256908317387659245893361869285485179777099016847012698558309358412176001"));
+    EXPECT_EQ(big_int(-7).pow(3), -343);
+    EXPECT_EQ(big_int(-7).pow(0), 1);
+    EXPECT_EQ(big_int(0).pow(5), 0);
+    EXPECT_EQ(big_int("-18446744073709551615").square(), big_int("340282366920938463426481119284349108225"));
+}
+
 int main(
     int argc,
     char **argv)
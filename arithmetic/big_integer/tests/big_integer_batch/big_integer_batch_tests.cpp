@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <big_int.h>
+#include <big_int_batch.h>
+
+TEST(positive_tests_batch, test1)
+{
+    std::vector<big_int> lhs{big_int("340282366920938463463374607431768211455"), big_int("-1000000000000000000000"), 5, -7, 0};
+    std::vector<big_int> rhs{1, big_int("999999999999999999999"), -5, -8, 0};
+
+    big_int_batch batch(lhs);
+    batch += big_int_batch(rhs);
+
+    ASSERT_EQ(batch.size(), 5);
+    EXPECT_EQ(batch[0], big_int("340282366920938463463374607431768211456"));
+    EXPECT_EQ(batch[1], -1);
+    EXPECT_EQ(batch[2], 0);
+    EXPECT_TRUE(batch.sign(2));
+    EXPECT_EQ(batch[3], -15);
+    EXPECT_EQ(batch[4], 0);
+}
+
+TEST(positive_tests_batch, test2)
+{
+    std::vector<big_int> numbers{big_int("18446744073709551615"), big_int("-123456789012345678901234567890"), 0, 1};
+
+    big_int_batch batch(numbers);
+    batch.multiply_assign(-9223372036854775807LL - 1);
+
+    EXPECT_EQ(batch[0], big_int("-170141183460469231722463931679029329920"));
+    EXPECT_EQ(batch[1], big_int("1138687895536349070124195419011280854005705605120"));
+    EXPECT_EQ(batch[2], 0);
+    EXPECT_TRUE(batch.sign(2));
+    EXPECT_EQ(batch[3], big_int("-9223372036854775808"));
+}
+
+TEST(positive_tests_batch, test3)
+{
+    std::vector<big_int> lhs{big_int("100000000000000000000"), -3, 0, big_int("-100000000000000000000")};
+    std::vector<big_int> rhs{big_int("99999999999999999999"), 2, 0, big_int("-99999999999999999999")};
+
+    auto order = big_int_batch(lhs).compare(big_int_batch(rhs));
+
+    std::vector<std::strong_ordering> expected{std::strong_ordering::greater, std::strong_ordering::less,
+                                               std::strong_ordering::equal, std::strong_ordering::less};
+
+    EXPECT_EQ(order, expected);
+}
+
+TEST(positive_tests_batch, test4)
+{
+    std::vector<big_int> numbers{0, -1, 1000000000, big_int("-340282366920938463463374607431768211456"), big_int("100000000000000000000000000001")};
+
+    std::vector<std::string> expected{"0", "-1", "1000000000", "-340282366920938463463374607431768211456", "100000000000000000000000000001"};
+
+    EXPECT_EQ(big_int_batch(numbers).to_string(), expected);
+}
+
+TEST(negative_tests_batch, test1)
+{
+    std::vector<big_int> numbers{1, 2};
+    big_int_batch batch(numbers);
+
+    EXPECT_THROW(batch + big_int_batch(), std::invalid_argument);
+    EXPECT_THROW(batch.compare(big_int_batch()), std::invalid_argument);
+    EXPECT_THROW(batch[2], std::out_of_range);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
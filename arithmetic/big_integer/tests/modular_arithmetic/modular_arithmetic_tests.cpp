@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <big_int.h>
+#include <modular_context.h>
+
+TEST(positive_tests_mod, test1)
+{
+    // Montgomery path: odd modulus 2^521 - 1
+    modular_context context(big_int("6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151"));
+
+    big_int base("6748128446502486781413518057555089872472948373403523985774674953942821403894698731452975079452686072472667383447879104974049337076141012055322476025271141381636960245266934431894182683667173659381986504285745315868736995765461588432473858749456206119849151685810014141818532483261516098950821960922168");
+    big_int exponent("450563043300108022437192274762516681813546753903174624691014755169129523036554262506075829");
+
+    EXPECT_EQ(context.mod_pow(base, exponent), big_int("3276301539847811260293138426338991673770915205584570756740340517481281277135946655119850545017696061407495746961988773614398623487338830062783053794682148160"));
+}
+
+TEST(positive_tests_mod, test2)
+{
+    // Barrett path: even modulus
+    modular_context context(big_int("1606938044258990275541962092341162602522221440526866544853004"));
+
+    big_int base("978236681116536814996313393706964146528561424463695625955269579138786973616");
+    big_int exponent("1045166320176093926161751232077569363998816456755618240");
+
+    EXPECT_EQ(context.mod_pow(base, exponent), big_int("1175339272640804804860133078808415065763824385401603684766372"));
+    EXPECT_EQ(context.mod_mul(base, base), context.mod_pow(base, 2));
+}
+
+TEST(positive_tests_mod, test3)
+{
+    modular_context context(big_int("6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151"));
+
+    big_int inverse = context.mod_inverse(123456789);
+
+    EXPECT_EQ(inverse, big_int("1289779785910976115808235794064370994628025867679978566900349299092537613572155688207687193427497422253936377091951781352074216157914389185372140567540151659"));
+    EXPECT_EQ(context.mod_mul(inverse, 123456789), 1);
+    EXPECT_EQ(context.mod_pow(123456789, -1), inverse);
+}
+
+TEST(positive_tests_mod, test4)
+{
+    modular_context context(97);
+
+    EXPECT_EQ(context.reduce(-5), 92);
+    EXPECT_EQ(context.mod_mul(-5, 3), 82);
+    EXPECT_EQ(context.mod_pow(5, 0), 1);
+    EXPECT_EQ(context.mod_pow(5, 96), 1);
+    EXPECT_EQ(context.mod_pow(0, 5), 0);
+}
+
+TEST(negative_tests_mod, test1)
+{
+    EXPECT_THROW(modular_context(1), std::invalid_argument);
+    EXPECT_THROW(modular_context(100).mod_inverse(10), std::invalid_argument);
+    EXPECT_THROW(modular_context(97).mod_inverse(0), std::invalid_argument);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -2,6 +2,8 @@
 #define MP_OS_CONTINUED_FRACTION_H
 
 #include <vector>
+#include <iterator>
+#include <ranges>
 
 #include <big_int.h>
 #include <fraction.h>
@@ -9,12 +11,150 @@
 class continued_fraction final
 {
 
+public:
+
+    /** One run of equal moves in a tree path.
+     *  direction == true means "right", false means "left".
+     *  Partial quotients can be huge, so the length is big_int too.
+     */
+    struct path_run
+    {
+        bool direction;
+        big_int length;
+
+        bool operator==(path_run const &other) const noexcept = default;
+    };
+
+    using tree_path = std::vector<path_run>;
+
+    /** Lazily yields partial quotients a0, a1, ... of value.
+     *  Every step costs one division, so callers can stop after k terms:
+     *  @example for (auto &&a : continued_fraction::partial_quotients(x) | std::views::take(k))
+     */
+    class partial_quotients_range : public std::ranges::view_interface<partial_quotients_range>
+    {
+
+    public:
+
+        class iterator
+        {
+            big_int _numerator;
+            big_int _denominator;
+            big_int _current;
+            bool _done;
+
+            void step();
+
+        public:
+
+            using value_type = big_int;
+            using difference_type = ptrdiff_t;
+            using reference = big_int const &;
+            using pointer = big_int const *;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator();
+
+            iterator(big_int numerator, big_int denominator);
+
+            reference operator*() const noexcept;
+
+            pointer operator->() const noexcept;
+
+            iterator &operator++();
+
+            void operator++(int);
+
+            bool operator==(std::default_sentinel_t) const noexcept;
+        };
+
+    private:
+
+        big_int _numerator;
+        big_int _denominator;
+
+    public:
+
+        partial_quotients_range() = default;
+
+        explicit partial_quotients_range(fraction const &value);
+
+        iterator begin() const;
+
+        std::default_sentinel_t end() const noexcept;
+    };
+
+    /** Lazily yields convergents p0/q0, p1/q1, ... via the p/q recurrence.
+     *  Convergents are coprime by construction, so no gcd is computed.
+     */
+    class convergents_range : public std::ranges::view_interface<convergents_range>
+    {
+
+    public:
+
+        class iterator
+        {
+            partial_quotients_range::iterator _quotients;
+            big_int _p_prev, _p;
+            big_int _q_prev, _q;
+            fraction _current;
+
+            void advance();
+
+        public:
+
+            using value_type = fraction;
+            using difference_type = ptrdiff_t;
+            using reference = fraction const &;
+            using pointer = fraction const *;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() = default;
+
+            explicit iterator(partial_quotients_range::iterator quotients);
+
+            reference operator*() const noexcept;
+
+            pointer operator->() const noexcept;
+
+            iterator &operator++();
+
+            void operator++(int);
+
+            bool operator==(std::default_sentinel_t) const noexcept;
+        };
+
+    private:
+
+        partial_quotients_range _quotients;
+
+    public:
+
+        convergents_range() = default;
+
+        explicit convergents_range(fraction const &value);
+
+        iterator begin() const;
+
+        std::default_sentinel_t end() const noexcept;
+    };
+
 private:
 
     continued_fraction() = default;
 
+    static std::pair<big_int, big_int> numerator_denominator(fraction const &value);
+
+    static fraction make_reduced(big_int numerator, big_int denominator);
+
 public:
 
+    static partial_quotients_range partial_quotients(
+        fraction const &value);
+
+    static convergents_range convergents(
+        fraction const &value);
+
     static std::vector<big_int> to_continued_fraction_representation(
         fraction const &value);
 
@@ -27,6 +167,23 @@ public:
     static std::vector<fraction> to_convergents_series(
         std::vector<big_int> const &continued_fraction_representation);
 
+    /** Run-length encoded paths: O(number of partial quotients) instead of O(sum of them)
+     */
+    static tree_path to_Stern_Brokot_tree_path_runs(
+        fraction const &value);
+
+    static fraction from_Stern_Brokot_tree_path(
+        tree_path const &path);
+
+    static tree_path to_Calkin_Wilf_tree_path_runs(
+        fraction const &value);
+
+    static fraction from_Calkin_Wilf_tree_path(
+        tree_path const &path);
+
+    /** Bit-per-step paths, true is "right". Expanded from the runs above,
+     *  so avoid them for values with large partial quotients.
+     */
     static std::vector<bool> to_Stern_Brokot_tree_path(
         fraction const &value);
 
@@ -41,4 +198,4 @@ public:
 
 };
 
-#endif //MP_OS_CONTINUED_FRACTION_H
\ No newline at end of file
+#endif //MP_OS_CONTINUED_FRACTION_H
@@ -1,51 +1,408 @@
 #include "../include/continued_fraction.h"
 
-#include <not_implemented.h>
+#include <algorithm>
+#include <tuple>
+
+// region helpers
+
+std::pair<big_int, big_int> continued_fraction::numerator_denominator(fraction const &value)
+{
+    return {value._numerator, value._denominator};
+}
+
+fraction continued_fraction::make_reduced(big_int numerator, big_int denominator)
+{
+    return fraction(std::move(numerator), std::move(denominator), fraction::reduced_tag{});
+}
+
+namespace
+{
+    // Stern-Brocot and Calkin-Wilf trees hold only positive rationals
+    void check_positive(std::vector<big_int> const &representation)
+    {
+        if (representation.front() < 0 || (representation.size() == 1 && !representation.front())) {
+            throw std::invalid_argument("Tree paths are defined only for positive fractions");
+        }
+    }
+
+    void append_run(continued_fraction::tree_path &path, bool direction, big_int const &length)
+    {
+        if (!length) {
+            return;
+        }
+
+        if (!path.empty() && path.back().direction == direction) {
+            path.back().length += length;
+        } else {
+            path.push_back({direction, length});
+        }
+    }
+
+    std::vector<bool> expand(continued_fraction::tree_path const &path)
+    {
+        std::vector<bool> result;
+
+        for (auto const &run : path) {
+            for (big_int i = 0; i < run.length; ++i) {
+                result.push_back(run.direction);
+            }
+        }
+
+        return result;
+    }
+
+    continued_fraction::tree_path compress(std::vector<bool> const &path)
+    {
+        continued_fraction::tree_path result;
+
+        for (bool direction : path) {
+            if (!result.empty() && result.back().direction == direction) {
+                ++result.back().length;
+            } else {
+                result.push_back({direction, 1});
+            }
+        }
+
+        return result;
+    }
+}
+
+// endregion helpers
+
+// region partial_quotients_range implementation
+
+continued_fraction::partial_quotients_range::iterator::iterator() : _numerator(0), _denominator(0), _current(0), _done(true) {}
+
+continued_fraction::partial_quotients_range::iterator::iterator(big_int numerator, big_int denominator)
+    : _numerator(std::move(numerator)), _denominator(std::move(denominator)), _current(0), _done(false)
+{
+    step();
+}
+
+void continued_fraction::partial_quotients_range::iterator::step()
+{
+    if (!_denominator) {
+        _done = true;
+        return;
+    }
+
+    // One division per term, the remainder comes from the quotient
+    _current = _numerator / _denominator;
+    big_int remainder = _numerator - _current * _denominator;
+
+    // big_int division truncates, continued fractions need floor
+    if (remainder < 0) {
+        --_current;
+        remainder += _denominator;
+    }
+
+    _numerator = std::move(_denominator);
+    _denominator = std::move(remainder);
+}
+
+continued_fraction::partial_quotients_range::iterator::reference
+continued_fraction::partial_quotients_range::iterator::operator*() const noexcept
+{
+    return _current;
+}
+
+continued_fraction::partial_quotients_range::iterator::pointer
+continued_fraction::partial_quotients_range::iterator::operator->() const noexcept
+{
+    return &_current;
+}
+
+continued_fraction::partial_quotients_range::iterator &
+continued_fraction::partial_quotients_range::iterator::operator++()
+{
+    step();
+    return *this;
+}
+
+void continued_fraction::partial_quotients_range::iterator::operator++(int)
+{
+    step();
+}
+
+bool continued_fraction::partial_quotients_range::iterator::operator==(std::default_sentinel_t) const noexcept
+{
+    return _done;
+}
+
+continued_fraction::partial_quotients_range::partial_quotients_range(fraction const &value)
+{
+    std::tie(_numerator, _denominator) = numerator_denominator(value);
+}
+
+continued_fraction::partial_quotients_range::iterator continued_fraction::partial_quotients_range::begin() const
+{
+    return iterator(_numerator, _denominator);
+}
+
+std::default_sentinel_t continued_fraction::partial_quotients_range::end() const noexcept
+{
+    return std::default_sentinel;
+}
+
+// endregion partial_quotients_range implementation
+
+// region convergents_range implementation
+
+continued_fraction::convergents_range::iterator::iterator(partial_quotients_range::iterator quotients)
+    : _quotients(std::move(quotients)), _p_prev(0), _p(1), _q_prev(1), _q(0)
+{
+    advance();
+}
+
+void continued_fraction::convergents_range::iterator::advance()
+{
+    if (_quotients == std::default_sentinel) {
+        return;
+    }
+
+    // p(n) = a(n) * p(n-1) + p(n-2), q(n) = a(n) * q(n-1) + q(n-2)
+    big_int p_next = *_quotients * _p + _p_prev;
+    big_int q_next = *_quotients * _q + _q_prev;
+
+    _p_prev = std::move(_p);
+    _q_prev = std::move(_q);
+    _p = std::move(p_next);
+    _q = std::move(q_next);
+
+    _current = make_reduced(_p, _q);
+}
+
+continued_fraction::convergents_range::iterator::reference
+continued_fraction::convergents_range::iterator::operator*() const noexcept
+{
+    return _current;
+}
+
+continued_fraction::convergents_range::iterator::pointer
+continued_fraction::convergents_range::iterator::operator->() const noexcept
+{
+    return &_current;
+}
+
+continued_fraction::convergents_range::iterator &
+continued_fraction::convergents_range::iterator::operator++()
+{
+    ++_quotients;
+    advance();
+    return *this;
+}
+
+void continued_fraction::convergents_range::iterator::operator++(int)
+{
+    ++*this;
+}
+
+bool continued_fraction::convergents_range::iterator::operator==(std::default_sentinel_t) const noexcept
+{
+    return _quotients == std::default_sentinel;
+}
+
+continued_fraction::convergents_range::convergents_range(fraction const &value) : _quotients(value) {}
+
+continued_fraction::convergents_range::iterator continued_fraction::convergents_range::begin() const
+{
+    return iterator(_quotients.begin());
+}
+
+std::default_sentinel_t continued_fraction::convergents_range::end() const noexcept
+{
+    return std::default_sentinel;
+}
+
+// endregion convergents_range implementation
+
+// region continued_fraction implementation
+
+continued_fraction::partial_quotients_range continued_fraction::partial_quotients(
+    fraction const &value)
+{
+    return partial_quotients_range(value);
+}
+
+continued_fraction::convergents_range continued_fraction::convergents(
+    fraction const &value)
+{
+    return convergents_range(value);
+}
 
 std::vector<big_int> continued_fraction::to_continued_fraction_representation(
     fraction const &value)
 {
-    throw not_implemented("std::vector<big_integer> continued_fraction::to_continued_fraction_representation(fraction const &)", "your code should be here...");
+    std::vector<big_int> result;
+
+    for (auto &&quotient : partial_quotients(value)) {
+        result.push_back(quotient);
+    }
+
+    return result;
 }
 
 fraction continued_fraction::from_continued_fraction_representation(
     std::vector<big_int> const &continued_fraction_representation)
 {
-    throw not_implemented("fraction continued_fraction::from_continued_fraction_representation(std::vector<big_integer> const &)", "your code should be here...");
+    if (continued_fraction_representation.empty()) {
+        throw std::invalid_argument("Continued fraction representation cannot be empty");
+    }
+
+    for (size_t i = 1; i < continued_fraction_representation.size(); ++i) {
+        if (continued_fraction_representation[i] <= 0) {
+            throw std::invalid_argument("Partial quotients after the first one must be positive");
+        }
+    }
+
+    // Backward evaluation: x = a(n), x = a(i) + 1 / x keeps numerator and denominator coprime
+    auto it = continued_fraction_representation.rbegin();
+    big_int numerator = *it, denominator = 1;
+
+    for (++it; it != continued_fraction_representation.rend(); ++it) {
+        big_int next = *it * numerator + denominator;
+        denominator = std::move(numerator);
+        numerator = std::move(next);
+    }
+
+    return make_reduced(std::move(numerator), std::move(denominator));
 }
 
 std::vector<fraction> continued_fraction::to_convergents_series(
     fraction const &value)
 {
-    throw not_implemented("std::vector<fraction> continued_fraction::to_convergents_series(fraction const &)", "your code should be here...");
+    std::vector<fraction> result;
+
+    for (auto &&convergent : convergents(value)) {
+        result.push_back(convergent);
+    }
+
+    return result;
 }
 
 std::vector<fraction> continued_fraction::to_convergents_series(
     std::vector<big_int> const &continued_fraction_representation)
 {
-    throw not_implemented("std::vector<fraction> continued_fraction::to_convergents_series(std::vector<big_integer> const &)", "your code should be here...");
+    if (continued_fraction_representation.empty()) {
+        throw std::invalid_argument("Continued fraction representation cannot be empty");
+    }
+
+    std::vector<fraction> result;
+    result.reserve(continued_fraction_representation.size());
+
+    big_int p_prev = 0, p = 1;
+    big_int q_prev = 1, q = 0;
+
+    for (size_t i = 0; i < continued_fraction_representation.size(); ++i) {
+        auto const &quotient = continued_fraction_representation[i];
+
+        // Convergents stay coprime with positive denominators only for a(i) >= 1
+        if (i > 0 && quotient <= 0) {
+            throw std::invalid_argument("Partial quotients after the first one must be positive");
+        }
+
+        big_int p_next = quotient * p + p_prev;
+        big_int q_next = quotient * q + q_prev;
+
+        p_prev = std::move(p);
+        q_prev = std::move(q);
+        p = std::move(p_next);
+        q = std::move(q_next);
+
+        result.push_back(make_reduced(p, q));
+    }
+
+    return result;
+}
+
+continued_fraction::tree_path continued_fraction::to_Stern_Brokot_tree_path_runs(
+    fraction const &value)
+{
+    // [a0; a1, ..., an] -> R^a0 L^a1 R^a2 ... with the last run shortened by one
+    auto representation = to_continued_fraction_representation(value);
+    check_positive(representation);
+
+    representation.back() -= 1;
+
+    tree_path result;
+    bool direction = true;
+
+    for (auto const &quotient : representation) {
+        append_run(result, direction, quotient);
+        direction = !direction;
+    }
+
+    return result;
+}
+
+fraction continued_fraction::from_Stern_Brokot_tree_path(
+    tree_path const &path)
+{
+    // Product of R^k = (1 k; 0 1) and L^k = (1 0; k 1), the node is (a + b) / (c + d)
+    big_int a = 1, b = 0;
+    big_int c = 0, d = 1;
+
+    for (auto const &run : path) {
+        if (run.direction) {
+            b += a * run.length;
+            d += c * run.length;
+        } else {
+            a += b * run.length;
+            c += d * run.length;
+        }
+    }
+
+    return make_reduced(a + b, c + d);
+}
+
+continued_fraction::tree_path continued_fraction::to_Calkin_Wilf_tree_path_runs(
+    fraction const &value)
+{
+    // Calkin-Wilf path is the Stern-Brocot path read backwards
+    auto path = to_Stern_Brokot_tree_path_runs(value);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+fraction continued_fraction::from_Calkin_Wilf_tree_path(
+    tree_path const &path)
+{
+    // Left child of a/b is a/(a + b), right child is (a + b)/b
+    big_int numerator = 1, denominator = 1;
+
+    for (auto const &run : path) {
+        if (run.direction) {
+            numerator += denominator * run.length;
+        } else {
+            denominator += numerator * run.length;
+        }
+    }
+
+    return make_reduced(std::move(numerator), std::move(denominator));
 }
 
 std::vector<bool> continued_fraction::to_Stern_Brokot_tree_path(
     fraction const &value)
 {
-    throw not_implemented("std::vector<bool> continued_fraction::to_Stern_Brokot_tree_path(fraction const &)", "your code should be here...");
+    return expand(to_Stern_Brokot_tree_path_runs(value));
 }
 
 fraction continued_fraction::from_Stern_Brokot_tree_path(
     std::vector<bool> const &path)
 {
-    throw not_implemented("fraction continued_fraction::from_Stern_Brokot_tree_path(std::vector<bool> const &)", "your code should be here...");
+    return from_Stern_Brokot_tree_path(compress(path));
 }
 
 std::vector<bool> continued_fraction::to_Calkin_Wilf_tree_path(
     fraction const &value)
 {
-    throw not_implemented("std::vector<bool> continued_fraction::to_Calkin_Wilf_tree_path(fraction const &)", "your code should be here...");
+    return expand(to_Calkin_Wilf_tree_path_runs(value));
 }
 
 fraction continued_fraction::from_Calkin_Wilf_tree_path(
     std::vector<bool> const &path)
 {
-    throw not_implemented("fraction continued_fraction::from_Calkin_Wilf_tree_path(std::vector<bool> const &)", "your code should be here...");
-}
\ No newline at end of file
+    return from_Calkin_Wilf_tree_path(compress(path));
+}
+
+// endregion continued_fraction implementation
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <continued_fraction.h>
+
+#include <ranges>
+
+TEST(continued_fraction_positive_tests, test1)
+{
+    auto representation = continued_fraction::to_continued_fraction_representation(fraction(415_bi, 93_bi));
+
+    std::vector<big_int> expected{4, 2, 6, 7};
+
+    EXPECT_EQ(representation, expected);
+    EXPECT_EQ(continued_fraction::from_continued_fraction_representation(representation), fraction(415_bi, 93_bi));
+}
+
+TEST(continued_fraction_positive_tests, test2)
+{
+    // floor semantics for negative values: -7/3 = -3 + 1/(1 + 1/2)
+    auto representation = continued_fraction::to_continued_fraction_representation(fraction(-7, 3));
+
+    std::vector<big_int> expected{-3, 1, 2};
+
+    EXPECT_EQ(representation, expected);
+    EXPECT_EQ(continued_fraction::from_continued_fraction_representation(representation), fraction(-7, 3));
+}
+
+TEST(continued_fraction_positive_tests, test3)
+{
+    auto convergents = continued_fraction::to_convergents_series(fraction(415_bi, 93_bi));
+
+    std::vector<fraction> expected{fraction(4, 1), fraction(9, 2), fraction(58, 13), fraction(415, 93)};
+
+    EXPECT_EQ(convergents, expected);
+    EXPECT_EQ(continued_fraction::to_convergents_series(std::vector<big_int>{4, 2, 6, 7}), expected);
+}
+
+TEST(continued_fraction_positive_tests, test4)
+{
+    std::vector<fraction> first_two;
+
+    for (auto &&convergent : continued_fraction::convergents(fraction(415_bi, 93_bi)) | std::views::take(2)) {
+        first_two.push_back(convergent);
+    }
+
+    std::vector<fraction> expected{fraction(4, 1), fraction(9, 2)};
+
+    EXPECT_EQ(first_two, expected);
+}
+
+TEST(continued_fraction_positive_tests, test5)
+{
+    // 3/2: R L in Stern-Brocot, L R in Calkin-Wilf
+    std::vector<bool> stern_brocot{true, false};
+    std::vector<bool> calkin_wilf{false, true};
+
+    EXPECT_EQ(continued_fraction::to_Stern_Brokot_tree_path(fraction(3, 2)), stern_brocot);
+    EXPECT_EQ(continued_fraction::to_Calkin_Wilf_tree_path(fraction(3, 2)), calkin_wilf);
+    EXPECT_EQ(continued_fraction::from_Stern_Brokot_tree_path(stern_brocot), fraction(3, 2));
+    EXPECT_EQ(continued_fraction::from_Calkin_Wilf_tree_path(calkin_wilf), fraction(3, 2));
+    EXPECT_TRUE(continued_fraction::to_Stern_Brokot_tree_path(fraction(1, 1)).empty());
+}
+
+TEST(continued_fraction_positive_tests, test6)
+{
+    // A huge partial quotient stays a single run
+    big_int large("100000000000000000000");
+    fraction value(large + 1, large);
+
+    auto path = continued_fraction::to_Stern_Brokot_tree_path_runs(value);
+
+    continued_fraction::tree_path expected{{true, 1}, {false, large - 1}};
+
+    EXPECT_EQ(path, expected);
+    EXPECT_EQ(continued_fraction::from_Stern_Brokot_tree_path(path), value);
+    EXPECT_EQ(continued_fraction::from_Calkin_Wilf_tree_path(continued_fraction::to_Calkin_Wilf_tree_path_runs(value)), value);
+}
+
+TEST(continued_fraction_negative_tests, test1)
+{
+    EXPECT_THROW(continued_fraction::to_Stern_Brokot_tree_path(fraction(-1, 2)), std::invalid_argument);
+    EXPECT_THROW(continued_fraction::to_Calkin_Wilf_tree_path(fraction(0, 1)), std::invalid_argument);
+    EXPECT_THROW(continued_fraction::from_continued_fraction_representation({}), std::invalid_argument);
+    EXPECT_THROW(continued_fraction::from_continued_fraction_representation({1, 0, 2}), std::invalid_argument);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
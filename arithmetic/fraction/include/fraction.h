@@ -15,6 +15,17 @@ private:
 
     void optimise(); //сокращает дробь
 
+    struct reduced_tag {};
+
+    /** Skips optimise(): numerator and denominator must already be coprime, denominator positive
+     */
+    fraction(big_int numerator, big_int denominator, reduced_tag) noexcept;
+
+    // pi / 2 to 21 decimal places, built once on first use
+    static const fraction &pi_2();
+
+    friend class continued_fraction;
+
 public:
 
     /** Perfect forwarding ctor
@@ -111,6 +122,4 @@ public:
 
 big_int gcd(big_int a, big_int b);
 
-static const fraction pi_2 = fraction(big_int("15707963267948965579990"), big_int("10000000000000000000000"));
-
 #endif //MP_OS_FRACTION_H
\ No newline at end of file
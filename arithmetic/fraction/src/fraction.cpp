@@ -45,6 +45,15 @@ void fraction::optimise()
 
 fraction::fraction(pp_allocator<big_int::value_type> allocator) : _numerator(0, allocator), _denominator(1, allocator) {}
 
+fraction::fraction(big_int numerator, big_int denominator, reduced_tag) noexcept : _numerator(std::move(numerator)), _denominator(std::move(denominator)) {}
+
+const fraction &fraction::pi_2()
+{
+    // Already coprime, the reduced constructor skips gcd
+    static const fraction value(1570796326794896557999_bi, 1000000000000000000000_bi, reduced_tag{});
+    return value;
+}
+
 fraction &fraction::operator+=(fraction const &other) &
 {
     _numerator = _numerator * other._denominator + _denominator * other._numerator;
@@ -250,7 +259,7 @@ fraction fraction::arccos(fraction const &epsilon) const {
         throw std::domain_error("Arccos is undefined for |x| > 1");
     }
 
-    return pi_2 - this->arcsin(epsilon);
+    return pi_2() - this->arcsin(epsilon);
 }
 
 fraction fraction::tg(fraction const &epsilon) const
@@ -301,7 +310,7 @@ fraction fraction::ctg(fraction const &epsilon) const
 fraction fraction::arcctg(fraction const &epsilon) const {
     // arccot(x) = π/2 - arctan(x)
 
-    return pi_2 - this->arctg(epsilon);
+    return pi_2() - this->arctg(epsilon);
 }
 
 fraction fraction::sec(fraction const &epsilon) const
@@ -346,24 +355,8 @@ fraction fraction::arccosec(fraction const &epsilon) const {
 
 fraction fraction::pow(size_t degree) const
 {
-    if (degree == 0) {
-        return fraction(1, 1);
-    }
-
-    fraction base = *this;
-    fraction result(1, 1);
-
-    while (degree > 0) {
-        if (degree & 1) {
-            result *= base;
-            --degree;
-        }
-
-        base *= base;
-        degree >>= 1;
-    }
-
-    return result;
+    // Powers of coprime numbers stay coprime, no gcd needed
+    return fraction(_numerator.pow(degree), _denominator.pow(degree), reduced_tag{});
 }
 
 fraction fraction::root(size_t n, fraction const &epsilon) const
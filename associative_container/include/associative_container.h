@@ -1,6 +1,7 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ASSOCIATIVE_CONTAINER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ASSOCIATIVE_CONTAINER_H
 
+#include <concepts>
 #include <iostream>
 #include <vector>
 #include <operation_not_supported.h>
@@ -11,6 +12,17 @@ concept compator = requires(const compare c, const tkey& lhs, const tkey& rhs)
                        {c(lhs, rhs)} -> std::same_as<bool>;
                    } && std::copyable<compare> && std::default_initializable<compare>;
 
+/** compare also orders tkey against key_like, like std::less<> does. Lookups by such a key then compare it
+ *  with the stored keys directly instead of building a temporary tkey
+ */
+template<typename compare, typename tkey, typename key_like>
+concept transparent_compator = requires { typename compare::is_transparent; } &&
+                               requires(const compare c, const tkey& lhs, const key_like& rhs)
+                               {
+                                   {c(lhs, rhs)} -> std::convertible_to<bool>;
+                                   {c(rhs, lhs)} -> std::convertible_to<bool>;
+                               };
+
 template<typename f_iter, typename tkey, typename tval>
 concept input_iterator_for_pair = std::input_iterator<f_iter> && std::same_as<typename std::iterator_traits<f_iter>::value_type, std::pair<tkey, tval>>;
 
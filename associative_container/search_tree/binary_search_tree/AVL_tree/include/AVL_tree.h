@@ -22,12 +22,53 @@ namespace __detail {
 
 		static void delete_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
 
+		// Copies height and size along with the data
+		static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* clone_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+																					 const binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* source,
+																					 binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* parent);
+
 		//Does not invalidate node*, needed for splay tree
 		static void post_search(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**) {}
 
 		//Does not invalidate node*
 		static void post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
 
+		// A perfectly balanced tree is a valid AVL tree, only heights are filled in
+		static void post_build(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont);
+
+		// Post-order height recalculation of a whole subtree
+		static void build_heights(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept;
+
+		// 0 for nullptr and for every node while order statistics are off
+		static size_t subtree_size(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept;
+
+		static void recalculate_size(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept;
+
+		// Links left, middle and right into one AVL subtree in O(|height(left) - height(right)|)
+		static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* join(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+																			   binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+																			   binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+																			   binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right);
+
+		// left is taller than right by more than one, descends along its right spine
+		static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* join_right(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+																					 binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+																					 binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+																					 binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right);
+
+		static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* join_left(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+																					binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+																					binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+																					binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right);
+
+		static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* link(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+																			   binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+																			   binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right) noexcept;
+
+		static size_t height(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept;
+
+		static void post_join(binary_search_tree<tkey, tvalue, compare, AVL_TAG>&) noexcept {}
+
 		static void erase(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
 
 		static void swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, AVL_TAG>& rhs) noexcept;
@@ -44,10 +85,19 @@ private:
     
     struct node final: public parent::node
     {
-        size_t height;
+        // Height of an AVL tree is below 1.45 * log2(n + 2), so a byte is enough
+        unsigned char height;
 
+        /** Nodes in this subtree while order statistics are on, otherwise 0.
+         *  Fits into the padding after height
+         */
+        unsigned int size;
+
+        // Also refreshes size if it is kept
         void recalculate_height() noexcept;
 
+        void recalculate_size() noexcept;
+
         /*
          * Returns positive if right subtree is bigger
          */
@@ -56,7 +106,7 @@ private:
         template<class ...Args>
         node(parent::node* par, Args&&... args);
 
-        ~node() noexcept override =default;
+        ~node() noexcept =default;
     };
 
 public:
@@ -191,6 +241,16 @@ public:
 		size_t get_height() const noexcept;
 		size_t get_balance() const noexcept;
 
+		/** O(log n) with order statistics on, otherwise steps one by one
+		 */
+		infix_iterator& operator+=(difference_type offset) & noexcept;
+		infix_iterator& operator-=(difference_type offset) & noexcept;
+
+		infix_iterator operator+(difference_type offset) const noexcept;
+		infix_iterator operator-(difference_type offset) const noexcept;
+
+		difference_type operator-(const infix_iterator& other) const noexcept;
+
         using parent::infix_iterator::depth;
         using parent::infix_iterator::operator*;
         using parent::infix_iterator::operator==;
@@ -200,7 +260,7 @@ public:
         using parent::infix_iterator::operator->;
     };
 
-	class infix_const_iterator : parent::infix_const_iterator {
+	class infix_const_iterator : public parent::infix_const_iterator {
 	public:
 		using value_type = parent::infix_const_iterator::value_type;
 		using difference_type = parent::infix_const_iterator::difference_type;
@@ -216,6 +276,16 @@ public:
 
 		infix_const_iterator(infix_iterator) noexcept;
 
+		/** O(log n) with order statistics on, otherwise steps one by one
+		 */
+		infix_const_iterator& operator+=(difference_type offset) & noexcept;
+		infix_const_iterator& operator-=(difference_type offset) & noexcept;
+
+		infix_const_iterator operator+(difference_type offset) const noexcept;
+		infix_const_iterator operator-(difference_type offset) const noexcept;
+
+		difference_type operator-(const infix_const_iterator& other) const noexcept;
+
 		using parent::infix_const_iterator::depth;
 		using parent::infix_const_iterator::operator*;
 		using parent::infix_const_iterator::operator==;
@@ -511,6 +581,13 @@ public:
 			 pp_allocator<value_type> alloc = pp_allocator<value_type>(),
 			 logger* logger = nullptr);
 
+	/** Builds the tree from input sorted by key without duplicates in O(n)
+	 */
+	template<std::input_iterator iterator>
+	AVL_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+			 pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+			 logger* logger = nullptr);
+
 public:
 	~AVL_tree() noexcept final = default;
 
@@ -539,24 +616,126 @@ public:
 	template<class... Args>
 	infix_iterator emplace_or_assign(Args&&... args);
 
+	infix_iterator insert(parent::infix_const_iterator hint, const value_type&);
+	infix_iterator insert(parent::infix_const_iterator hint, value_type&&);
+
+	template<class... Args>
+	infix_iterator emplace_hint(parent::infix_const_iterator hint, Args&&... args);
+
 	infix_iterator find(const tkey&);
 	infix_const_iterator find(const tkey&) const;
 
+	infix_iterator find_from(parent::infix_const_iterator pos, const tkey&);
+	infix_const_iterator find_from(parent::infix_const_iterator pos, const tkey&) const;
+
 	infix_iterator lower_bound(const tkey&);
 	infix_const_iterator lower_bound(const tkey&) const;
 
 	infix_iterator upper_bound(const tkey&);
 	infix_const_iterator upper_bound(const tkey&) const;
 
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_iterator find(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_const_iterator find(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_iterator lower_bound(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_const_iterator lower_bound(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_iterator upper_bound(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_const_iterator upper_bound(const key_like& key) const;
+
 	infix_iterator erase(infix_iterator pos);
 	infix_iterator erase(infix_const_iterator pos);
 
 	infix_iterator erase(infix_iterator first, infix_iterator last);
 	infix_iterator erase(infix_const_iterator first, infix_const_iterator last);
 
+	// region order statistics
+
+	/** Keeps subtree sizes in nodes from now on, existing nodes are counted in O(n).
+	 *  Without it the queries below throw std::logic_error
+	 */
+	void use_order_statistics() noexcept;
+
+	/** index-th smallest key, O(log n). Throws std::out_of_range if index >= size()
+	 */
+	infix_iterator nth(size_t index);
+	infix_const_iterator nth(size_t index) const;
+
+	/** Number of keys less than key, O(log n)
+	 */
+	size_t rank(const tkey& key) const;
+
+	/** Number of keys in [lo, hi], O(log n)
+	 */
+	size_t count_range(const tkey& lo, const tkey& hi) const;
+
+	// endregion order statistics
+
+	// region join-based set operations
+
+	/** Appends other, whose keys all must be greater than the keys of this tree, otherwise std::invalid_argument.
+	 *  Nodes are relinked when both trees use the same allocator and no node pool, otherwise copied.
+	 *  other is left empty
+	 */
+	void join(AVL_tree& other);
+
+	/** Moves the keys not less than key into the returned tree. O(log n) with order statistics on,
+	 *  otherwise the moved nodes are counted
+	 */
+	AVL_tree split(const tkey& key);
+
+	/** Join-based set operations in O(m log(n / m + 1)) for tree sizes m <= n.
+	 *  Keys present in this tree keep their values. set_union takes the nodes of other the same way as join
+	 */
+	void set_union(AVL_tree& other);
+	void set_intersection(const AVL_tree& other);
+	void set_difference(const AVL_tree& other);
+
+	// endregion join-based set operations
+
+	// region parallel bulk operations
+
+	/* Work is divided by subtrees and run on pool, the calling thread takes part in it.
+	 * The allocator must be thread-safe; with the node pool on, nodes are created and deleted by the calling thread only
+	 */
+
+	/** Bulk insert of unsorted input: halves are sorted into subtrees independently and united.
+	 *  Existing keys keep their values, of equal keys in the input the first one is taken
+	 */
+	template<std::ranges::input_range R>
+	void insert_range(fork_join_pool& pool, R&& rg);
+
+	/** Erases keys in [lo, hi] in O(log n + k), returns how many were erased
+	 */
+	size_t erase_range(const tkey& lo, const tkey& hi);
+	size_t erase_range(fork_join_pool& pool, const tkey& lo, const tkey& hi);
+
+	/** Calls function for every element, elements of different subtrees may be visited at once and in any order
+	 */
+	template<typename F>
+	void for_each(fork_join_pool& pool, F&& function);
+
+	template<typename F>
+	void for_each(fork_join_pool& pool, F&& function) const;
+
+	/** reduce(... reduce(reduce(identity, map(first)), map(second)) ..., map(last)) for an associative reduce
+	 *  with identity as its neutral element
+	 */
+	template<typename T, typename Map, typename Reduce>
+	T map_reduce(fork_join_pool& pool, Map&& map, Reduce&& reduce, T identity) const;
+
+	// endregion parallel bulk operations
+
 	using parent::erase;
 	using parent::insert;
 	using parent::insert_or_assign;
+	using parent::insert_range;
 };
 
 template<typename compare, typename U, typename iterator>
@@ -581,7 +760,8 @@ namespace __detail {
 			binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, Args&&... args)
 	{
 		using node_type = typename AVL_tree<tkey, tvalue, compare>::node;
-		auto* new_node = cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
+		auto* new_node = cont._pool.template new_object<node_type>(cont._allocator, std::forward<Args>(args)...);
+		new_node->size = cont._order_statistics ? 1 : 0;
 		return new_node;
 	}
 
@@ -589,13 +769,179 @@ namespace __detail {
 	void bst_impl<tkey, tvalue, compare, AVL_TAG>::delete_node(
 			binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node** node)
 	{
-		using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
+		using node_type = typename AVL_tree<tkey, tvalue, compare>::node;
 		if (node && *node) {
-			cont._allocator.template delete_object<node_type>(*node);
+			cont._pool.delete_object(cont._allocator, static_cast<node_type*>(*node));
 			*node = nullptr;
 		}
 	}
 
+	template<typename tkey, typename tvalue, typename compare>
+	typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* bst_impl<tkey, tvalue, compare, AVL_TAG>::clone_node(
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+			const binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* source,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* parent)
+	{
+		using node_type = typename AVL_tree<tkey, tvalue, compare>::node;
+		auto* typed_source = static_cast<const node_type*>(source);
+		auto* new_node = static_cast<node_type*>(create_node(cont, parent, source->data));
+		new_node->height = typed_source->height;
+		new_node->size = typed_source->size;
+		return new_node;
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	void bst_impl<tkey, tvalue, compare, AVL_TAG>::post_build(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont)
+	{
+		build_heights(cont._root);
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	void bst_impl<tkey, tvalue, compare, AVL_TAG>::build_heights(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept
+	{
+		if (!n) {
+			return;
+		}
+
+		// Recursion depth is the height of a perfectly balanced tree
+		build_heights(n->left_subtree);
+		build_heights(n->right_subtree);
+		static_cast<typename AVL_tree<tkey, tvalue, compare>::node*>(n)->recalculate_height();
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	size_t bst_impl<tkey, tvalue, compare, AVL_TAG>::subtree_size(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept
+	{
+		return n ? static_cast<typename AVL_tree<tkey, tvalue, compare>::node*>(n)->size : 0;
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	void bst_impl<tkey, tvalue, compare, AVL_TAG>::recalculate_size(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept
+	{
+		static_cast<typename AVL_tree<tkey, tvalue, compare>::node*>(n)->recalculate_size();
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	size_t bst_impl<tkey, tvalue, compare, AVL_TAG>::height(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* n) noexcept
+	{
+		return n ? static_cast<typename AVL_tree<tkey, tvalue, compare>::node*>(n)->height : 0;
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* bst_impl<tkey, tvalue, compare, AVL_TAG>::link(
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right) noexcept
+	{
+		middle->parent = nullptr;
+		middle->left_subtree = left;
+		middle->right_subtree = right;
+
+		if (left) {
+			left->parent = middle;
+		}
+
+		if (right) {
+			right->parent = middle;
+		}
+
+		static_cast<typename AVL_tree<tkey, tvalue, compare>::node*>(middle)->recalculate_height();
+
+		return middle;
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* bst_impl<tkey, tvalue, compare, AVL_TAG>::join(
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right)
+	{
+		if (height(left) > height(right) + 1) {
+			return join_right(cont, left, middle, right);
+		}
+
+		if (height(right) > height(left) + 1) {
+			return join_left(cont, left, middle, right);
+		}
+
+		return link(left, middle, right);
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* bst_impl<tkey, tvalue, compare, AVL_TAG>::join_right(
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right)
+	{
+		using avl_node = typename AVL_tree<tkey, tvalue, compare>::node;
+		using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
+
+		node_type* spine = left->right_subtree;
+		node_type* joined = height(spine) <= height(right) + 1 ? link(spine, middle, right)
+															   : join_right(cont, spine, middle, right);
+
+		left->right_subtree = joined;
+		joined->parent = left;
+
+		if (height(joined) <= height(left->left_subtree) + 1) {
+			static_cast<avl_node*>(left)->recalculate_height();
+			return left;
+		}
+
+		if (height(joined->left_subtree) > height(joined->right_subtree)) {// Right-Left
+			node_type* lowered = joined;
+			cont.small_right_rotation(joined);
+			static_cast<avl_node*>(lowered)->recalculate_height();
+			static_cast<avl_node*>(joined)->recalculate_height();
+		}
+
+		node_type* top = left;
+		cont.small_left_rotation(top);
+		static_cast<avl_node*>(left)->recalculate_height();
+		static_cast<avl_node*>(top)->recalculate_height();
+
+		return top;
+	}
+
+	template<typename tkey, typename tvalue, typename compare>
+	binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* bst_impl<tkey, tvalue, compare, AVL_TAG>::join_left(
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* left,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* middle,
+			binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* right)
+	{
+		using avl_node = typename AVL_tree<tkey, tvalue, compare>::node;
+		using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
+
+		node_type* spine = right->left_subtree;
+		node_type* joined = height(spine) <= height(left) + 1 ? link(left, middle, spine)
+															  : join_left(cont, left, middle, spine);
+
+		right->left_subtree = joined;
+		joined->parent = right;
+
+		if (height(joined) <= height(right->right_subtree) + 1) {
+			static_cast<avl_node*>(right)->recalculate_height();
+			return right;
+		}
+
+		if (height(joined->right_subtree) > height(joined->left_subtree)) {// Left-Right
+			node_type* lowered = joined;
+			cont.small_left_rotation(joined);
+			static_cast<avl_node*>(lowered)->recalculate_height();
+			static_cast<avl_node*>(joined)->recalculate_height();
+		}
+
+		node_type* top = right;
+		cont.small_right_rotation(top);
+		static_cast<avl_node*>(right)->recalculate_height();
+		static_cast<avl_node*>(top)->recalculate_height();
+
+		return top;
+	}
+
 	template<typename tkey, typename tvalue, typename compare>
 	void bst_impl<tkey, tvalue, compare, AVL_TAG>::post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
 															   typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node** node)
@@ -809,10 +1155,12 @@ template<typename tkey, typename tvalue, typename compare>
 void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>::swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& lhs,
 																		binary_search_tree<tkey, tvalue, compare, AVL_TAG>& rhs) noexcept
 {
-	std::swap(lhs.root, rhs.root);
+	std::swap(lhs._root, rhs._root);
 	std::swap(lhs._logger, rhs._logger);
 	std::swap(lhs._size, rhs._size);
 	std::swap(lhs._allocator, rhs._allocator);
+	lhs._pool.swap(rhs._pool);
+	std::swap(lhs._order_statistics, rhs._order_statistics);
 }
 
 // region node implementation
@@ -834,7 +1182,25 @@ void AVL_tree<tkey, tvalue, compare>::node::recalculate_height() noexcept
 		right_height = 0;
 	}
 
-	this->height = 1 + std::max(left_height, right_height);
+	this->height = static_cast<unsigned char>(1 + std::max(left_height, right_height));
+
+	if (size) {
+		recalculate_size();
+	}
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void AVL_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept
+{
+	size = 1;
+
+	if (this->left_subtree) {
+		size += static_cast<node*>(this->left_subtree)->size;
+	}
+
+	if (this->right_subtree) {
+		size += static_cast<node*>(this->right_subtree)->size;
+	}
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -859,7 +1225,7 @@ short AVL_tree<tkey, tvalue, compare>::node::get_balance() const noexcept
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<class... Args>
-AVL_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args) : parent::node(par, std::forward<Args>(args)...), height(1) {}
+AVL_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args) : parent::node(par, std::forward<Args>(args)...), height(1), size(0) {}
 
 // endregion node implementation
 
@@ -1006,6 +1372,45 @@ size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_balance() const noex
 	return static_cast<node*>(this->_data)->get_balance();
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator&
+AVL_tree<tkey, tvalue, compare>::infix_iterator::operator+=(difference_type offset) & noexcept
+{
+	parent::advance_infix(*this, offset);
+	return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator&
+AVL_tree<tkey, tvalue, compare>::infix_iterator::operator-=(difference_type offset) & noexcept
+{
+	parent::advance_infix(*this, -offset);
+	return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::infix_iterator::operator+(difference_type offset) const noexcept
+{
+	infix_iterator result = *this;
+	return result += offset;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::infix_iterator::operator-(difference_type offset) const noexcept
+{
+	infix_iterator result = *this;
+	return result -= offset;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator::difference_type
+AVL_tree<tkey, tvalue, compare>::infix_iterator::operator-(const infix_iterator& other) const noexcept
+{
+	return parent::infix_distance(other, *this);
+}
+
 // endregion infix_iterator implementation
 
 // region infix_const_iterator implementation
@@ -1031,6 +1436,45 @@ size_t AVL_tree<tkey, tvalue, compare>::infix_const_iterator::get_balance() cons
 template<typename tkey, typename tvalue, compator<tkey> compare>
 AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it) {}
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator&
+AVL_tree<tkey, tvalue, compare>::infix_const_iterator::operator+=(difference_type offset) & noexcept
+{
+	parent::advance_infix(this->_base, offset);
+	return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator&
+AVL_tree<tkey, tvalue, compare>::infix_const_iterator::operator-=(difference_type offset) & noexcept
+{
+	parent::advance_infix(this->_base, -offset);
+	return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare>::infix_const_iterator::operator+(difference_type offset) const noexcept
+{
+	infix_const_iterator result = *this;
+	return result += offset;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare>::infix_const_iterator::operator-(difference_type offset) const noexcept
+{
+	infix_const_iterator result = *this;
+	return result -= offset;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator::difference_type
+AVL_tree<tkey, tvalue, compare>::infix_const_iterator::operator-(const infix_const_iterator& other) const noexcept
+{
+	return parent::infix_distance(other._base, this->_base);
+}
+
 // endregion infix_const_iterator implementation
 
 // region infix_reverse_iterator implementation
@@ -1541,34 +1985,25 @@ template<typename tkey, typename tvalue, compator<tkey> compare>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
 AVL_tree<tkey, tvalue, compare>::AVL_tree(iterator begin, iterator end, const compare& cmp,
 										  pp_allocator<value_type> alloc,
-										  logger* logger) : parent(cmp, alloc, logger)
-{
-	for (auto it = begin; it != end; ++it) {
-		this->emplace(*it);
-	}
-}
+										  logger* logger) : parent(begin, end, cmp, alloc, logger) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<std::ranges::input_range Range>
 AVL_tree<tkey, tvalue, compare>::AVL_tree(Range&& range,
 										  const compare& cmp,
 										  pp_allocator<value_type> alloc,
-										  logger* logger) : parent(range, cmp, alloc, logger)
-{
-	for (auto&& element: range) {
-		emplace(std::forward<decltype(element)>(element));
-	}
-}
+										  logger* logger) : parent(std::forward<Range>(range), cmp, alloc, logger) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 AVL_tree<tkey, tvalue, compare>::AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
 										  const compare& cmp, pp_allocator<value_type> alloc,
-										  logger* logger) : parent(cmp, alloc, logger)
-{
-	for (const auto& element: data) {
-		emplace(element.first, element.second);
-	}
-}
+										  logger* logger) : parent(data, cmp, alloc, logger) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<std::input_iterator iterator>
+AVL_tree<tkey, tvalue, compare>::AVL_tree(sorted_unique_t, iterator begin, iterator end,
+										  const compare& cmp, pp_allocator<value_type> alloc,
+										  logger* logger) : parent(sorted_unique, begin, end, cmp, alloc, logger) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 AVL_tree<tkey, tvalue, compare>::AVL_tree(const AVL_tree& other) : parent(other) {}
@@ -1644,6 +2079,28 @@ AVL_tree<tkey, tvalue, compare>::emplace_or_assign(Args&&... args)
 	return it;
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::insert(parent::infix_const_iterator hint, const value_type& value)
+{
+	return parent::insert(hint, value);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::insert(parent::infix_const_iterator hint, value_type&& value)
+{
+	return parent::insert(hint, std::move(value));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class... Args>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::emplace_hint(parent::infix_const_iterator hint, Args&&... args)
+{
+	return parent::emplace_hint(hint, std::forward<Args>(args)...);
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename AVL_tree<tkey, tvalue, compare>::infix_iterator
 AVL_tree<tkey, tvalue, compare>::find(const tkey& key)
@@ -1658,6 +2115,20 @@ AVL_tree<tkey, tvalue, compare>::find(const tkey& key) const
 	return parent::find(key);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::find_from(parent::infix_const_iterator pos, const tkey& key)
+{
+	return parent::find_from(pos, key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare>::find_from(parent::infix_const_iterator pos, const tkey& key) const
+{
+	return parent::find_from(pos, key);
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename AVL_tree<tkey, tvalue, compare>::infix_iterator
 AVL_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)
@@ -1686,6 +2157,54 @@ AVL_tree<tkey, tvalue, compare>::upper_bound(const tkey& key) const
 	return parent::upper_bound(key);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::find(const key_like& key)
+{
+	return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare>::find(const key_like& key) const
+{
+	return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::lower_bound(const key_like& key)
+{
+	return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare>::lower_bound(const key_like& key) const
+{
+	return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::upper_bound(const key_like& key)
+{
+	return parent::upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare>::upper_bound(const key_like& key) const
+{
+	return parent::upper_bound(key);
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename AVL_tree<tkey, tvalue, compare>::infix_iterator
 AVL_tree<tkey, tvalue, compare>::erase(infix_iterator pos)
@@ -1714,6 +2233,138 @@ AVL_tree<tkey, tvalue, compare>::erase(infix_const_iterator first, infix_const_i
 	return parent::erase(first, last);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void AVL_tree<tkey, tvalue, compare>::use_order_statistics() noexcept
+{
+	parent::enable_order_statistics();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_iterator
+AVL_tree<tkey, tvalue, compare>::nth(size_t index)
+{
+	this->check_order_statistics();
+
+	if (index >= this->_size) {
+		throw std::out_of_range("Index is out of tree size");
+	}
+
+	return infix_iterator(parent::select_node(this->_root, index));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare>::nth(size_t index) const
+{
+	this->check_order_statistics();
+
+	if (index >= this->_size) {
+		throw std::out_of_range("Index is out of tree size");
+	}
+
+	return infix_const_iterator(parent::select_node(this->_root, index));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t AVL_tree<tkey, tvalue, compare>::rank(const tkey& key) const
+{
+	this->check_order_statistics();
+	return this->count_less(key, false);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t AVL_tree<tkey, tvalue, compare>::count_range(const tkey& lo, const tkey& hi) const
+{
+	this->check_order_statistics();
+
+	size_t before = this->count_less(lo, false);
+	size_t through = this->count_less(hi, true);
+
+	return through > before ? through - before : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void AVL_tree<tkey, tvalue, compare>::join(AVL_tree& other)
+{
+	this->join_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+AVL_tree<tkey, tvalue, compare> AVL_tree<tkey, tvalue, compare>::split(const tkey& key)
+{
+	AVL_tree result(this->key_comp(), this->_allocator, this->_logger);
+
+	if (this->_pool.chunk_nodes()) {
+		result.use_node_pool(this->_pool.chunk_nodes());
+	}
+
+	if (this->_order_statistics) {
+		result.use_order_statistics();
+	}
+
+	this->split_tree(key, result);
+
+	return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void AVL_tree<tkey, tvalue, compare>::set_union(AVL_tree& other)
+{
+	this->union_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void AVL_tree<tkey, tvalue, compare>::set_intersection(const AVL_tree& other)
+{
+	this->intersect_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void AVL_tree<tkey, tvalue, compare>::set_difference(const AVL_tree& other)
+{
+	this->subtract_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<std::ranges::input_range R>
+void AVL_tree<tkey, tvalue, compare>::insert_range(fork_join_pool& pool, R&& rg)
+{
+	this->parallel_insert_range(pool, std::forward<R>(rg));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t AVL_tree<tkey, tvalue, compare>::erase_range(const tkey& lo, const tkey& hi)
+{
+	return this->erase_key_range(lo, hi, nullptr);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t AVL_tree<tkey, tvalue, compare>::erase_range(fork_join_pool& pool, const tkey& lo, const tkey& hi)
+{
+	return this->erase_key_range(lo, hi, this->node_workers(pool));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename F>
+void AVL_tree<tkey, tvalue, compare>::for_each(fork_join_pool& pool, F&& function)
+{
+	parent::visit_subtree(this->_root, function, &pool, parent::fork_depth(&pool));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename F>
+void AVL_tree<tkey, tvalue, compare>::for_each(fork_join_pool& pool, F&& function) const
+{
+	parent::visit_subtree(static_cast<const typename parent::node*>(this->_root), function, &pool, parent::fork_depth(&pool));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename T, typename Map, typename Reduce>
+T AVL_tree<tkey, tvalue, compare>::map_reduce(fork_join_pool& pool, Map&& map, Reduce&& reduce, T identity) const
+{
+	return parent::reduce_subtree(this->_root, map, reduce, identity, &pool, parent::fork_depth(&pool));
+}
+
 // endregion AVL_tree methods
 
 #endif//MATH_PRACTICE_AND_OPERATING_SYSTEMS_AVL_TREE_H
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <list>
+#include <map>
+#include <optional>
+#include <string_view>
 
 logger *create_logger(
         std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -567,6 +571,678 @@ TEST(AVLTreePositiveTests, test11)
     logger->trace("AVLTreePositiveTests.test11 finished");
 }
 
+TEST(AVLTreePositiveTests, test12)
+{
+
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("AVLTreePositiveTests.test12 started");
+
+    struct counting_resource : std::pmr::memory_resource
+    {
+        size_t allocations = 0;
+
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    } resource;
+
+    auto avl = std::make_unique<AVL_tree<int, int>>(std::less<int>(), &resource);
+    avl->use_node_pool(16);
+
+    for (int round = 0; round < 4; ++round)
+    {
+        for (int i = 0; i < 32; ++i)
+        {
+            avl->emplace(i, i * round);
+        }
+
+        EXPECT_THROW(avl->use_node_pool(0), std::logic_error);
+
+        for (int i = 0; i < 32; i += 2)
+        {
+            avl->erase(i);
+        }
+
+        avl->clear();
+    }
+
+    // Freed slots are reused, so 32 nodes never need more than two chunks
+    EXPECT_EQ(resource.allocations, 2);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        avl->emplace(i, -i);
+    }
+
+    std::vector<std::pair<const int, int>> actual_result(avl->begin(), avl->end());
+
+    ASSERT_EQ(actual_result.size(), 10);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(actual_result[i].first, i);
+        EXPECT_EQ(actual_result[i].second, -i);
+    }
+
+    logger->trace("AVLTreePositiveTests.test12 finished");
+}
+
+TEST(AVLTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("AVLTreePositiveTests.test13 started");
+
+    std::vector<std::pair<int, std::string>> sorted =
+        {
+            { 1, "a" },
+            { 2, "b" },
+            { 3, "c" },
+            { 4, "d" },
+            { 5, "e" },
+            { 6, "f" }
+        };
+
+    AVL_tree<int, std::string> avl(sorted_unique, sorted.begin(), sorted.end(), std::less<int>(), nullptr, logger.get());
+
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+            test_data<int, std::string>(2, 1, "a", 1),
+            test_data<int, std::string>(1, 2, "b", 2),
+            test_data<int, std::string>(2, 3, "c", 1),
+            test_data<int, std::string>(0, 4, "d", 3),
+            test_data<int, std::string>(2, 5, "e", 1),
+            test_data<int, std::string>(1, 6, "f", 2)
+        };
+
+    EXPECT_TRUE(infix_iterator_test(avl, expected_result));
+
+    // Sorted run is merged, an existing key keeps its value
+    std::vector<std::pair<int, std::string>> tail =
+        {
+            { 4, "x" },
+            { 7, "g" },
+            { 8, "h" },
+            { 9, "i" }
+        };
+
+    avl.insert_range(tail);
+
+    expected_result =
+        {
+            test_data<int, std::string>(3, 1, "a", 1),
+            test_data<int, std::string>(2, 2, "b", 2),
+            test_data<int, std::string>(1, 3, "c", 3),
+            test_data<int, std::string>(2, 4, "d", 1),
+            test_data<int, std::string>(0, 5, "e", 4),
+            test_data<int, std::string>(3, 6, "f", 1),
+            test_data<int, std::string>(2, 7, "g", 2),
+            test_data<int, std::string>(1, 8, "h", 3),
+            test_data<int, std::string>(2, 9, "i", 1)
+        };
+
+    EXPECT_TRUE(infix_iterator_test(avl, expected_result));
+
+    // Unsorted input is inserted one by one
+    std::vector<std::pair<int, std::string>> unsorted =
+        {
+            { 11, "k" },
+            { 10, "j" }
+        };
+
+    avl.insert_range(unsorted);
+
+    EXPECT_EQ(avl.size(), 11);
+    EXPECT_EQ(avl.at(10), "j");
+    EXPECT_EQ(avl.at(11), "k");
+
+    for (int i = 1; i <= 11; ++i)
+    {
+        avl.erase(i);
+    }
+
+    EXPECT_TRUE(avl.empty());
+
+    logger->trace("AVLTreePositiveTests.test13 finished");
+}
+
+TEST(AVLTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("AVLTreePositiveTests.test14 started");
+
+    AVL_tree<int, int> avl(std::less<int>(), nullptr, logger.get());
+    std::map<int, int> map;
+
+    srand(42);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        int key = rand() % 1000;
+        avl.emplace(key, i);
+        map.emplace(key, i);
+    }
+
+    EXPECT_THROW(avl.rank(0), std::logic_error);
+
+    // Switched on for a filled tree, later changes keep sizes up to date
+    avl.use_order_statistics();
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        int key = rand() % 1000;
+
+        if (rand() % 2)
+        {
+            avl.emplace(key, i);
+            map.emplace(key, i);
+        }
+        else if (map.erase(key))
+        {
+            avl.erase(key);
+        }
+    }
+
+    ASSERT_EQ(avl.size(), map.size());
+
+    size_t index = 0;
+
+    for (auto& [key, value] : map)
+    {
+        EXPECT_EQ(avl.nth(index)->first, key);
+        EXPECT_EQ(avl.rank(key), index);
+        ++index;
+    }
+
+    EXPECT_THROW(avl.nth(map.size()), std::out_of_range);
+
+    for (int lo = -10; lo < 1010; lo += 37)
+    {
+        int hi = lo + rand() % 200;
+        auto expected = std::distance(map.lower_bound(lo), map.upper_bound(hi));
+
+        EXPECT_EQ(avl.count_range(lo, hi), expected);
+    }
+
+    EXPECT_EQ(avl.count_range(10, 5), 0);
+
+    auto begin = avl.begin_infix();
+    auto end = avl.end_infix();
+    auto it = begin + static_cast<ptrdiff_t>(map.size() / 2);
+
+    EXPECT_EQ(it->first, std::next(map.begin(), map.size() / 2)->first);
+    EXPECT_EQ(it - begin, static_cast<ptrdiff_t>(map.size() / 2));
+    EXPECT_EQ(end - it, static_cast<ptrdiff_t>(map.size() - map.size() / 2));
+    EXPECT_EQ((end - 1)->first, map.rbegin()->first);
+    EXPECT_TRUE(begin + static_cast<ptrdiff_t>(map.size()) == end);
+
+    it -= 3;
+    EXPECT_EQ(it->first, std::next(map.begin(), map.size() / 2 - 3)->first);
+
+    // Without order statistics iterators step one by one
+    AVL_tree<int, int> plain(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        plain.emplace(i, i);
+    }
+
+    auto plain_it = plain.begin_infix() + 7;
+
+    EXPECT_EQ(plain_it->first, 7);
+    EXPECT_EQ(plain.end_infix() - plain_it, 3);
+    EXPECT_EQ(plain_it - plain.end_infix(), -3);
+
+    logger->trace("AVLTreePositiveTests.test14 finished");
+}
+
+TEST(AVLTreePositiveTests, test15)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("AVLTreePositiveTests.test15 started");
+
+    using tree = AVL_tree<int, int>;
+
+    auto fill = [&](tree& target, std::map<int, int>& expected, int count, int spread)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            int key = rand() % spread;
+            target.emplace(key, i);
+            expected.emplace(key, i);
+        }
+    };
+
+    auto same = [](tree const& actual, std::map<int, int> const& expected)
+    {
+        if (actual.size() != expected.size())
+        {
+            return false;
+        }
+
+        auto it = actual.cbegin_infix();
+
+        for (auto& [key, value] : expected)
+        {
+            if (it->first != key || it->second != value)
+            {
+                return false;
+            }
+
+            ++it;
+        }
+
+        return true;
+    };
+
+    srand(7);
+
+    for (bool statistics : {false, true})
+    {
+        tree lhs(std::less<int>(), nullptr, logger.get()), rhs(std::less<int>(), nullptr, logger.get());
+
+        if (statistics)
+        {
+            lhs.use_order_statistics();
+        }
+
+        std::map<int, int> lhs_map, rhs_map;
+        fill(lhs, lhs_map, 300, 1000);
+        fill(rhs, rhs_map, 300, 1000);
+
+        // Split, then join the halves back
+        tree upper = lhs.split(500);
+        std::map<int, int> upper_map(lhs_map.lower_bound(500), lhs_map.end());
+        lhs_map.erase(lhs_map.lower_bound(500), lhs_map.end());
+
+        EXPECT_TRUE(same(lhs, lhs_map));
+        EXPECT_TRUE(same(upper, upper_map));
+
+        upper.emplace(2000, -1);
+        upper_map.emplace(2000, -1);
+        lhs.erase(lhs_map.begin()->first);
+        lhs_map.erase(lhs_map.begin());
+
+        EXPECT_THROW(upper.join(lhs), std::invalid_argument);
+
+        lhs.join(upper);
+        lhs_map.merge(upper_map);
+
+        EXPECT_TRUE(upper.empty());
+        EXPECT_TRUE(same(lhs, lhs_map));
+
+        // Set operations keep values of this tree for equal keys
+        tree united(lhs), intersected(lhs), subtracted(lhs);
+        intersected.set_intersection(rhs);
+        subtracted.set_difference(rhs);
+        united.set_union(rhs);
+
+        std::map<int, int> united_map(lhs_map), intersected_map, subtracted_map;
+        united_map.insert(rhs_map.begin(), rhs_map.end());
+
+        for (auto& [key, value] : lhs_map)
+        {
+            (rhs_map.contains(key) ? intersected_map : subtracted_map).emplace(key, value);
+        }
+
+        EXPECT_TRUE(same(united, united_map));
+        EXPECT_TRUE(same(intersected, intersected_map));
+        EXPECT_TRUE(same(subtracted, subtracted_map));
+        EXPECT_TRUE(rhs.empty());
+
+        if (statistics)
+        {
+            size_t index = 0;
+
+            for (auto& [key, value] : united_map)
+            {
+                EXPECT_EQ(united.nth(index)->first, key);
+                EXPECT_EQ(united.rank(key), index++);
+            }
+        }
+
+        // Trees stay usable after relinking
+        for (int i = 0; i < 500; ++i)
+        {
+            int key = rand() % 1000;
+
+            if (rand() % 2)
+            {
+                united.emplace(key, i);
+                united_map.emplace(key, i);
+            }
+            else if (united_map.erase(key))
+            {
+                united.erase(key);
+            }
+        }
+
+        EXPECT_TRUE(same(united, united_map));
+
+        subtracted.set_difference(subtracted);
+        EXPECT_TRUE(subtracted.empty());
+    }
+
+    // Pooled trees cannot hand nodes over and copy them instead
+    tree pooled(std::less<int>(), nullptr, logger.get()), other(std::less<int>(), nullptr, logger.get());
+    pooled.use_node_pool(16);
+    std::map<int, int> pooled_map, other_map;
+    fill(pooled, pooled_map, 100, 300);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        other.emplace(1000 + i, i);
+        other_map.emplace(1000 + i, i);
+    }
+
+    pooled.join(other);
+    pooled_map.merge(other_map);
+
+    EXPECT_TRUE(other.empty());
+    EXPECT_TRUE(same(pooled, pooled_map));
+
+    tree pooled_upper = pooled.split(150);
+    std::map<int, int> pooled_upper_map(pooled_map.lower_bound(150), pooled_map.end());
+    pooled_map.erase(pooled_map.lower_bound(150), pooled_map.end());
+
+    EXPECT_TRUE(same(pooled, pooled_map));
+    EXPECT_TRUE(same(pooled_upper, pooled_upper_map));
+
+    logger->trace("AVLTreePositiveTests.test15 finished");
+}
+
+TEST(AVLTreePositiveTests, test16)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("AVLTreePositiveTests.test16 started");
+
+    using tree = AVL_tree<int, int>;
+
+    fork_join_pool pool(4);
+
+    srand(11);
+
+    for (size_t chunk_nodes : {size_t(0), size_t(32)})
+    {
+        tree parallel(std::less<int>(), nullptr, logger.get());
+        std::map<int, int> map;
+
+        if (chunk_nodes)
+        {
+            parallel.use_node_pool(chunk_nodes);
+        }
+        else
+        {
+            parallel.use_order_statistics();
+        }
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            int key = rand() % 100000;
+            parallel.emplace(key, -i);
+            map.emplace(key, -i);
+        }
+
+        // Duplicates inside the batch and against the tree, the first value of a key wins
+        std::vector<std::pair<const int, int>> batch;
+
+        for (int i = 0; i < 50000; ++i)
+        {
+            int key = rand() % 100000;
+            batch.emplace_back(key, i);
+            map.emplace(key, i);
+        }
+
+        parallel.insert_range(pool, batch);
+
+        ASSERT_EQ(parallel.size(), map.size());
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+
+        std::list<std::pair<const int, int>> tail{{200000, 1}, {200001, 2}, {200000, 3}};
+        parallel.insert_range(pool, tail);
+        map.insert(tail.begin(), tail.end());
+
+        ASSERT_EQ(parallel.size(), map.size());
+        EXPECT_EQ(parallel.find(200000)->second, 1);
+
+        if (!chunk_nodes)
+        {
+            EXPECT_EQ(parallel.nth(map.size() / 3)->first, std::next(map.begin(), map.size() / 3)->first);
+            EXPECT_EQ(parallel.rank(50000), std::distance(map.begin(), map.lower_bound(50000)));
+        }
+
+        EXPECT_EQ(parallel.erase_range(pool, 20000, 60000), std::distance(map.lower_bound(20000), map.upper_bound(60000)));
+        map.erase(map.lower_bound(20000), map.upper_bound(60000));
+
+        int lo = map.begin()->first;
+        EXPECT_EQ(parallel.erase_range(lo, lo), 1);
+        map.erase(lo);
+
+        EXPECT_EQ(parallel.erase_range(10, 5), 0);
+        ASSERT_EQ(parallel.size(), map.size());
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+
+        parallel.for_each(pool, [](auto& value) { value.second *= 2; });
+
+        for (auto& [key, value] : map)
+        {
+            value *= 2;
+        }
+
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+
+        auto sum = parallel.map_reduce(pool, [](auto const& value) { return static_cast<long long>(value.second); }, std::plus<>(), 0LL);
+        long long expected_sum = 0;
+
+        for (auto& [key, value] : map)
+        {
+            expected_sum += value;
+        }
+
+        EXPECT_EQ(sum, expected_sum);
+
+        // Non-commutative reduce sees the keys in order
+        auto sorted = parallel.map_reduce(pool,
+                                          [](auto const& value) { return std::make_pair(value.first, value.first); },
+                                          [](std::optional<std::pair<int, int>> lhs, std::optional<std::pair<int, int>> rhs) -> std::optional<std::pair<int, int>>
+                                          {
+                                              if (!lhs || !rhs)
+                                              {
+                                                  return lhs ? lhs : rhs;
+                                              }
+
+                                              return lhs->second < rhs->first ? std::make_optional(std::make_pair(lhs->first, rhs->second)) : std::nullopt;
+                                          },
+                                          std::optional<std::pair<int, int>>());
+
+        ASSERT_TRUE(sorted.has_value());
+        EXPECT_EQ(sorted->first, map.begin()->first);
+        EXPECT_EQ(sorted->second, map.rbegin()->first);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int key = rand() % 100000;
+
+            if (rand() % 2)
+            {
+                parallel.emplace(key, i);
+                map.emplace(key, i);
+            }
+            else if (map.erase(key))
+            {
+                parallel.erase(key);
+            }
+        }
+
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+    }
+
+    EXPECT_THROW(pool.invoke([] {}, [] { throw std::runtime_error("forked"); }), std::runtime_error);
+
+    logger->trace("AVLTreePositiveTests.test16 finished");
+}
+
+TEST(AVLTreePositiveTests, test17)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("AVLTreePositiveTests.test17 started");
+
+    srand(17);
+
+    for (int pattern = 0; pattern < 3; ++pattern)
+    {
+        AVL_tree<int, int> plain(std::less<int>(), nullptr, logger.get());
+        AVL_tree<int, int> hinted(std::less<int>(), nullptr, logger.get());
+
+        if (pattern == 2)
+        {
+            hinted.use_order_statistics();
+        }
+
+        // Sorted, nearly sorted and random ingest; the place of a new key does not depend on the hint,
+        // so rebalancing has to leave both trees in the same shape
+        auto last = hinted.end();
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int key = pattern == 0 ? i : pattern == 1 ? i + rand() % 16 : rand() % 100000;
+
+            plain.emplace(key, i);
+
+            if (i % 2)
+            {
+                last = hinted.emplace_hint(last, key, i);
+            }
+            else
+            {
+                last = hinted.insert(hinted.end(), std::make_pair(key, i));
+            }
+
+            ASSERT_EQ(last->first, key);
+        }
+
+        ASSERT_EQ(hinted.size(), plain.size());
+
+        auto expected = plain.begin_prefix();
+
+        for (auto it = hinted.begin_prefix(); it != hinted.end_prefix(); ++it, ++expected)
+        {
+            ASSERT_EQ(it.depth(), expected.depth());
+            ASSERT_EQ(it->first, expected->first);
+            ASSERT_EQ(it->second, expected->second);
+            ASSERT_EQ(it.get_height(), expected.get_height());
+        }
+
+        auto from = hinted.begin();
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            int key = rand() % 100020;
+            auto found = hinted.find_from(from, key);
+
+            ASSERT_TRUE(found == hinted.find(key));
+
+            if (found != hinted.end())
+            {
+                from = found;
+            }
+        }
+    }
+
+    logger->trace("AVLTreePositiveTests.test17 finished");
+}
+
+TEST(AVLTreePositiveTests, test18)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "AVL_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("AVLTreePositiveTests.test18 started");
+
+    AVL_tree<std::string, int, std::less<>> tree(std::less<>(), nullptr, logger.get());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.emplace("a long key that does not fit in place " + std::to_string(i * 2), i);
+    }
+
+    // Lookups by std::string_view and by const char* find the same nodes as by std::string
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string key = "a long key that does not fit in place " + std::to_string(i);
+        std::string_view view = key;
+
+        ASSERT_TRUE(tree.find(view) == tree.find(key));
+        ASSERT_TRUE(tree.find(key.c_str()) == tree.find(key));
+        ASSERT_TRUE(tree.lower_bound(view) == tree.lower_bound(key));
+        ASSERT_TRUE(tree.upper_bound(view) == tree.upper_bound(key));
+        ASSERT_EQ(tree.contains(view), i % 2 == 0);
+    }
+
+    auto const &view_tree = tree;
+    EXPECT_EQ(view_tree.find(std::string_view("a long key that does not fit in place 10"))->second, 5);
+
+    logger->trace("AVLTreePositiveTests.test18 finished");
+}
+
 int main(
     int argc,
     char **argv)
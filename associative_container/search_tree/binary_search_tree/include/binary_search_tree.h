@@ -1,17 +1,24 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 
+#include <fork_join_pool.h>
+#include <frozen_search_tree.h>
 #include <logger.h>
 #include <logger_guardant.h>
 #include <not_implemented.h>
 #include <pp_allocator.h>
 #include <search_tree.h>
 
+#include <algorithm>
+#include <bit>
 #include <concepts>
 #include <list>
 #include <memory>
+#include <new>
+#include <optional>
 #include <ranges>
 #include <stack>
+#include <stdexcept>
 #include <vector>
 
 namespace __detail
@@ -20,8 +27,184 @@ namespace __detail
 	class bst_impl;
 
 	class BST_TAG;
+
+	/** Free-list of equally sized node slots, carved out of chunks taken from the tree allocator.
+	 *  The slot is sized to the first node type placed into it, so every tree keeps one pool for its concrete node.
+	 *  Freed slots are reused before a new chunk is requested, chunks go back to the resource only in release().
+	 *  With chunk_nodes == 0 the pool is disabled and every node is a separate allocator call.
+	 */
+	class node_pool
+	{
+		struct free_slot
+		{
+			free_slot* next;
+		};
+
+		struct chunk_header
+		{
+			chunk_header* next;
+			size_t bytes;
+		};
+
+		pp_allocator<unsigned char> _allocator;
+		size_t _chunk_nodes;
+		size_t _reserved;
+		size_t _slot_size;
+		size_t _slot_alignment;
+		free_slot* _free;
+		chunk_header* _chunks;
+
+	public:
+		explicit node_pool(pp_allocator<unsigned char> alloc = pp_allocator<unsigned char>(), size_t chunk_nodes = 0) noexcept
+			: _allocator(alloc), _chunk_nodes(chunk_nodes), _reserved(0), _slot_size(0), _slot_alignment(alignof(std::max_align_t)), _free(nullptr), _chunks(nullptr) {}
+
+		node_pool(const node_pool&) = delete;
+		node_pool& operator=(const node_pool&) = delete;
+
+		node_pool(node_pool&& other) noexcept : node_pool(other._allocator, 0)
+		{
+			swap(other);
+		}
+
+		node_pool& operator=(node_pool&& other) noexcept
+		{
+			swap(other);
+			return *this;
+		}
+
+		~node_pool() noexcept
+		{
+			release();
+		}
+
+		bool enabled() const noexcept
+		{
+			return _chunk_nodes != 0;
+		}
+
+		size_t chunk_nodes() const noexcept
+		{
+			return _chunk_nodes;
+		}
+
+		/** Constructs a node with alloc, memory comes from the pool when it is enabled
+		 */
+		template<typename node_type, typename U, class... Args>
+		node_type* new_object(pp_allocator<U>& alloc, Args&&... args)
+		{
+			if (!enabled()) {
+				return alloc.template new_object<node_type>(std::forward<Args>(args)...);
+			}
+
+			auto* slot = static_cast<node_type*>(allocate(sizeof(node_type), alignof(node_type)));
+
+			try {
+				alloc.construct(slot, std::forward<Args>(args)...);
+			} catch (...) {
+				deallocate(slot);
+				throw;
+			}
+
+			return slot;
+		}
+
+		template<typename node_type, typename U>
+		void delete_object(pp_allocator<U>& alloc, node_type* object) noexcept
+		{
+			if (!enabled()) {
+				alloc.delete_object(object);
+				return;
+			}
+
+			alloc.destroy(object);
+			deallocate(object);
+		}
+
+		/** The next chunk gets room for at least nodes slots, so a known number of nodes takes one allocation
+		 */
+		void reserve(size_t nodes) noexcept
+		{
+			_reserved = nodes;
+		}
+
+		/** Returns every chunk to the resource, all nodes taken from the pool must be destroyed by then
+		 */
+		void release() noexcept
+		{
+			while (_chunks) {
+				chunk_header* next = _chunks->next;
+				_allocator.deallocate_bytes(_chunks, _chunks->bytes, _slot_alignment);
+				_chunks = next;
+			}
+
+			_free = nullptr;
+		}
+
+		void swap(node_pool& other) noexcept
+		{
+			std::swap(_allocator, other._allocator);
+			std::swap(_chunk_nodes, other._chunk_nodes);
+			std::swap(_reserved, other._reserved);
+			std::swap(_slot_size, other._slot_size);
+			std::swap(_slot_alignment, other._slot_alignment);
+			std::swap(_free, other._free);
+			std::swap(_chunks, other._chunks);
+		}
+
+	private:
+		void* allocate(size_t size, size_t alignment)
+		{
+			if (_slot_size == 0) {
+				_slot_alignment = std::max(alignment, alignof(chunk_header));
+				_slot_size = (std::max(size, sizeof(free_slot)) + _slot_alignment - 1) / _slot_alignment * _slot_alignment;
+			} else if (size > _slot_size || alignment > _slot_alignment) {
+				throw std::logic_error("Node type does not fit into pool slot");
+			}
+
+			if (!_free) {
+				grow();
+			}
+
+			free_slot* slot = _free;
+			_free = slot->next;
+			return slot;
+		}
+
+		void deallocate(void* slot) noexcept
+		{
+			auto* freed = static_cast<free_slot*>(slot);
+			freed->next = _free;
+			_free = freed;
+		}
+
+		// Chunk layout: header padded to slot alignment, then _chunk_nodes slots threaded into the free-list
+		void grow()
+		{
+			size_t header = (sizeof(chunk_header) + _slot_alignment - 1) / _slot_alignment * _slot_alignment;
+			size_t slots = std::max(_chunk_nodes, _reserved);
+			size_t bytes = header + slots * _slot_size;
+
+			auto* memory = static_cast<unsigned char*>(_allocator.allocate_bytes(bytes, _slot_alignment));
+			_chunks = ::new (memory) chunk_header{_chunks, bytes};
+			_reserved = 0;
+
+			for (size_t i = slots; i-- > 0;) {
+				deallocate(memory + header + i * _slot_size);
+			}
+		}
+	};
 }// namespace __detail
 
+/** Tells a constructor that its input is sorted by key without duplicates, so the tree is linked in O(n).
+ *  Unsorted input breaks the search order.
+ */
+struct sorted_unique_t
+{
+	explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
 
 template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename tag = __detail::BST_TAG>
 class binary_search_tree : private compare
@@ -45,13 +228,18 @@ protected:
 		template<class... Args>
 		explicit node(node* parent, Args&&... args);
 
-		virtual ~node() = default;
+		// Not virtual: bst_impl::delete_node of the tag destroys the concrete node type
+		~node() noexcept = default;
 	};
 
 	friend class __detail::bst_impl<tkey, tvalue, compare, tag>;
 
 	inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
 
+	// Mixed comparisons for the lookups by key_like, see transparent_compator
+	template<typename lhs_key, typename rhs_key>
+	inline bool compare_keys(const lhs_key& lhs, const rhs_key& rhs) const;
+
 	inline bool compare_pairs(const value_type& lhs, const value_type& rhs) const;
 
 public:
@@ -102,8 +290,6 @@ public:
 
 		explicit prefix_iterator(node* data = nullptr, node* backup = nullptr);
 
-		virtual ~prefix_iterator() = default;
-
 		bool operator==(
 				prefix_iterator const& other) const noexcept;
 
@@ -148,13 +334,11 @@ public:
 
 		prefix_const_iterator(const prefix_iterator&) noexcept;
 
-		virtual ~prefix_const_iterator() = default;
-
 		bool operator==(
-				prefix_iterator const& other) const noexcept;
+				prefix_const_iterator const& other) const noexcept;
 
 		bool operator!=(
-				prefix_iterator const& other) const noexcept;
+				prefix_const_iterator const& other) const noexcept;
 
 		prefix_const_iterator& operator++() & noexcept;
 
@@ -198,8 +382,6 @@ public:
 
 		prefix_iterator base() const noexcept;
 
-		virtual ~prefix_reverse_iterator() = default;
-
 		bool operator==(prefix_reverse_iterator const& other) const noexcept;
 
 		bool operator!=(prefix_reverse_iterator const& other) const noexcept;
@@ -247,8 +429,6 @@ public:
 
 		prefix_const_iterator base() const noexcept;
 
-		virtual ~prefix_const_reverse_iterator() = default;
-
 		bool operator==(prefix_const_reverse_iterator const& other) const noexcept;
 
 		bool operator!=(prefix_const_reverse_iterator const& other) const noexcept;
@@ -299,8 +479,6 @@ public:
 
 		explicit infix_iterator(node* data = nullptr, node* backup = nullptr);
 
-		virtual ~infix_iterator() = default;
-
 		bool operator==(
 				infix_iterator const& other) const noexcept;
 
@@ -331,6 +509,8 @@ public:
 
 	class infix_const_iterator
 	{
+		friend class binary_search_tree;
+
 	protected:
 		infix_iterator _base;
 
@@ -345,13 +525,11 @@ public:
 
 		infix_const_iterator(const infix_iterator&) noexcept;
 
-		virtual ~infix_const_iterator() = default;
-
 		bool operator==(
-				infix_iterator const& other) const noexcept;
+				infix_const_iterator const& other) const noexcept;
 
 		bool operator!=(
-				infix_iterator const& other) const noexcept;
+				infix_const_iterator const& other) const noexcept;
 
 		infix_const_iterator& operator++() & noexcept;
 
@@ -395,8 +573,6 @@ public:
 
 		infix_iterator base() const noexcept;
 
-		virtual ~infix_reverse_iterator() = default;
-
 		bool operator==(infix_reverse_iterator const& other) const noexcept;
 
 		bool operator!=(infix_reverse_iterator const& other) const noexcept;
@@ -444,8 +620,6 @@ public:
 		operator infix_const_iterator() const noexcept;
 		infix_const_iterator base() const noexcept;
 
-		virtual ~infix_const_reverse_iterator() = default;
-
 		bool operator==(infix_const_reverse_iterator const& other) const noexcept;
 
 		bool operator!=(infix_const_reverse_iterator const& other) const noexcept;
@@ -494,8 +668,6 @@ public:
 
 		explicit postfix_iterator(node* data = nullptr, node* backup = nullptr);
 
-		virtual ~postfix_iterator() = default;
-
 		bool operator==(
 				postfix_iterator const& other) const noexcept;
 
@@ -539,13 +711,11 @@ public:
 
 		postfix_const_iterator(const postfix_iterator&) noexcept;
 
-		virtual ~postfix_const_iterator() = default;
-
 		bool operator==(
-				postfix_iterator const& other) const noexcept;
+				postfix_const_iterator const& other) const noexcept;
 
 		bool operator!=(
-				postfix_iterator const& other) const noexcept;
+				postfix_const_iterator const& other) const noexcept;
 
 		postfix_const_iterator& operator++() & noexcept;
 
@@ -590,8 +760,6 @@ public:
 
 		postfix_iterator base() const noexcept;
 
-		virtual ~postfix_reverse_iterator() = default;
-
 		bool operator==(postfix_reverse_iterator const& other) const noexcept;
 
 		bool operator!=(postfix_reverse_iterator const& other) const noexcept;
@@ -639,8 +807,6 @@ public:
 		operator postfix_const_iterator() const noexcept;
 		postfix_const_iterator base() const noexcept;
 
-		virtual ~postfix_const_reverse_iterator() = default;
-
 		bool operator==(postfix_const_reverse_iterator const& other) const noexcept;
 
 		bool operator!=(postfix_const_reverse_iterator const& other) const noexcept;
@@ -696,6 +862,14 @@ protected:
      */
 	pp_allocator<value_type> _allocator;
 
+	/** Node memory when use_node_pool is on, otherwise passes straight to _allocator
+	 */
+	__detail::node_pool _pool;
+
+	/** Subtree sizes are kept in nodes of the tag that supports them, see bst_impl::subtree_size
+	 */
+	bool _order_statistics = false;
+
 public:
 	explicit binary_search_tree(
 			const compare& comp = compare(),
@@ -723,6 +897,11 @@ public:
 					   pp_allocator<value_type> alloc = pp_allocator<value_type>(),
 					   logger* logger = nullptr);
 
+	template<std::input_iterator iterator>
+	binary_search_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+					   pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+					   logger* logger = nullptr);
+
 public:
 	binary_search_tree(const binary_search_tree& other);
 
@@ -745,16 +924,31 @@ public:
 
 	size_t size() const noexcept;
 
+	compare key_comp() const;
+
+	/** Copies the tree into an immutable array layout that is faster to search,
+	 *  frozen_search_tree::refresh brings it up to date after the tree changes
+	 */
+	frozen_search_tree<tkey, tvalue, compare> freeze() const;
+
 	void clear() noexcept;
 
 	void clear(node* n);
 
+	/** Takes nodes from per-tree chunks of chunk_nodes slots and reuses freed ones,
+	 *  0 goes back to one allocator call per node. Throws std::logic_error if the tree is not empty.
+	 */
+	void use_node_pool(size_t chunk_nodes = 64);
+
 	std::pair<infix_iterator, bool> insert(const value_type&);
 	std::pair<infix_iterator, bool> insert(value_type&&);
 
 	template<std::input_iterator InputIt>
 	void insert(InputIt first, InputIt last);
 
+	/** A forward range sorted by key is merged with the tree and relinked in O(n + k)
+	 *  when that is cheaper than k separate inserts
+	 */
 	template<std::ranges::input_range R>
 	void insert_range(R&& rg);
 
@@ -771,6 +965,15 @@ public:
 	template<class... Args>
 	infix_iterator emplace_or_assign(Args&&... args);
 
+	/** The search for the place starts at hint (the last node for end()) instead of the root, see find_from.
+	 *  Returns the inserted node or the one that already had the key
+	 */
+	infix_iterator insert(infix_const_iterator hint, const value_type&);
+	infix_iterator insert(infix_const_iterator hint, value_type&&);
+
+	template<class... Args>
+	infix_iterator emplace_hint(infix_const_iterator hint, Args&&... args);
+
 	virtual void swap(binary_search_tree& other) noexcept;
 
 	bool contains(const tkey& key) const;
@@ -778,6 +981,12 @@ public:
 	infix_iterator find(const tkey&);
 	infix_const_iterator find(const tkey&) const;
 
+	/** Finger search: climbs from pos only up to the lowest node whose subtree can hold key and descends from there,
+	 *  so the cost follows the distance between pos and key rather than the tree height
+	 */
+	infix_iterator find_from(infix_const_iterator pos, const tkey&);
+	infix_const_iterator find_from(infix_const_iterator pos, const tkey&) const;
+
 
 	infix_iterator lower_bound(const tkey&);
 	infix_const_iterator lower_bound(const tkey&) const;
@@ -785,6 +994,27 @@ public:
 	infix_iterator upper_bound(const tkey&);
 	infix_const_iterator upper_bound(const tkey&) const;
 
+	/** Lookups by a key of another type that compare orders against tkey (compare::is_transparent, e.g. std::less<>
+	 *  with std::string_view for std::string keys), no temporary tkey is built
+	 */
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	bool contains(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_iterator find(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_const_iterator find(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_iterator lower_bound(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_const_iterator lower_bound(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_iterator upper_bound(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	infix_const_iterator upper_bound(const key_like& key) const;
+
 	infix_iterator erase(infix_iterator pos);
 	infix_iterator erase(infix_const_iterator pos);
 
@@ -898,6 +1128,186 @@ public:
 	// endregion iterators requests definition
 
 protected:
+	template<std::forward_iterator iterator, std::sentinel_for<iterator> sentinel>
+	bool is_sorted_unique(iterator first, sentinel last) const;
+
+	/** Merges values sorted by key without duplicates into the tree and relinks all nodes
+	 *  into a perfectly balanced shape, existing keys keep their values. O(n + k)
+	 */
+	template<std::input_iterator iterator, std::sentinel_for<iterator> sentinel>
+	void merge_sorted(iterator first, sentinel last, size_t count = 0);
+
+	// Links count nodes given in key order into a balanced subtree, returns its root
+	static node* link_balanced(node** nodes, size_t count, node* parent) noexcept;
+
+	/** Node to descend from when searching for key near finger: the lowest ancestor of finger whose subtree
+	 *  can hold key, or the root when finger is nullptr
+	 */
+	node* finger_start(node* finger, const tkey& key) const noexcept;
+
+	// Descents shared by the lookups by tkey and by key_like
+	template<typename key_like>
+	node* find_node(const key_like& key) const;
+
+	template<typename key_like>
+	node* lower_bound_node(const key_like& key) const;
+
+	template<typename key_like>
+	node* upper_bound_node(const key_like& key) const;
+
+	template<typename value_ref>
+	infix_iterator insert_from(node* finger, value_ref&& value);
+
+	/** Clones other node by node into this empty tree, keeping its shape and balancing fields. O(n) without extra memory:
+	 *  other is walked over parent links and the copy follows in lockstep
+	 */
+	void copy_structure(const binary_search_tree& other);
+
+	// region order statistics definition
+
+	/* Need bst_impl<tag>::subtree_size, which is 0 for every node while order statistics are off
+	 */
+
+	// Node at 0-based infix position index in the subtree, nullptr if there is none
+	static node* select_node(node* subtree_root, size_t index) noexcept;
+
+	// Number of nodes before n in infix order of the whole tree
+	static size_t node_rank(node* n) noexcept;
+
+	static node* root_of(node* n) noexcept;
+
+	// Number of keys less than key, or not greater than key if inclusive
+	size_t count_less(const tkey& key, bool inclusive) const;
+
+	/** Moves an infix iterator by offset in O(log n), positions outside of [begin, end] give end.
+	 *  Falls back to stepping when sizes are not kept
+	 */
+	static void advance_infix(infix_iterator& it, ptrdiff_t offset) noexcept;
+
+	static ptrdiff_t infix_distance(const infix_iterator& from, const infix_iterator& to) noexcept;
+
+	// Throws std::logic_error unless order statistics are on
+	void check_order_statistics() const;
+
+	// Turns order statistics on, sizes of existing nodes are filled in O(n)
+	void enable_order_statistics() noexcept;
+
+	// Post-order recalculation of every subtree size
+	static void build_sizes(node* n) noexcept;
+
+	// endregion order statistics definition
+
+	// region join-based operations definition
+
+	/* Need bst_impl<tag>::join(cont, left, middle, right), which links two balanced subtrees and a middle node
+	 * whose key lies between them into one balanced subtree with a detached root, and bst_impl<tag>::post_join(cont),
+	 * which restores invariants of the tree root. Recursive calls on the two halves touch disjoint nodes
+	 */
+
+	// join with the parents of the subtree roots cleared first
+	node* join_nodes(node* left, node* middle, node* right);
+
+	// Joins two subtrees, every key of left is less than every key of right
+	node* join_subtrees(node* left, node* right);
+
+	/** Takes keys less than key into left and greater into right, the node holding key is returned detached.
+	 *  O(log n) joins
+	 */
+	node* split_subtree(node* subtree_root, const tkey& key, node*& left, node*& right);
+
+	// Detaches the node with the greatest key, rest receives the others
+	node* split_last(node* subtree_root, node*& rest);
+
+	// Nodes of rhs become nodes of lhs, duplicates of lhs keys are deleted
+	node* union_subtrees(node* lhs, node* rhs, size_t& duplicates, fork_join_pool* pool = nullptr, size_t forks = 0);
+
+	// Deletes nodes of lhs whose keys are missing in rhs
+	node* intersect_subtrees(node* lhs, const node* rhs, size_t& removed);
+
+	// Deletes nodes of lhs whose keys are present in rhs
+	node* subtract_subtrees(node* lhs, const node* rhs, size_t& removed);
+
+	// Returns the number of deleted nodes
+	size_t delete_subtree(node* n) noexcept;
+
+	static size_t count_nodes(const node* n) noexcept;
+
+	// Nodes can move between the trees only if both use the same allocator and no node pool
+	bool shares_nodes_with(const binary_search_tree& other) const noexcept;
+
+	// Both trees keep subtree sizes if one of them does
+	void align_order_statistics(binary_search_tree& other) noexcept;
+
+	void set_root(node* root) noexcept;
+
+	// Copies the values of a tree whose nodes cannot be taken
+	std::vector<value_type, pp_allocator<value_type>> copy_values(const binary_search_tree& other) const;
+
+	void join_tree(binary_search_tree& other);
+
+	// right is an empty tree with the same settings
+	void split_tree(const tkey& key, binary_search_tree& right);
+
+	void union_tree(binary_search_tree& other);
+
+	void intersect_tree(const binary_search_tree& other);
+
+	void subtract_tree(const binary_search_tree& other);
+
+	// endregion join-based operations definition
+
+	// region parallel operations definition
+
+	/* pool is nullptr for a sequential run, forks is how many more times the work may be split in two.
+	 * Several threads take node memory from the allocator at once, so the node pool turns parallel runs off
+	 */
+
+	// Below this many nodes a piece of work is not split any more
+	static constexpr size_t parallel_grain = 2048;
+
+	template<typename Left, typename Right>
+	static void fork(fork_join_pool* pool, size_t forks, Left&& left, Right&& right);
+
+	// About four tasks per thread
+	static size_t fork_depth(const fork_join_pool* pool) noexcept;
+
+	// nullptr when nodes cannot be created and deleted by several threads
+	fork_join_pool* node_workers(fork_join_pool& pool) const noexcept;
+
+	// iterator supports + even for std::move_iterator, which models input_iterator only
+	template<std::input_iterator iterator>
+	void create_nodes(iterator first, node** nodes, size_t count, fork_join_pool* pool, size_t forks);
+
+	// Stable merge sort by key, the result lands in buffer if into_buffer and in nodes otherwise
+	void sort_nodes(node** nodes, node** buffer, size_t count, bool into_buffer, fork_join_pool* pool, size_t forks);
+
+	// Stable merge of two sorted runs, equal keys of the first run go first
+	void merge_nodes(node** first1, node** last1, node** first2, node** last2, node** out, fork_join_pool* pool, size_t forks);
+
+	// Deletes all but the first of equal keys of sorted fresh nodes, returns how many are left in front
+	size_t unique_nodes(node** nodes, size_t count, fork_join_pool* pool, size_t forks);
+
+	// Joins nodes given in key order into a balanced subtree in O(n)
+	node* build_subtree(node** nodes, size_t count, fork_join_pool* pool, size_t forks);
+
+	size_t delete_subtree(node* n, fork_join_pool* pool, size_t forks);
+
+	template<std::ranges::input_range R>
+	void parallel_insert_range(fork_join_pool& pool, R&& rg);
+
+	// Erases keys in [lo, hi] by two splits and one join, the cut out subtree is deleted on the pool
+	size_t erase_key_range(const tkey& lo, const tkey& hi, fork_join_pool* pool);
+
+	// Every node is visited once, in key order for a sequential run
+	template<typename node_pointer, typename F>
+	static void visit_subtree(node_pointer n, F& function, fork_join_pool* pool, size_t forks);
+
+	// Results are combined in key order, so reduce has to be associative only
+	template<typename T, typename Map, typename Reduce>
+	static T reduce_subtree(const node* n, Map& map, Reduce& reduce, const T& identity, fork_join_pool* pool, size_t forks);
+
+	// endregion parallel operations definition
+
 	// region subtree rotations definition
 
 	static void small_left_rotation(node*& subtree_root) noexcept;
@@ -927,12 +1337,20 @@ namespace __detail
 		// Only calls destructor and frees memory
 		static void delete_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node** node);
 
+		// New node with the data and balancing fields of source, links are left to the caller
+		static binary_search_tree<tkey, tvalue, compare, tag>::node* clone_node(binary_search_tree<tkey, tvalue, compare, tag>& cont,
+																				 const binary_search_tree<tkey, tvalue, compare, tag>::node* source,
+																				 binary_search_tree<tkey, tvalue, compare, tag>::node* parent);
+
 		//Does not invalidate node*, needed for splay tree
 		static void post_search(binary_search_tree<tkey, tvalue, compare, tag>::node**) {}
 
 		//Does not invalidate node*
 		static void post_insert(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node**) {}
 
+		// Called after merge_sorted relinked the whole tree into a perfectly balanced shape
+		static void post_build(binary_search_tree<tkey, tvalue, compare, tag>& cont) {}
+
 		// Removes this node from tree and deletes it
 		static void erase(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node**);
 
@@ -944,10 +1362,12 @@ template<typename tkey, typename tvalue, typename compare, typename tag>
 void __detail::bst_impl<tkey, tvalue, compare, tag>::swap(binary_search_tree<tkey, tvalue, compare, tag> &lhs,
                                                 binary_search_tree<tkey, tvalue, compare, tag> &rhs) noexcept
 {
-    std::swap(lhs.root, rhs.root);
+    std::swap(lhs._root, rhs._root);
     std::swap(lhs._logger, rhs._logger);
     std::swap(lhs._size, rhs._size);
     std::swap(lhs._allocator, rhs._allocator);
+    lhs._pool.swap(rhs._pool);
+    std::swap(lhs._order_statistics, rhs._order_statistics);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -956,9 +1376,7 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(iterator begi
                                                                    pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type> alloc, logger *logger)
                                                                        : compare(cmp), _root(nullptr), _logger(logger), _size(0), _allocator(alloc)
 {
-    for (auto it = begin; it != end; ++it) {
-        emplace(it->first, it->second);
-    }
+    insert_range(std::ranges::subrange(begin, end));
 }
 
 
@@ -975,6 +1393,13 @@ bool binary_search_tree<tkey, tvalue, compare, tag>::compare_keys(const tkey &lh
     return compare::operator()(lhs, rhs);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename lhs_key, typename rhs_key>
+bool binary_search_tree<tkey, tvalue, compare, tag>::compare_keys(const lhs_key &lhs, const rhs_key &rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
 template<typename compare, typename U, typename iterator>
 explicit binary_search_tree(iterator begin, iterator end, const compare& cmp = compare(),
                             pp_allocator<U> alloc = pp_allocator<U>(),
@@ -1008,14 +1433,14 @@ template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator==(
         prefix_iterator const &other) const noexcept
 {
-    return _data == &other._data;
+    return _data == other._data;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator!=(
         prefix_iterator const &other) const noexcept
 {
-    return _data != &other._data;
+    return _data != other._data;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -1148,14 +1573,14 @@ binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::prefix_co
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator==(
-        prefix_iterator const &other) const noexcept
+        prefix_const_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator!=(
-        prefix_iterator const &other) const noexcept
+        prefix_const_iterator const &other) const noexcept
 {
     return _base != other._base;
 }
@@ -1544,13 +1969,13 @@ template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::infix_const_iterator(const infix_iterator& it) noexcept : _base(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator==(infix_iterator const& other) const noexcept
+bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator==(infix_const_iterator const& other) const noexcept
 {
     return _base == other._base;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator!=(infix_iterator const& other) const noexcept
+bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator!=(infix_const_iterator const& other) const noexcept
 {
     return _base != other._base;
 }
@@ -1933,13 +2358,13 @@ template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::postfix_const_iterator(const postfix_iterator& it) noexcept : _base(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator==(postfix_iterator const &other) const noexcept
+bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator==(postfix_const_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator!=(postfix_iterator const &other) const noexcept
+bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator!=(postfix_const_iterator const &other) const noexcept
 {
     return _base != other._base;
 }
@@ -2194,13 +2619,13 @@ template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
-        logger *logger) : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr) {}
+        logger *logger) : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
-        logger *logger) : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr) {}
+        logger *logger) : compare(comp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<std::ranges::input_range Range>
@@ -2208,12 +2633,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr)
+        logger* logger) : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
-    // && Для того, чтобы в форварде либо перемещать (r-value), либо копировать (l-value)
-    for (auto&& element: range) {
-        emplace(std::forward<decltype(element)>(element));
-    }
+    insert_range(std::forward<Range>(range));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -2221,10 +2643,24 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* logger) : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr)
+        logger* logger) : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
+{
+    insert_range(data);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::input_iterator iterator>
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
+        sorted_unique_t,
+        iterator begin, iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* logger) : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
-    for (const auto& element: data) {
-        emplace(element.first, element.second);
+    if constexpr (std::forward_iterator<iterator>) {
+        merge_sorted(begin, end, static_cast<size_t>(std::distance(begin, end)));
+    } else {
+        merge_sorted(begin, end);
     }
 }
 
@@ -2233,22 +2669,16 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
 // region binary_search_tree 5_rules implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(const binary_search_tree &other) : compare(other.compare), _logger(other._logger), _allocator(other._allocator)
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(const binary_search_tree &other) : compare(other), _root(nullptr), _logger(other._logger), _size(0), _allocator(other._allocator), _order_statistics(other._order_statistics)
 {
-    if (!other._root) {
-        _root = nullptr;
-    } else {
-        _root = _allocator.template new_object<node>(nullptr, other._root->data);
-        for (auto it = other.begin(); it != other.end(); ++it) {
-            if (it != other.begin()) {
-                emplace(it->first, it->second);
-            }
-        }
-    }
+    use_node_pool(other._pool.chunk_nodes());
+    _pool.reserve(other._size);
+
+    copy_structure(other);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(binary_search_tree &&other) noexcept : compare(std::move(other)), _root(other._root), _logger(other._logger), _allocator(std::move(other._allocator)), _size(other._size)
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(binary_search_tree &&other) noexcept : compare(std::move(other)), _root(other._root), _logger(other._logger), _allocator(std::move(other._allocator)), _size(other._size), _pool(std::move(other._pool)), _order_statistics(other._order_statistics)
 {
     other._root = nullptr;
     other._logger = nullptr;
@@ -2372,19 +2802,42 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::size() const noexcept
     return this->_size;
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+compare binary_search_tree<tkey, tvalue, compare, tag>::key_comp() const
+{
+    return static_cast<const compare&>(*this);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+frozen_search_tree<tkey, tvalue, compare> binary_search_tree<tkey, tvalue, compare, tag>::freeze() const
+{
+    frozen_search_tree<tkey, tvalue, compare> frozen(key_comp());
+    frozen.refresh(cbegin_infix(), cend_infix());
+
+    return frozen;
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 void binary_search_tree<tkey, tvalue, compare, tag>::clear() noexcept
 {
     clear(_root);
+    _root = nullptr;
+    _size = 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 void binary_search_tree<tkey, tvalue, compare, tag>::clear(node* n) {
-    if (n != nullptr) {
-        clear(n->left_subtree);
-        clear(n->right_subtree);
-        _allocator.delete_object(n);
+    delete_subtree(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::use_node_pool(size_t chunk_nodes)
+{
+    if (_root) {
+        throw std::logic_error("Node pool can be switched only on empty tree");
     }
+
+    _pool = __detail::node_pool(_allocator, chunk_nodes);
 }
 
 // endregion binary_search_tree methods_access implementation
@@ -2473,76 +2926,1156 @@ template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<std::input_iterator InputIt>
 void binary_search_tree<tkey, tvalue, compare, tag>::insert(InputIt first, InputIt last)
 {
-    for (auto it = first; it != last; ++it) {
-        insert(*it);
-    }
+    insert_range(std::ranges::subrange(first, last));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<std::ranges::input_range R>
 void binary_search_tree<tkey, tvalue, compare, tag>::insert_range(R&& rg)
 {
+    if constexpr (std::ranges::forward_range<R>) {
+        auto count = static_cast<size_t>(std::ranges::distance(rg));
+        size_t total = _size + count;
+
+        // k inserts cost about k * log2(n + k) steps, relinking costs n + k
+        if (count * std::bit_width(total) >= total && is_sorted_unique(std::ranges::begin(rg), std::ranges::end(rg))) {
+            merge_sorted(std::ranges::begin(rg), std::ranges::end(rg), count);
+            return;
+        }
+    }
+
     for (auto&& element: rg) {
         insert(std::forward<decltype(element)>(element));
     }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-template<class ...Args>
-std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool>
-binary_search_tree<tkey, tvalue, compare, tag>::emplace(Args&&... args)
+template<std::forward_iterator iterator, std::sentinel_for<iterator> sentinel>
+bool binary_search_tree<tkey, tvalue, compare, tag>::is_sorted_unique(iterator first, sentinel last) const
 {
-    value_type value(std::forward<Args>(args)...);
-    return insert(value);
+    if (first == last) {
+        return true;
+    }
+
+    for (auto next = std::next(first); next != last; first = next, ++next) {
+        if (!compare_keys((*first).first, (*next).first)) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_type& value)
+template<std::input_iterator iterator, std::sentinel_for<iterator> sentinel>
+void binary_search_tree<tkey, tvalue, compare, tag>::merge_sorted(iterator first, sentinel last, size_t count)
 {
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    std::vector<node*, pp_allocator<node*>> fresh(_allocator);
+    std::vector<node*, pp_allocator<node*>> nodes(_allocator);
+    fresh.reserve(count);
+    nodes.reserve(_size + count);
+
+    try {
+        for (; first != last; ++first) {
+            fresh.push_back(impl::create_node(*this, nullptr, *first));
+        }
+
+        nodes.reserve(_size + fresh.size());
+    } catch (...) {
+        for (node* n: fresh) {
+            impl::delete_node(*this, &n);
+        }
+
+        throw;
+    }
+
+    // In-order walk over parent links, old nodes are interleaved with fresh ones
+    size_t next_fresh = 0;
     node* current = _root;
-    node* parent = nullptr;
+
+    while (current && current->left_subtree) {
+        current = current->left_subtree;
+    }
 
     while (current) {
-        parent = current;
+        while (next_fresh < fresh.size() && compare_keys(fresh[next_fresh]->data.first, current->data.first)) {
+            nodes.push_back(fresh[next_fresh++]);
+        }
 
-        if (compare_keys(value.first, current->data.first)) {
-            current = current->left_subtree;
-        } else if (compare_keys(current->data.first, value.first)) {
+        if (next_fresh < fresh.size() && !compare_keys(current->data.first, fresh[next_fresh]->data.first)) {
+            impl::delete_node(*this, &fresh[next_fresh++]);
+        }
+
+        nodes.push_back(current);
+
+        if (current->right_subtree) {
             current = current->right_subtree;
+
+            while (current->left_subtree) {
+                current = current->left_subtree;
+            }
         } else {
-            current->data.second = value.second;
-            return infix_iterator(current);
+            while (current->parent && current->parent->right_subtree == current) {
+                current = current->parent;
+            }
+
+            current = current->parent;
         }
     }
 
-    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, value);
+    nodes.insert(nodes.end(), fresh.begin() + next_fresh, fresh.end());
 
-    if (!parent) {
-        _root = new_node;
-    } else if (compare_keys(new_node->data.first, parent->data.first)) {
-        parent->left_subtree = new_node;
-    } else {
-        parent->right_subtree = new_node;
-    }
+    _root = link_balanced(nodes.data(), nodes.size(), nullptr);
+    _size = nodes.size();
 
-    ++_size;
+    impl::post_build(*this);
 
     if (_logger) {
-        _logger->log("New node inserted or assigned", logger::severity::debug);
+        _logger->log("Sorted run merged", logger::severity::debug);
     }
-
-    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
-
-    return infix_iterator(new_node);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& value)
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::link_balanced(node** nodes, size_t count, node* parent) noexcept
 {
-    node* current = _root;
-    node* parent = nullptr;
+    if (count == 0) {
+        return nullptr;
+    }
+
+    size_t middle = count / 2;
+    node* root = nodes[middle];
+
+    root->parent = parent;
+    root->left_subtree = link_balanced(nodes, middle, root);
+    root->right_subtree = link_balanced(nodes + middle + 1, count - middle - 1, root);
+
+    return root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::copy_structure(const binary_search_tree& other)
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    if (!other._root) {
+        return;
+    }
+
+    const node* source = other._root;
+
+    // Every clone is linked at once, so a throwing copy leaves a valid partial tree to clear
+    try {
+        node* copy = _root = impl::clone_node(*this, source, nullptr);
+
+        while (true) {
+            if (source->left_subtree && !copy->left_subtree) {
+                source = source->left_subtree;
+                copy = copy->left_subtree = impl::clone_node(*this, source, copy);
+            } else if (source->right_subtree && !copy->right_subtree) {
+                source = source->right_subtree;
+                copy = copy->right_subtree = impl::clone_node(*this, source, copy);
+            } else if (source != other._root) {
+                source = source->parent;
+                copy = copy->parent;
+            } else {
+                break;
+            }
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+
+    _size = other._size;
+}
+
+// region order statistics implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::select_node(node* subtree_root, size_t index) noexcept
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    node* current = subtree_root;
+
+    while (current) {
+        size_t left_size = impl::subtree_size(current->left_subtree);
+
+        if (index < left_size) {
+            current = current->left_subtree;
+        } else if (index == left_size) {
+            return current;
+        } else {
+            index -= left_size + 1;
+            current = current->right_subtree;
+        }
+    }
+
+    return nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::node_rank(node* n) noexcept
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    size_t rank = impl::subtree_size(n->left_subtree);
+
+    for (; n->parent; n = n->parent) {
+        if (n->parent->right_subtree == n) {
+            rank += impl::subtree_size(n->parent->left_subtree) + 1;
+        }
+    }
+
+    return rank;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::root_of(node* n) noexcept
+{
+    while (n->parent) {
+        n = n->parent;
+    }
+
+    return n;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::count_less(const tkey& key, bool inclusive) const
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    size_t count = 0;
+    node* current = _root;
+
+    while (current) {
+        bool before = inclusive ? !compare_keys(key, current->data.first) : compare_keys(current->data.first, key);
+
+        if (before) {
+            count += impl::subtree_size(current->left_subtree) + 1;
+            current = current->right_subtree;
+        } else {
+            current = current->left_subtree;
+        }
+    }
+
+    return count;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::advance_infix(infix_iterator& it, ptrdiff_t offset) noexcept
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    node* anchor = it._data ? it._data : it._backup;
+
+    if (offset == 0 || !anchor) {
+        return;
+    }
+
+    node* root = root_of(anchor);
+
+    if (impl::subtree_size(anchor) == 0) {
+        for (; offset > 0 && it._data; --offset) {
+            ++it;
+        }
+
+        for (; offset < 0 && (--it)._data; ++offset) {}
+
+        if (!it._data) {
+            for (it._backup = root; it._backup->right_subtree; it._backup = it._backup->right_subtree) {}
+        }
+
+        return;
+    }
+
+    size_t total = impl::subtree_size(root);
+    size_t rank = it._data ? node_rank(it._data) : total;
+    size_t target = total;
+
+    if (offset < 0 ? static_cast<size_t>(-offset) <= rank : static_cast<size_t>(offset) <= total - rank) {
+        target = rank + offset;
+    }
+
+    if (target == total) {
+        it._data = nullptr;
+        it._backup = select_node(root, total - 1);
+    } else {
+        it._data = select_node(root, target);
+        it._backup = it._data;
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+ptrdiff_t binary_search_tree<tkey, tvalue, compare, tag>::infix_distance(const infix_iterator& from, const infix_iterator& to) noexcept
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag>;
+
+    node* anchor = from._data ? from._data : (from._backup ? from._backup : (to._data ? to._data : to._backup));
+
+    if (!anchor) {
+        return 0;
+    }
+
+    if (impl::subtree_size(anchor) == 0) {
+        ptrdiff_t steps = 0;
+        infix_iterator it = from;
+
+        for (; it._data && it._data != to._data; ++it) {
+            ++steps;
+        }
+
+        if (it._data == to._data) {
+            return steps;
+        }
+
+        steps = 0;
+
+        for (it = to; it._data && it._data != from._data; ++it) {
+            ++steps;
+        }
+
+        return -steps;
+    }
+
+    size_t total = impl::subtree_size(root_of(anchor));
+    size_t from_rank = from._data ? node_rank(from._data) : total;
+    size_t to_rank = to._data ? node_rank(to._data) : total;
+
+    return static_cast<ptrdiff_t>(to_rank) - static_cast<ptrdiff_t>(from_rank);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::check_order_statistics() const
+{
+    if (!_order_statistics) {
+        throw std::logic_error("Order statistics are not enabled");
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::enable_order_statistics() noexcept
+{
+    if (!_order_statistics) {
+        _order_statistics = true;
+        build_sizes(_root);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::build_sizes(node* n) noexcept
+{
+    if (!n) {
+        return;
+    }
+
+    build_sizes(n->left_subtree);
+    build_sizes(n->right_subtree);
+    __detail::bst_impl<tkey, tvalue, compare, tag>::recalculate_size(n);
+}
+
+// endregion order statistics implementation
+
+// region join-based operations implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::join_nodes(node* left, node* middle, node* right)
+{
+    if (left) {
+        left->parent = nullptr;
+    }
+
+    if (right) {
+        right->parent = nullptr;
+    }
+
+    return __detail::bst_impl<tkey, tvalue, compare, tag>::join(*this, left, middle, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::join_subtrees(node* left, node* right)
+{
+    if (!left) {
+        return right;
+    }
+
+    if (!right) {
+        return left;
+    }
+
+    node* rest;
+    node* last = split_last(left, rest);
+
+    return join_nodes(rest, last, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::split_subtree(node* subtree_root, const tkey& key, node*& left, node*& right)
+{
+    if (!subtree_root) {
+        left = right = nullptr;
+        return nullptr;
+    }
+
+    node* lower = subtree_root->left_subtree;
+    node* upper = subtree_root->right_subtree;
+
+    subtree_root->left_subtree = subtree_root->right_subtree = subtree_root->parent = nullptr;
+
+    if (compare_keys(key, subtree_root->data.first)) {
+        node* found = split_subtree(lower, key, left, right);
+        right = join_nodes(right, subtree_root, upper);
+        return found;
+    }
+
+    if (compare_keys(subtree_root->data.first, key)) {
+        node* found = split_subtree(upper, key, left, right);
+        left = join_nodes(lower, subtree_root, left);
+        return found;
+    }
+
+    left = lower;
+    right = upper;
+
+    if (left) {
+        left->parent = nullptr;
+    }
+
+    if (right) {
+        right->parent = nullptr;
+    }
+
+    return subtree_root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::split_last(node* subtree_root, node*& rest)
+{
+    node* lower = subtree_root->left_subtree;
+    node* upper = subtree_root->right_subtree;
+
+    subtree_root->left_subtree = subtree_root->right_subtree = subtree_root->parent = nullptr;
+
+    if (!upper) {
+        rest = lower;
+
+        if (rest) {
+            rest->parent = nullptr;
+        }
+
+        return subtree_root;
+    }
+
+    node* upper_rest;
+    node* last = split_last(upper, upper_rest);
+    rest = join_nodes(lower, subtree_root, upper_rest);
+
+    return last;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::union_subtrees(node* lhs, node* rhs, size_t& duplicates, fork_join_pool* pool, size_t forks)
+{
+    if (!lhs) {
+        return rhs;
+    }
+
+    if (!rhs) {
+        return lhs;
+    }
+
+    node* lower = lhs->left_subtree;
+    node* upper = lhs->right_subtree;
+
+    lhs->left_subtree = lhs->right_subtree = lhs->parent = nullptr;
+
+    if (lower) {
+        lower->parent = nullptr;
+    }
+
+    if (upper) {
+        upper->parent = nullptr;
+    }
+
+    node* rhs_lower;
+    node* rhs_upper;
+    node* found = split_subtree(rhs, lhs->data.first, rhs_lower, rhs_upper);
+
+    if (found) {
+        __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &found);
+        ++duplicates;
+    }
+
+    node* left;
+    node* right;
+    size_t right_duplicates = 0;
+    size_t next = forks ? forks - 1 : 0;
+
+    fork(pool, forks,
+         [&] { left = union_subtrees(lower, rhs_lower, duplicates, pool, next); },
+         [&] { right = union_subtrees(upper, rhs_upper, right_duplicates, pool, next); });
+
+    duplicates += right_duplicates;
+
+    return join_nodes(left, lhs, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::intersect_subtrees(node* lhs, const node* rhs, size_t& removed)
+{
+    if (!lhs) {
+        return nullptr;
+    }
+
+    if (!rhs) {
+        removed += delete_subtree(lhs);
+        return nullptr;
+    }
+
+    node* lower;
+    node* upper;
+    node* found = split_subtree(lhs, rhs->data.first, lower, upper);
+
+    node* left = intersect_subtrees(lower, rhs->left_subtree, removed);
+    node* right = intersect_subtrees(upper, rhs->right_subtree, removed);
+
+    return found ? join_nodes(left, found, right) : join_subtrees(left, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::subtract_subtrees(node* lhs, const node* rhs, size_t& removed)
+{
+    if (!lhs || !rhs) {
+        return lhs;
+    }
+
+    node* lower;
+    node* upper;
+    node* found = split_subtree(lhs, rhs->data.first, lower, upper);
+
+    if (found) {
+        __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &found);
+        ++removed;
+    }
+
+    node* left = subtract_subtrees(lower, rhs->left_subtree, removed);
+    node* right = subtract_subtrees(upper, rhs->right_subtree, removed);
+
+    return join_subtrees(left, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::delete_subtree(node* n) noexcept
+{
+    size_t deleted = 0;
+
+    // Right rotations lift left children up until the subtree is a right spine, which is deleted while walking it.
+    // Only child links are read, so any shape goes in O(n) without recursion
+    while (n) {
+        if (node* left = n->left_subtree) {
+            n->left_subtree = left->right_subtree;
+            left->right_subtree = n;
+            n = left;
+        } else {
+            node* right = n->right_subtree;
+            __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &n);
+            n = right;
+            ++deleted;
+        }
+    }
+
+    return deleted;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::count_nodes(const node* n) noexcept
+{
+    return n ? count_nodes(n->left_subtree) + count_nodes(n->right_subtree) + 1 : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+bool binary_search_tree<tkey, tvalue, compare, tag>::shares_nodes_with(const binary_search_tree& other) const noexcept
+{
+    return _allocator == other._allocator && _pool.chunk_nodes() == 0 && other._pool.chunk_nodes() == 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::align_order_statistics(binary_search_tree& other) noexcept
+{
+    if (_order_statistics != other._order_statistics) {
+        enable_order_statistics();
+        other.enable_order_statistics();
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::set_root(node* root) noexcept
+{
+    _root = root;
+
+    if (_root) {
+        _root->parent = nullptr;
+    }
+
+    __detail::bst_impl<tkey, tvalue, compare, tag>::post_join(*this);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+std::vector<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type, pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type>>
+binary_search_tree<tkey, tvalue, compare, tag>::copy_values(const binary_search_tree& other) const
+{
+    std::vector<value_type, pp_allocator<value_type>> values(_allocator);
+    values.reserve(other._size);
+
+    std::stack<const node*> pending;
+    const node* current = other._root;
+
+    while (current || !pending.empty()) {
+        for (; current; current = current->left_subtree) {
+            pending.push(current);
+        }
+
+        current = pending.top();
+        pending.pop();
+
+        values.push_back(current->data);
+        current = current->right_subtree;
+    }
+
+    return values;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::join_tree(binary_search_tree& other)
+{
+    if (this == &other || !other._root) {
+        return;
+    }
+
+    if (_root) {
+        node* last = _root;
+        node* first = other._root;
+
+        while (last->right_subtree) {
+            last = last->right_subtree;
+        }
+
+        while (first->left_subtree) {
+            first = first->left_subtree;
+        }
+
+        if (!compare_keys(last->data.first, first->data.first)) {
+            throw std::invalid_argument("Keys of the joined tree must be greater than keys of this tree");
+        }
+    }
+
+    if (!shares_nodes_with(other)) {
+        insert_range(copy_values(other));
+        other.clear();
+        return;
+    }
+
+    align_order_statistics(other);
+
+    set_root(join_subtrees(_root, other._root));
+    _size += other._size;
+
+    other._root = nullptr;
+    other._size = 0;
+
+    if (_logger) {
+        _logger->log("Trees joined", logger::severity::debug);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::split_tree(const tkey& key, binary_search_tree& right)
+{
+    if (!_root) {
+        return;
+    }
+
+    if (!shares_nodes_with(right)) {
+        std::vector<value_type, pp_allocator<value_type>> tail(_allocator);
+
+        for (auto it = lower_bound(key); it != end(); ++it) {
+            tail.push_back(*it);
+        }
+
+        right.insert_range(tail);
+
+        for (auto& value: tail) {
+            erase(value.first);
+        }
+
+        return;
+    }
+
+    node* lower;
+    node* upper;
+    node* found = split_subtree(_root, key, lower, upper);
+
+    if (found) {
+        upper = join_nodes(nullptr, found, upper);
+    }
+
+    size_t moved = _order_statistics ? __detail::bst_impl<tkey, tvalue, compare, tag>::subtree_size(upper) : count_nodes(upper);
+
+    set_root(lower);
+    _size -= moved;
+
+    right.set_root(upper);
+    right._size = moved;
+
+    if (_logger) {
+        _logger->log("Tree split", logger::severity::debug);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::union_tree(binary_search_tree& other)
+{
+    if (this == &other || !other._root) {
+        return;
+    }
+
+    if (!shares_nodes_with(other)) {
+        insert_range(copy_values(other));
+        other.clear();
+        return;
+    }
+
+    align_order_statistics(other);
+
+    size_t duplicates = 0;
+
+    set_root(union_subtrees(_root, other._root, duplicates));
+    _size += other._size - duplicates;
+
+    other._root = nullptr;
+    other._size = 0;
+
+    if (_logger) {
+        _logger->log("Trees united", logger::severity::debug);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::intersect_tree(const binary_search_tree& other)
+{
+    if (this == &other) {
+        return;
+    }
+
+    size_t removed = 0;
+
+    set_root(intersect_subtrees(_root, other._root, removed));
+    _size -= removed;
+
+    if (_logger) {
+        _logger->log("Trees intersected", logger::severity::debug);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::subtract_tree(const binary_search_tree& other)
+{
+    if (this == &other) {
+        clear();
+        return;
+    }
+
+    size_t removed = 0;
+
+    set_root(subtract_subtrees(_root, other._root, removed));
+    _size -= removed;
+
+    if (_logger) {
+        _logger->log("Tree subtracted", logger::severity::debug);
+    }
+}
+
+// endregion join-based operations implementation
+
+// region parallel operations implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename Left, typename Right>
+void binary_search_tree<tkey, tvalue, compare, tag>::fork(fork_join_pool* pool, size_t forks, Left&& left, Right&& right)
+{
+    if (pool && forks) {
+        pool->invoke(left, right);
+    } else {
+        left();
+        right();
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::fork_depth(const fork_join_pool* pool) noexcept
+{
+    return pool && pool->concurrency() > 1 ? std::bit_width(pool->concurrency()) + 1 : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+fork_join_pool* binary_search_tree<tkey, tvalue, compare, tag>::node_workers(fork_join_pool& pool) const noexcept
+{
+    return _pool.chunk_nodes() == 0 ? &pool : nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::input_iterator iterator>
+void binary_search_tree<tkey, tvalue, compare, tag>::create_nodes(iterator first, node** nodes, size_t count, fork_join_pool* pool, size_t forks)
+{
+    if (!pool || !forks || count < parallel_grain) {
+        for (size_t i = 0; i < count; ++i, ++first) {
+            nodes[i] = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, nullptr, *first);
+        }
+
+        return;
+    }
+
+    size_t middle = count / 2;
+
+    fork(pool, forks,
+         [&] { create_nodes(first, nodes, middle, pool, forks - 1); },
+         [&] { create_nodes(first + middle, nodes + middle, count - middle, pool, forks - 1); });
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::sort_nodes(node** nodes, node** buffer, size_t count, bool into_buffer, fork_join_pool* pool, size_t forks)
+{
+    auto less = [this](node* lhs, node* rhs) { return compare_keys(lhs->data.first, rhs->data.first); };
+
+    if (!pool || !forks || count < parallel_grain) {
+        std::stable_sort(nodes, nodes + count, less);
+
+        if (into_buffer) {
+            std::copy(nodes, nodes + count, buffer);
+        }
+
+        return;
+    }
+
+    // Halves are sorted into the other array, so the merge moves them back
+    size_t middle = count / 2;
+
+    fork(pool, forks,
+         [&] { sort_nodes(nodes, buffer, middle, !into_buffer, pool, forks - 1); },
+         [&] { sort_nodes(nodes + middle, buffer + middle, count - middle, !into_buffer, pool, forks - 1); });
+
+    node** from = into_buffer ? nodes : buffer;
+    node** to = into_buffer ? buffer : nodes;
+
+    merge_nodes(from, from + middle, from + middle, from + count, to, pool, forks);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::merge_nodes(node** first1, node** last1, node** first2, node** last2, node** out, fork_join_pool* pool, size_t forks)
+{
+    auto less = [this](node* lhs, node* rhs) { return compare_keys(lhs->data.first, rhs->data.first); };
+    auto size1 = static_cast<size_t>(last1 - first1);
+    auto size2 = static_cast<size_t>(last2 - first2);
+
+    if (!pool || !forks || size1 + size2 < parallel_grain) {
+        std::merge(first1, last1, first2, last2, out, less);
+        return;
+    }
+
+    // The middle of the longer run splits both runs, equal keys stay on the side that keeps them stable
+    node** middle1;
+    node** middle2;
+
+    if (size1 >= size2) {
+        middle1 = first1 + size1 / 2;
+        middle2 = std::lower_bound(first2, last2, *middle1, less);
+    } else {
+        middle2 = first2 + size2 / 2;
+        middle1 = std::upper_bound(first1, last1, *middle2, less);
+    }
+
+    node** out_middle = out + (middle1 - first1) + (middle2 - first2);
+
+    fork(pool, forks,
+         [&] { merge_nodes(first1, middle1, first2, middle2, out, pool, forks - 1); },
+         [&] { merge_nodes(middle1, last1, middle2, last2, out_middle, pool, forks - 1); });
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::unique_nodes(node** nodes, size_t count, fork_join_pool* pool, size_t forks)
+{
+    if (!pool || !forks || count < parallel_grain) {
+        size_t unique = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            if (unique && !compare_keys(nodes[unique - 1]->data.first, nodes[i]->data.first)) {
+                __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &nodes[i]);
+            } else {
+                nodes[unique++] = nodes[i];
+            }
+        }
+
+        return unique;
+    }
+
+    // The right half starts after the run of keys equal to the last key of the left half
+    size_t middle = count / 2;
+    size_t right_start = middle;
+
+    for (; right_start < count && !compare_keys(nodes[middle - 1]->data.first, nodes[right_start]->data.first); ++right_start) {
+        __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &nodes[right_start]);
+    }
+
+    size_t left, right;
+
+    fork(pool, forks,
+         [&] { left = unique_nodes(nodes, middle, pool, forks - 1); },
+         [&] { right = unique_nodes(nodes + right_start, count - right_start, pool, forks - 1); });
+
+    std::copy(nodes + right_start, nodes + right_start + right, nodes + left);
+
+    return left + right;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::build_subtree(node** nodes, size_t count, fork_join_pool* pool, size_t forks)
+{
+    if (count == 0) {
+        return nullptr;
+    }
+
+    if (count < parallel_grain) {
+        forks = 0;
+    }
+
+    size_t middle = count / 2;
+    size_t next = forks ? forks - 1 : 0;
+    node* left;
+    node* right;
+
+    fork(pool, forks,
+         [&] { left = build_subtree(nodes, middle, pool, next); },
+         [&] { right = build_subtree(nodes + middle + 1, count - middle - 1, pool, next); });
+
+    return join_nodes(left, nodes[middle], right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::delete_subtree(node* n, fork_join_pool* pool, size_t forks)
+{
+    if (!pool || !forks || !n) {
+        return delete_subtree(n);
+    }
+
+    size_t left, right;
+
+    fork(pool, forks,
+         [&] { left = delete_subtree(n->left_subtree, pool, forks - 1); },
+         [&] { right = delete_subtree(n->right_subtree, pool, forks - 1); });
+
+    __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &n);
+
+    return left + right + 1;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::ranges::input_range R>
+void binary_search_tree<tkey, tvalue, compare, tag>::parallel_insert_range(fork_join_pool& pool, R&& rg)
+{
+    if constexpr (!std::ranges::random_access_range<R> || !std::ranges::sized_range<R>) {
+        std::vector<value_type, pp_allocator<value_type>> values(_allocator);
+
+        for (auto&& element: rg) {
+            values.emplace_back(std::forward<decltype(element)>(element));
+        }
+
+        parallel_insert_range(pool, std::move(values));
+    } else {
+        fork_join_pool* workers = node_workers(pool);
+        size_t forks = fork_depth(workers);
+        auto count = static_cast<size_t>(std::ranges::size(rg));
+
+        if (count == 0) {
+            return;
+        }
+
+        std::vector<node*, pp_allocator<node*>> nodes(count, nullptr, _allocator);
+        std::vector<node*, pp_allocator<node*>> buffer(count, nullptr, _allocator);
+
+        try {
+            if constexpr (std::is_lvalue_reference_v<R>) {
+                create_nodes(std::ranges::begin(rg), nodes.data(), count, workers, forks);
+            } else {
+                create_nodes(std::make_move_iterator(std::ranges::begin(rg)), nodes.data(), count, workers, forks);
+            }
+        } catch (...) {
+            for (node* n: nodes) {
+                __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &n);
+            }
+
+            throw;
+        }
+
+        sort_nodes(nodes.data(), buffer.data(), count, false, workers, forks);
+
+        size_t unique = unique_nodes(nodes.data(), count, workers, forks);
+        size_t duplicates = 0;
+        node* batch = build_subtree(nodes.data(), unique, workers, forks);
+
+        set_root(union_subtrees(_root, batch, duplicates, workers, forks));
+        _size += unique - duplicates;
+
+        if (_logger) {
+            _logger->log("Range inserted in parallel", logger::severity::debug);
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::erase_key_range(const tkey& lo, const tkey& hi, fork_join_pool* pool)
+{
+    if (!_root || compare_keys(hi, lo)) {
+        return 0;
+    }
+
+    node* lower;
+    node* rest;
+    node* middle;
+    node* upper;
+    node* first = split_subtree(_root, lo, lower, rest);
+    node* last = split_subtree(rest, hi, middle, upper);
+
+    size_t erased = delete_subtree(middle, pool, fork_depth(pool)) + (first ? 1 : 0) + (last ? 1 : 0);
+
+    __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &first);
+    __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, &last);
+
+    set_root(join_subtrees(lower, upper));
+    _size -= erased;
+
+    if (_logger) {
+        _logger->log("Key range erased", logger::severity::debug);
+    }
+
+    return erased;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename node_pointer, typename F>
+void binary_search_tree<tkey, tvalue, compare, tag>::visit_subtree(node_pointer n, F& function, fork_join_pool* pool, size_t forks)
+{
+    if (!n) {
+        return;
+    }
+
+    if (!pool || !forks) {
+        visit_subtree(static_cast<node_pointer>(n->left_subtree), function, nullptr, 0);
+        function(n->data);
+        visit_subtree(static_cast<node_pointer>(n->right_subtree), function, nullptr, 0);
+        return;
+    }
+
+    fork(pool, forks,
+         [&] {
+             visit_subtree(static_cast<node_pointer>(n->left_subtree), function, pool, forks - 1);
+             function(n->data);
+         },
+         [&] { visit_subtree(static_cast<node_pointer>(n->right_subtree), function, pool, forks - 1); });
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename T, typename Map, typename Reduce>
+T binary_search_tree<tkey, tvalue, compare, tag>::reduce_subtree(const node* n, Map& map, Reduce& reduce, const T& identity, fork_join_pool* pool, size_t forks)
+{
+    if (!n) {
+        return identity;
+    }
+
+    if (!pool || !forks) {
+        T left = reduce_subtree(n->left_subtree, map, reduce, identity, nullptr, 0);
+        return reduce(reduce(std::move(left), map(n->data)), reduce_subtree(n->right_subtree, map, reduce, identity, nullptr, 0));
+    }
+
+    std::optional<T> left, right;
+
+    fork(pool, forks,
+         [&] { left.emplace(reduce(reduce_subtree(n->left_subtree, map, reduce, identity, pool, forks - 1), map(n->data))); },
+         [&] { right.emplace(reduce_subtree(n->right_subtree, map, reduce, identity, pool, forks - 1)); });
+
+    return reduce(std::move(*left), std::move(*right));
+}
+
+// endregion parallel operations implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<class ...Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool>
+binary_search_tree<tkey, tvalue, compare, tag>::emplace(Args&&... args)
+{
+    value_type value(std::forward<Args>(args)...);
+    return insert(value);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_type& value)
+{
+    node* current = _root;
+    node* parent = nullptr;
+
+    while (current) {
+        parent = current;
+
+        if (compare_keys(value.first, current->data.first)) {
+            current = current->left_subtree;
+        } else if (compare_keys(current->data.first, value.first)) {
+            current = current->right_subtree;
+        } else {
+            current->data.second = value.second;
+            return infix_iterator(current);
+        }
+    }
+
+    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, value);
+
+    if (!parent) {
+        _root = new_node;
+    } else if (compare_keys(new_node->data.first, parent->data.first)) {
+        parent->left_subtree = new_node;
+    } else {
+        parent->right_subtree = new_node;
+    }
+
+    ++_size;
+
+    if (_logger) {
+        _logger->log("New node inserted or assigned", logger::severity::debug);
+    }
+
+    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
+
+    return infix_iterator(new_node);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& value)
+{
+    node* current = _root;
+    node* parent = nullptr;
 
     while (current) {
 
@@ -2642,6 +4175,106 @@ binary_search_tree<tkey, tvalue, compare, tag>::emplace_or_assign(Args&&... args
 
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::finger_start(node* finger, const tkey& key) const noexcept
+{
+    if (!finger) {
+        return _root;
+    }
+
+    bool left = compare_keys(key, finger->data.first);
+
+    if (!left && !compare_keys(finger->data.first, key)) {
+        return finger;
+    }
+
+    // Ancestors entered from the side of key are passed without comparing: key is beyond them anyway.
+    // The first one entered from the other side that is not beyond key bounds it, otherwise a descent
+    // from the root would leave the path at the topmost ancestor that was passed after comparing
+    node* start = finger;
+    node* current = finger;
+
+    while (current->parent) {
+        node* up = current->parent;
+
+        if (left ? up->right_subtree == current : up->left_subtree == current) {
+            if (left ? !compare_keys(key, up->data.first) : !compare_keys(up->data.first, key)) {
+                return up;
+            }
+
+            start = up;
+        }
+
+        current = up;
+    }
+
+    return start;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename value_ref>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert_from(node* finger, value_ref&& value)
+{
+    node* current = finger_start(finger, value.first);
+    node* parent = nullptr;
+
+    while (current) {
+        parent = current;
+        if (compare_keys(value.first, current->data.first)) {
+            current = current->left_subtree;
+        } else if (compare_keys(current->data.first, value.first)) {
+            current = current->right_subtree;
+        } else {
+            return infix_iterator(current);
+        }
+    }
+
+    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, std::forward<value_ref>(value));
+
+    if (!parent) {
+        _root = new_node;
+    } else if (compare_keys(new_node->data.first, parent->data.first)) {
+        parent->left_subtree = new_node;
+    } else {
+        parent->right_subtree = new_node;
+    }
+
+    ++_size;
+
+    if (_logger) {
+        _logger->log("New node inserted", logger::severity::debug);
+    }
+
+    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
+
+    return infix_iterator(new_node);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert(infix_const_iterator hint, const value_type& value)
+{
+    return insert_from(hint._base._data ? hint._base._data : hint._base._backup, value);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert(infix_const_iterator hint, value_type&& value)
+{
+    return insert_from(hint._base._data ? hint._base._data : hint._base._backup, std::move(value));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<class ...Args>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::emplace_hint(infix_const_iterator hint, Args&&... args)
+{
+    value_type value(std::forward<Args>(args)...);
+    return insert(hint, std::move(value));
+}
+
 // endregion binary_search_tree methods_insert and methods_emplace implementation
 
 // region binary_search_tree swap_method implementation
@@ -2657,6 +4290,10 @@ void binary_search_tree<tkey, tvalue, compare, tag>::swap(binary_search_tree& ot
     pp_allocator<value_type> this_alloc = _allocator;
     logger* this_logger = _logger;
 
+    std::swap(_size, other._size);
+    _pool.swap(other._pool);
+    std::swap(_order_statistics, other._order_statistics);
+
     try {
         _root = other._root;
         _allocator = other._allocator;
@@ -2688,26 +4325,32 @@ void binary_search_tree<tkey, tvalue, compare, tag>::swap(binary_search_tree& ot
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const tkey& key) const
 {
-    node* current = _root;
+    return find_node(key) != nullptr;
+}
 
-    while (current) {
-        if (compare_keys(key, current->data.first)) {
-            current = current->left_subtree;
-        } else if (compare_keys(current->data.first, key)) {
-            current = current->right_subtree;
-        } else {
-            return true;
-        }
-    }
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key)
+{
+    node* n = find_node(key);
+
+    return n ? infix_iterator(n) : end();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key) const
+{
+    const node* n = find_node(key);
 
-    return false;
+    return n ? infix_const_iterator(n) : cend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key)
+binary_search_tree<tkey, tvalue, compare, tag>::find_from(infix_const_iterator pos, const tkey& key)
 {
-    node* current = _root;
+    node* current = finger_start(pos._base._data ? pos._base._data : pos._base._backup, key);
 
     while (current) {
         if (compare_keys(key, current->data.first)) {
@@ -2724,9 +4367,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key)
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key) const
+binary_search_tree<tkey, tvalue, compare, tag>::find_from(infix_const_iterator pos, const tkey& key) const
 {
-    const node* current = _root;
+    const node* current = finger_start(pos._base._data ? pos._base._data : pos._base._backup, key);
 
     while (current) {
         if (compare_keys(key, current->data.first)) {
@@ -2744,44 +4387,115 @@ binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key) const
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key) {
-	node* current = _root;
-	node* result = nullptr;
-	while (current != nullptr) {
-		if (!compare::operator()(current->data.first, key)) {
-			result = current;
-			current = current->left_subtree;
-		} else {
-			current = current->right_subtree;
-		}
-	}
-
-	return infix_iterator(result);
+	return infix_iterator(lower_bound_node(key));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key) const {
-	node* current = _root;
-	node* result = nullptr;
-	while (current != nullptr) {
-		if (!compare::operator()(current->data.first, key)) {
-			result = current;
-			current = current->left_subtree;
-		} else {
-			current = current->right_subtree;
-		}
-	}
-
-	return infix_const_iterator(result);
+	return infix_const_iterator(lower_bound_node(key));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) {
+	return infix_iterator(upper_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) const {
+	return infix_const_iterator(upper_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const key_like& key) const
+{
+    return find_node(key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const key_like& key)
+{
+    node* n = find_node(key);
+
+    return n ? infix_iterator(n) : end();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const key_like& key) const
+{
+    const node* n = find_node(key);
+
+    return n ? infix_const_iterator(n) : cend();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const key_like& key)
+{
+    return infix_iterator(lower_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const key_like& key) const
+{
+    return infix_const_iterator(lower_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const key_like& key)
+{
+    return infix_iterator(upper_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const key_like& key) const
+{
+    return infix_const_iterator(upper_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::find_node(const key_like& key) const
+{
+    node* current = _root;
+
+    while (current) {
+        if (compare::operator()(key, current->data.first)) {
+            current = current->left_subtree;
+        } else if (compare::operator()(current->data.first, key)) {
+            current = current->right_subtree;
+        } else {
+            return current;
+        }
+    }
+
+    return nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound_node(const key_like& key) const
+{
 	node* current = _root;
 	node* result = nullptr;
 	while (current != nullptr) {
-		if (compare::operator()(key, current->data.first)) {
+		if (!compare::operator()(current->data.first, key)) {
 			result = current;
 			current = current->left_subtree;
 		} else {
@@ -2789,12 +4503,14 @@ binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) {
 		}
 	}
 
-	return infix_iterator(result);
+	return result;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) const {
+template<typename key_like>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound_node(const key_like& key) const
+{
 	node* current = _root;
 	node* result = nullptr;
 	while (current != nullptr) {
@@ -2806,7 +4522,7 @@ binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) con
 		}
 	}
 
-	return infix_const_iterator(result);
+	return result;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -3545,7 +5261,7 @@ namespace __detail {
 	typename binary_search_tree<tkey, tvalue, compare, tag>::node*
 	bst_impl<tkey, tvalue, compare, tag>::create_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, Args&&... args) {
 		using node_type = typename binary_search_tree<tkey, tvalue, compare, tag>::node;
-		auto* new_node = cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
+		auto* new_node = cont._pool.template new_object<node_type>(cont._allocator, std::forward<Args>(args)...);
 		return new_node;
 	}
 
@@ -3553,11 +5269,19 @@ namespace __detail {
 	void bst_impl<tkey, tvalue, compare, tag>::delete_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node** node) {
 		using node_type = typename binary_search_tree<tkey, tvalue, compare, tag>::node;
 		if (node && *node) {
-			cont._allocator.template delete_object<node_type>(*node);
+			cont._pool.delete_object(cont._allocator, static_cast<node_type*>(*node));
 			*node = nullptr;
 		}
 	}
 
+	template<typename tkey, typename tvalue, typename compare, typename tag>
+	typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+	bst_impl<tkey, tvalue, compare, tag>::clone_node(binary_search_tree<tkey, tvalue, compare, tag>& cont,
+													 const binary_search_tree<tkey, tvalue, compare, tag>::node* source,
+													 binary_search_tree<tkey, tvalue, compare, tag>::node* parent) {
+		return create_node(cont, parent, source->data);
+	}
+
 	template<typename tkey, typename tvalue, typename compare, typename tag>
 	void bst_impl<tkey, tvalue, compare, tag>::erase(binary_search_tree<tkey, tvalue, compare, tag>& cont, typename binary_search_tree<tkey, tvalue, compare, tag>::node** node_ptr) {
 		using node_type = typename binary_search_tree<tkey, tvalue, compare, tag>::node;
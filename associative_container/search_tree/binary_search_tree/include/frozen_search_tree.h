@@ -0,0 +1,526 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_FROZEN_SEARCH_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_FROZEN_SEARCH_TREE_H
+
+#include <search_tree.h>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** Immutable snapshot of a search tree for read-mostly lookups.
+ *  Pairs live in one array in Eytzinger (breadth-first) order: implicit node k has children 2k and 2k + 1,
+ *  so the top levels of every search share cache lines. Keys are copied once more into a dense array
+ *  of the same order, descents over it have no data-dependent branches
+ *  and prefetch the cache line of the node several levels below.
+ */
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
+class frozen_search_tree final : private compare
+{
+public:
+	using value_type = std::pair<tkey, tvalue>;
+
+	/** In-order walk over the implicit tree, amortized O(1) per step
+	 */
+	class const_iterator
+	{
+	public:
+		using value_type = frozen_search_tree::value_type;
+		using difference_type = ptrdiff_t;
+		using reference = const value_type&;
+		using pointer = const value_type*;
+		using iterator_category = std::bidirectional_iterator_tag;
+
+	private:
+		const value_type* _data;
+
+		// Implicit node, 0 for end
+		size_t _node;
+
+		size_t _size;
+
+	public:
+		explicit const_iterator(const value_type* data = nullptr, size_t node = 0, size_t size = 0) noexcept;
+
+		bool operator==(const const_iterator& other) const noexcept;
+
+		bool operator!=(const const_iterator& other) const noexcept;
+
+		const_iterator& operator++() & noexcept;
+
+		const_iterator operator++(int not_used) noexcept;
+
+		const_iterator& operator--() & noexcept;
+
+		const_iterator operator--(int not_used) noexcept;
+
+		reference operator*() const;
+
+		pointer operator->() const;
+	};
+
+private:
+	// Keys of one cache line, the prefetched node is that many levels deeper
+	static constexpr size_t keys_per_line = std::max<size_t>(64 / sizeof(tkey), 1);
+
+	// _data[k - 1] is the pair of implicit node k
+	std::vector<value_type> _data;
+
+	// _keys[k - 1] is the key of implicit node k
+	std::vector<tkey> _keys;
+
+public:
+	explicit frozen_search_tree(
+			const compare& comp = compare());
+
+	/** Replaces the contents with pairs sorted by key without duplicates, e.g. infix iterators of a tree.
+	 *  If the keys did not change only the values are overwritten in place.
+	 *  Returns whether the layout was rebuilt.
+	 *  Throws std::invalid_argument on unsorted input and leaves the snapshot empty
+	 */
+	template<typename iterator>
+	bool refresh(iterator first, iterator last);
+
+	bool empty() const noexcept;
+
+	size_t size() const noexcept;
+
+	compare key_comp() const;
+
+	const tvalue& at(const tkey& key) const;
+
+	bool contains(const tkey& key) const;
+
+	const_iterator find(const tkey& key) const;
+
+	const_iterator lower_bound(const tkey& key) const;
+
+	const_iterator upper_bound(const tkey& key) const;
+
+	const_iterator begin() const noexcept;
+
+	const_iterator end() const noexcept;
+
+	const_iterator cbegin() const noexcept;
+
+	const_iterator cend() const noexcept;
+
+private:
+	inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+	inline bool equivalent_keys(const tkey& lhs, const tkey& rhs) const;
+
+	void build_layout(std::vector<value_type>&& sorted);
+
+	// Node of the first key that is not less (upper: greater) than key, 0 if there is none
+	template<bool upper>
+	size_t search(const tkey& key) const;
+
+	static void prefetch(const tkey* address) noexcept;
+
+	static size_t first_node(size_t size) noexcept;
+
+	static size_t last_node(size_t size) noexcept;
+
+	static size_t next_node(size_t node, size_t size) noexcept;
+
+	static size_t previous_node(size_t node, size_t size) noexcept;
+};
+
+// region const_iterator implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+frozen_search_tree<tkey, tvalue, compare>::const_iterator::const_iterator(
+        const value_type* data,
+        size_t node,
+        size_t size) noexcept : _data(data), _node(node), _size(size) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator==(
+        const const_iterator& other) const noexcept
+{
+    return _node == other._node;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator!=(
+        const const_iterator& other) const noexcept
+{
+    return _node != other._node;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator&
+frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator++() & noexcept
+{
+    _node = next_node(_node, _size);
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator++(int not_used) noexcept
+{
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator&
+frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator--() & noexcept
+{
+    _node = _node == 0 ? last_node(_size) : previous_node(_node, _size);
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator--(int not_used) noexcept
+{
+    auto tmp = *this;
+    --*this;
+    return tmp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator::reference
+frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator*() const
+{
+    if (_node == 0)
+    {
+        throw std::out_of_range("Dereferencing end or invalid iterator");
+    }
+
+    return _data[_node - 1];
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator::pointer
+frozen_search_tree<tkey, tvalue, compare>::const_iterator::operator->() const
+{
+    return &**this;
+}
+
+// endregion const_iterator implementation
+
+// region implicit tree navigation implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t frozen_search_tree<tkey, tvalue, compare>::first_node(
+        size_t size) noexcept
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    size_t node = 1;
+
+    while (2 * node <= size)
+    {
+        node *= 2;
+    }
+
+    return node;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t frozen_search_tree<tkey, tvalue, compare>::last_node(
+        size_t size) noexcept
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    size_t node = 1;
+
+    while (2 * node + 1 <= size)
+    {
+        node = 2 * node + 1;
+    }
+
+    return node;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t frozen_search_tree<tkey, tvalue, compare>::next_node(
+        size_t node,
+        size_t size) noexcept
+{
+    if (2 * node + 1 <= size)
+    {
+        node = 2 * node + 1;
+
+        while (2 * node <= size)
+        {
+            node *= 2;
+        }
+
+        return node;
+    }
+
+    // Up past the right children, then once more past a left one
+    return node >> (std::countr_one(node) + 1);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t frozen_search_tree<tkey, tvalue, compare>::previous_node(
+        size_t node,
+        size_t size) noexcept
+{
+    if (2 * node <= size)
+    {
+        node *= 2;
+
+        while (2 * node + 1 <= size)
+        {
+            node = 2 * node + 1;
+        }
+
+        return node;
+    }
+
+    return node >> (std::countr_zero(node) + 1);
+}
+
+// endregion implicit tree navigation implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+frozen_search_tree<tkey, tvalue, compare>::frozen_search_tree(
+        const compare& comp) : compare(comp) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename iterator>
+bool frozen_search_tree<tkey, tvalue, compare>::refresh(
+        iterator first,
+        iterator last)
+{
+    size_t node = first_node(_data.size());
+
+    // Values of the same keys are written in place while the walk matches the input
+    for (; first != last && node != 0; ++first, node = next_node(node, _data.size()))
+    {
+        auto const &[key, value] = *first;
+
+        if (!equivalent_keys(_data[node - 1].first, key))
+        {
+            break;
+        }
+
+        _data[node - 1].second = value;
+    }
+
+    if (first == last && node == 0)
+    {
+        return false;
+    }
+
+    std::vector<value_type> sorted;
+    sorted.reserve(_data.size());
+
+    for (size_t matched = first_node(_data.size()); matched != node; matched = next_node(matched, _data.size()))
+    {
+        sorted.push_back(std::move(_data[matched - 1]));
+    }
+
+    for (; first != last; ++first)
+    {
+        auto const &[key, value] = *first;
+
+        if (!sorted.empty() && !compare_keys(sorted.back().first, key))
+        {
+            _data.clear();
+            _keys.clear();
+            throw std::invalid_argument("Frozen tree input must be sorted by key without duplicates");
+        }
+
+        sorted.emplace_back(key, value);
+    }
+
+    build_layout(std::move(sorted));
+
+    return true;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void frozen_search_tree<tkey, tvalue, compare>::build_layout(
+        std::vector<value_type>&& sorted)
+{
+    size_t n = sorted.size();
+
+    // In-order walk of the implicit tree hands out ranks in key order
+    std::vector<size_t> ranks(n);
+    size_t rank = 0;
+
+    for (size_t node = first_node(n); node != 0; node = next_node(node, n))
+    {
+        ranks[node - 1] = rank++;
+    }
+
+    _data.clear();
+    _keys.clear();
+    _data.reserve(n);
+    _keys.reserve(n);
+
+    for (size_t i : ranks)
+    {
+        _keys.push_back(sorted[i].first);
+        _data.push_back(std::move(sorted[i]));
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<bool upper>
+size_t frozen_search_tree<tkey, tvalue, compare>::search(
+        const tkey& key) const
+{
+    const tkey* keys = _keys.data();
+    size_t n = _keys.size();
+    size_t node = 1;
+
+    while (node <= n)
+    {
+        prefetch(keys + std::min(node * keys_per_line, n) - 1);
+
+        if constexpr (upper)
+        {
+            node = 2 * node + !compare_keys(key, keys[node - 1]);
+        }
+        else
+        {
+            node = 2 * node + compare_keys(keys[node - 1], key);
+        }
+    }
+
+    // Undo the right turns after the last left one, that node is the answer
+    return node >> (std::countr_one(node) + 1);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void frozen_search_tree<tkey, tvalue, compare>::prefetch(
+        const tkey* address) noexcept
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#endif
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool frozen_search_tree<tkey, tvalue, compare>::compare_keys(
+        const tkey& lhs,
+        const tkey& rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool frozen_search_tree<tkey, tvalue, compare>::equivalent_keys(
+        const tkey& lhs,
+        const tkey& rhs) const
+{
+    return !compare_keys(lhs, rhs) && !compare_keys(rhs, lhs);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool frozen_search_tree<tkey, tvalue, compare>::empty() const noexcept
+{
+    return _data.empty();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t frozen_search_tree<tkey, tvalue, compare>::size() const noexcept
+{
+    return _data.size();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+compare frozen_search_tree<tkey, tvalue, compare>::key_comp() const
+{
+    return static_cast<const compare&>(*this);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+const tvalue& frozen_search_tree<tkey, tvalue, compare>::at(
+        const tkey& key) const
+{
+    auto it = find(key);
+
+    if (it == end())
+    {
+        throw std::out_of_range("Key not found");
+    }
+
+    return it->second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool frozen_search_tree<tkey, tvalue, compare>::contains(
+        const tkey& key) const
+{
+    return find(key) != end();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::find(
+        const tkey& key) const
+{
+    size_t node = search<false>(key);
+
+    if (node == 0 || compare_keys(key, _keys[node - 1]))
+    {
+        return end();
+    }
+
+    return const_iterator(_data.data(), node, _data.size());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::lower_bound(
+        const tkey& key) const
+{
+    return const_iterator(_data.data(), search<false>(key), _data.size());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::upper_bound(
+        const tkey& key) const
+{
+    return const_iterator(_data.data(), search<true>(key), _data.size());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::begin() const noexcept
+{
+    return const_iterator(_data.data(), first_node(_data.size()), _data.size());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::end() const noexcept
+{
+    return const_iterator(_data.data(), 0, _data.size());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename frozen_search_tree<tkey, tvalue, compare>::const_iterator
+frozen_search_tree<tkey, tvalue, compare>::cend() const noexcept
+{
+    return end();
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_FROZEN_SEARCH_TREE_H
@@ -0,0 +1,1205 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_RED_BLACK_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_RED_BLACK_TREE_H
+
+#include <logger.h>
+#include <pp_allocator.h>
+#include <search_tree.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/** Red-black tree for many readers and rare writers.
+ *  Published nodes are never changed: a write copies the nodes it would change (split and join by key,
+ *  as in red_black_tree::join) and publishes the new root with one atomic store, so readers take no locks
+ *  and always see one whole version. Writers are serialized by a mutex.
+ *  Replaced nodes are freed by epochs: a reader announces the epoch it started in,
+ *  a batch retired in epoch e is freed once no reader announced e or earlier.
+ *  Announcements take slots from blocks of reader_slots, a new block is linked when all are taken,
+ *  so any number of snapshots may live at once. Blocks are kept until the tree is destroyed.
+ */
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
+class concurrent_red_black_tree final : private compare
+{
+public:
+
+    using value_type = std::pair<const tkey, tvalue>;
+
+private:
+
+    struct node final
+    {
+        value_type data;
+
+        node* left_subtree = nullptr;
+
+        node* right_subtree = nullptr;
+
+        // Write that created the node, nodes of the running write are changed in place
+        uint64_t version;
+
+        bool is_red = true;
+
+        // Black nodes on a path down from this one, itself included
+        uint8_t black_height = 0;
+
+        template<class ...Args>
+        explicit node(uint64_t version, Args&& ...args);
+
+        node(uint64_t version, const node& source);
+    };
+
+    // Red-black height is at most 2 * log2(n + 1)
+    static constexpr size_t max_height = 2 * std::numeric_limits<size_t>::digits;
+
+    static constexpr size_t reader_slots = 128;
+
+    struct alignas(64) reader_slot final
+    {
+        // 0 for a free slot
+        std::atomic<uint64_t> epoch = 0;
+    };
+
+    struct reader_block final
+    {
+        std::array<reader_slot, reader_slots> slots;
+
+        // Linked once, when every slot of this block was taken
+        std::atomic<reader_block*> next = nullptr;
+    };
+
+    struct retired_batch final
+    {
+        uint64_t epoch;
+
+        std::vector<node*> nodes;
+    };
+
+public:
+
+    /** In-order walk keeping the pending ancestors on a fixed stack, valid while its snapshot lives
+     */
+    class const_iterator
+    {
+    public:
+        using value_type = concurrent_red_black_tree::value_type;
+        using difference_type = ptrdiff_t;
+        using reference = const value_type&;
+        using pointer = const value_type*;
+        using iterator_category = std::forward_iterator_tag;
+
+    private:
+        friend class concurrent_red_black_tree;
+
+        // Current node on top, below it the ancestors whose left subtree holds it
+        std::array<const node*, max_height> _path;
+
+        // 0 for end
+        size_t _depth = 0;
+
+        void push_left_path(const node* n) noexcept;
+
+    public:
+        const_iterator() noexcept = default;
+
+        bool operator==(const const_iterator& other) const noexcept;
+
+        bool operator!=(const const_iterator& other) const noexcept;
+
+        const_iterator& operator++() & noexcept;
+
+        const_iterator operator++(int not_used) noexcept;
+
+        reference operator*() const;
+
+        pointer operator->() const;
+    };
+
+    /** Consistent read-only view of one version. Keeps its epoch announced until destroyed,
+     *  so a long-lived snapshot delays freeing of the nodes replaced after it was taken
+     */
+    class snapshot final
+    {
+        friend class concurrent_red_black_tree;
+
+        const concurrent_red_black_tree* _tree;
+
+        reader_slot* _slot;
+
+        const node* _root;
+
+        explicit snapshot(const concurrent_red_black_tree& tree);
+
+    public:
+        snapshot(snapshot const &other) = delete;
+
+        snapshot &operator=(snapshot const &other) = delete;
+
+        snapshot(snapshot &&other) noexcept;
+
+        snapshot &operator=(snapshot &&other) = delete;
+
+        ~snapshot() noexcept;
+
+        bool empty() const noexcept;
+
+        bool contains(const tkey& key) const;
+
+        const tvalue& at(const tkey& key) const;
+
+        const_iterator find(const tkey& key) const;
+
+        const_iterator lower_bound(const tkey& key) const;
+
+        const_iterator upper_bound(const tkey& key) const;
+
+        const_iterator begin() const noexcept;
+
+        const_iterator end() const noexcept;
+
+        const_iterator cbegin() const noexcept;
+
+        const_iterator cend() const noexcept;
+
+    private:
+        template<bool upper>
+        const_iterator search(const tkey& key) const;
+    };
+
+private:
+
+    std::atomic<node*> _root = nullptr;
+
+    std::atomic<size_t> _size = 0;
+
+    std::atomic<uint64_t> _epoch = 1;
+
+    // First block of the chain
+    std::unique_ptr<reader_block> _readers;
+
+    // region writer state, guarded by _writer
+
+    std::mutex _writer;
+
+    uint64_t _version = 0;
+
+    // Nodes of the running write, freed if it throws
+    std::vector<node*> _created;
+
+    // Published nodes the running write replaced
+    std::vector<node*> _retiring;
+
+    std::deque<retired_batch> _retired;
+
+    pp_allocator<value_type> _allocator;
+
+    // endregion writer state, guarded by _writer
+
+    logger* _logger;
+
+public:
+
+    explicit concurrent_red_black_tree(
+            const compare& comp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger *log = nullptr);
+
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    explicit concurrent_red_black_tree(iterator begin, iterator end, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* log = nullptr);
+
+    concurrent_red_black_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* log = nullptr);
+
+    concurrent_red_black_tree(concurrent_red_black_tree const &other) = delete;
+
+    concurrent_red_black_tree &operator=(concurrent_red_black_tree const &other) = delete;
+
+    // No snapshot may outlive the tree
+    ~concurrent_red_black_tree() noexcept;
+
+public:
+
+    // region readers, safe from any thread at any time
+
+    snapshot read() const;
+
+    bool contains(const tkey& key) const;
+
+    // Copy of the value, empty if the key is absent
+    std::optional<tvalue> lookup(const tkey& key) const;
+
+    // Size of the latest version
+    size_t size() const noexcept;
+
+    bool empty() const noexcept;
+
+    compare key_comp() const;
+
+    // endregion readers, safe from any thread at any time
+
+    // region writers, serialized with each other
+
+    // Returns whether the key was absent
+    bool insert(const value_type& value);
+
+    template<class ...Args>
+    bool emplace(Args&& ...args);
+
+    // Returns whether the key was absent
+    bool insert_or_assign(const value_type& value);
+
+    // Returns whether the key was present
+    bool erase(const tkey& key);
+
+    void clear();
+
+    // endregion writers, serialized with each other
+
+private:
+
+    inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+    reader_slot& announce() const;
+
+    static const node* descend(const concurrent_red_black_tree& tree, const node* n, const tkey& key);
+
+    template<class ...Args>
+    node* create_node(Args&& ...args);
+
+    void delete_node(node* n) noexcept;
+
+    // Node that may be changed by the running write, published nodes are copied and retired
+    node* mutable_node(node* n);
+
+    node* with_color(node* n, bool red);
+
+    // Makes new_root the published version and frees what no reader can reach anymore
+    void publish(node* new_root, ptrdiff_t size_change);
+
+    void roll_back() noexcept;
+
+    void reclaim() noexcept;
+
+    void delete_subtree(node* n) noexcept;
+
+    static bool is_red(const node* n) noexcept;
+
+    static size_t black_height(const node* n) noexcept;
+
+    static void update_black_height(node* n) noexcept;
+
+    static void rotate_left(node*& n) noexcept;
+
+    static void rotate_right(node*& n) noexcept;
+
+    static node* link(node* left, node* middle, node* right) noexcept;
+
+    node* join(node* left, node* middle, node* right);
+
+    node* join_right(node* left, size_t left_black_height, node* middle, node* right, size_t right_black_height);
+
+    node* join_left(node* left, size_t left_black_height, node* middle, node* right, size_t right_black_height);
+
+    // Keys less than key, the node of key or nullptr, keys greater than key
+    std::tuple<node*, node*, node*> split(node* n, const tkey& key);
+
+    // Rest of the subtree and its maximum, detached and changeable
+    std::pair<node*, node*> split_last(node* n);
+
+    node* join(node* left, node* right);
+};
+
+// region node implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+concurrent_red_black_tree<tkey, tvalue, compare>::node::node(
+        uint64_t version,
+        Args&& ...args) : data(std::forward<Args>(args)...), version(version) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_red_black_tree<tkey, tvalue, compare>::node::node(
+        uint64_t version,
+        const node& source) : data(source.data), left_subtree(source.left_subtree), right_subtree(source.right_subtree),
+                              version(version), is_red(source.is_red), black_height(source.black_height) {}
+
+// endregion node implementation
+
+// region const_iterator implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::push_left_path(const node* n) noexcept
+{
+    while (n)
+    {
+        _path[_depth++] = n;
+        n = n->left_subtree;
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::operator==(const const_iterator& other) const noexcept
+{
+    return _depth == other._depth && (_depth == 0 || _path[_depth - 1] == other._path[_depth - 1]);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::operator!=(const const_iterator& other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator&
+concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::operator++() & noexcept
+{
+    if (_depth)
+    {
+        const node* current = _path[--_depth];
+        push_left_path(current->right_subtree);
+    }
+
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::operator++(int not_used) noexcept
+{
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::reference
+concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::operator*() const
+{
+    if (!_depth)
+    {
+        throw std::logic_error("Dereferencing end iterator");
+    }
+
+    return _path[_depth - 1]->data;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::pointer
+concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator::operator->() const
+{
+    return &**this;
+}
+
+// endregion const_iterator implementation
+
+// region snapshot implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::snapshot(const concurrent_red_black_tree& tree)
+    : _tree(&tree), _slot(&tree.announce()), _root(tree._root.load(std::memory_order_seq_cst)) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::snapshot(snapshot &&other) noexcept
+    : _tree(other._tree), _slot(std::exchange(other._slot, nullptr)), _root(other._root) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::~snapshot() noexcept
+{
+    if (_slot)
+    {
+        _slot->epoch.store(0, std::memory_order_release);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::empty() const noexcept
+{
+    return !_root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::contains(const tkey& key) const
+{
+    return descend(*_tree, _root, key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+const tvalue& concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::at(const tkey& key) const
+{
+    const node* found = descend(*_tree, _root, key);
+
+    if (!found)
+    {
+        throw std::out_of_range("Key not found");
+    }
+
+    return found->data.second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::find(const tkey& key) const
+{
+    auto it = lower_bound(key);
+
+    return it == end() || _tree->compare_keys(key, it->first) ? end() : it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::lower_bound(const tkey& key) const
+{
+    return search<false>(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::upper_bound(const tkey& key) const
+{
+    return search<true>(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<bool upper>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::search(const tkey& key) const
+{
+    const_iterator result;
+    const node* current = _root;
+
+    // Nodes where the search turned left stay on the path, the last one is the bound
+    while (current)
+    {
+        bool go_left = upper ? _tree->compare_keys(key, current->data.first) : !_tree->compare_keys(current->data.first, key);
+
+        if (go_left)
+        {
+            result._path[result._depth++] = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::begin() const noexcept
+{
+    const_iterator result;
+    result.push_left_path(_root);
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::end() const noexcept
+{
+    return const_iterator();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::const_iterator
+concurrent_red_black_tree<tkey, tvalue, compare>::snapshot::cend() const noexcept
+{
+    return end();
+}
+
+// endregion snapshot implementation
+
+// region construction implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_red_black_tree<tkey, tvalue, compare>::concurrent_red_black_tree(
+        const compare& comp,
+        pp_allocator<value_type> alloc,
+        logger *log) : compare(comp), _readers(std::make_unique<reader_block>()), _allocator(alloc), _logger(log) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+concurrent_red_black_tree<tkey, tvalue, compare>::concurrent_red_black_tree(
+        iterator begin,
+        iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* log) : concurrent_red_black_tree(cmp, alloc, log)
+{
+    for (; begin != end; ++begin)
+    {
+        emplace(*begin);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_red_black_tree<tkey, tvalue, compare>::concurrent_red_black_tree(
+        std::initializer_list<std::pair<tkey, tvalue>> data,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* log) : concurrent_red_black_tree(data.begin(), data.end(), cmp, alloc, log) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_red_black_tree<tkey, tvalue, compare>::~concurrent_red_black_tree() noexcept
+{
+    delete_subtree(_root.load(std::memory_order_relaxed));
+
+    for (auto& batch : _retired)
+    {
+        for (node* n : batch.nodes)
+        {
+            delete_node(n);
+        }
+    }
+
+    for (reader_block* block = _readers->next.load(std::memory_order_relaxed); block != nullptr; )
+    {
+        delete std::exchange(block, block->next.load(std::memory_order_relaxed));
+    }
+}
+
+// endregion construction implementation
+
+// region readers implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::snapshot concurrent_red_black_tree<tkey, tvalue, compare>::read() const
+{
+    return snapshot(*this);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::contains(const tkey& key) const
+{
+    return read().contains(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+std::optional<tvalue> concurrent_red_black_tree<tkey, tvalue, compare>::lookup(const tkey& key) const
+{
+    snapshot view(*this);
+    const node* found = descend(*this, view._root, key);
+
+    return found ? std::optional<tvalue>(found->data.second) : std::nullopt;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t concurrent_red_black_tree<tkey, tvalue, compare>::size() const noexcept
+{
+    return _size.load(std::memory_order_acquire);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+compare concurrent_red_black_tree<tkey, tvalue, compare>::key_comp() const
+{
+    return static_cast<const compare&>(*this);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::compare_keys(const tkey& lhs, const tkey& rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::reader_slot& concurrent_red_black_tree<tkey, tvalue, compare>::announce() const
+{
+    // Threads start probing at different slots and remember the last free one
+    thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+    for (reader_block* block = _readers.get();;)
+    {
+        for (size_t probe = 0; probe < reader_slots; ++probe)
+        {
+            reader_slot& slot = block->slots[(hint + probe) % reader_slots];
+            uint64_t free = 0;
+
+            // The epoch is announced before the root is loaded, a writer that misses the announcement
+            // has published its root before, so the reader never sees the nodes that writer frees
+            if (slot.epoch.load(std::memory_order_relaxed) == 0
+                && slot.epoch.compare_exchange_strong(free, _epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst))
+            {
+                hint = (hint + probe) % reader_slots;
+                return slot;
+            }
+        }
+
+        // Every slot is taken, the reader links a new block instead of waiting for one to be freed.
+        // The link is seq_cst as well, a writer that misses it misses the announcements made in the block
+        reader_block* next = block->next.load(std::memory_order_seq_cst);
+
+        if (next == nullptr)
+        {
+            auto fresh = std::make_unique<reader_block>();
+
+            if (block->next.compare_exchange_strong(next, fresh.get(), std::memory_order_seq_cst))
+            {
+                next = fresh.release();
+            }
+        }
+
+        block = next;
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+const typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::descend(
+        const concurrent_red_black_tree& tree,
+        const node* n,
+        const tkey& key)
+{
+    while (n)
+    {
+        if (tree.compare_keys(key, n->data.first))
+        {
+            n = n->left_subtree;
+        }
+        else if (tree.compare_keys(n->data.first, key))
+        {
+            n = n->right_subtree;
+        }
+        else
+        {
+            return n;
+        }
+    }
+
+    return nullptr;
+}
+
+// endregion readers implementation
+
+// region writers implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::insert(const value_type& value)
+{
+    return emplace(value);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::emplace(Args&& ...args)
+{
+    std::lock_guard lock(_writer);
+    ++_version;
+
+    try
+    {
+        node* fresh = create_node(std::forward<Args>(args)...);
+        node* root = _root.load(std::memory_order_relaxed);
+
+        if (descend(*this, root, fresh->data.first))
+        {
+            roll_back();
+            return false;
+        }
+
+        auto [left, found, right] = split(root, fresh->data.first);
+        publish(join(left, fresh, right), 1);
+    }
+    catch (...)
+    {
+        roll_back();
+        throw;
+    }
+
+    if (_logger)
+    {
+        _logger->log("New node inserted", logger::severity::debug);
+    }
+
+    return true;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& value)
+{
+    std::lock_guard lock(_writer);
+    ++_version;
+
+    bool inserted;
+
+    try
+    {
+        node* fresh = create_node(value);
+        auto [left, found, right] = split(_root.load(std::memory_order_relaxed), value.first);
+
+        inserted = !found;
+
+        if (found)
+        {
+            _retiring.push_back(found);
+        }
+
+        publish(join(left, fresh, right), inserted ? 1 : 0);
+    }
+    catch (...)
+    {
+        roll_back();
+        throw;
+    }
+
+    if (inserted && _logger)
+    {
+        _logger->log("New node inserted", logger::severity::debug);
+    }
+
+    return inserted;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::erase(const tkey& key)
+{
+    std::lock_guard lock(_writer);
+    node* root = _root.load(std::memory_order_relaxed);
+
+    if (!descend(*this, root, key))
+    {
+        return false;
+    }
+
+    ++_version;
+
+    try
+    {
+        auto [left, found, right] = split(root, key);
+
+        _retiring.push_back(found);
+        publish(join(left, right), -1);
+    }
+    catch (...)
+    {
+        roll_back();
+        throw;
+    }
+
+    return true;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::clear()
+{
+    std::lock_guard lock(_writer);
+    node* root = _root.load(std::memory_order_relaxed);
+
+    if (!root)
+    {
+        return;
+    }
+
+    ++_version;
+
+    // Every published node is retired, one pass over the old version
+    try
+    {
+        std::vector<node*> pending{root};
+        _retiring.reserve(_size.load(std::memory_order_relaxed));
+
+        while (!pending.empty())
+        {
+            node* n = pending.back();
+            pending.pop_back();
+            _retiring.push_back(n);
+
+            if (n->left_subtree)
+            {
+                pending.push_back(n->left_subtree);
+            }
+
+            if (n->right_subtree)
+            {
+                pending.push_back(n->right_subtree);
+            }
+        }
+    }
+    catch (...)
+    {
+        roll_back();
+        throw;
+    }
+
+    publish(nullptr, -static_cast<ptrdiff_t>(_size.load(std::memory_order_relaxed)));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::create_node(Args&& ...args)
+{
+    _created.reserve(_created.size() + 1);
+
+    node* n = _allocator.template new_object<node>(_version, std::forward<Args>(args)...);
+    _created.push_back(n);
+
+    return n;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::delete_node(node* n) noexcept
+{
+    _allocator.delete_object(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::mutable_node(node* n)
+{
+    if (n->version == _version)
+    {
+        return n;
+    }
+
+    _retiring.reserve(_retiring.size() + 1);
+
+    node* copy = create_node(static_cast<const node&>(*n));
+    _retiring.push_back(n);
+
+    return copy;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::with_color(node* n, bool red)
+{
+    if (!n || n->is_red == red)
+    {
+        return n;
+    }
+
+    n = mutable_node(n);
+    n->is_red = red;
+    update_black_height(n);
+
+    return n;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::publish(node* new_root, ptrdiff_t size_change)
+{
+    new_root = with_color(new_root, false);
+
+    _root.store(new_root, std::memory_order_seq_cst);
+    _size.fetch_add(static_cast<size_t>(size_change), std::memory_order_release);
+    _created.clear();
+
+    if (_retiring.empty())
+    {
+        return;
+    }
+
+    // Readers announced in this epoch may still hold the old root
+    _retired.push_back(retired_batch{_epoch.load(std::memory_order_relaxed), std::move(_retiring)});
+    _retiring.clear();
+    _epoch.fetch_add(1, std::memory_order_seq_cst);
+
+    reclaim();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::roll_back() noexcept
+{
+    // The published version is untouched, only the new nodes go
+    for (node* n : _created)
+    {
+        delete_node(n);
+    }
+
+    _created.clear();
+    _retiring.clear();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::reclaim() noexcept
+{
+    uint64_t oldest = _epoch.load(std::memory_order_relaxed);
+
+    for (const reader_block* block = _readers.get(); block != nullptr; block = block->next.load(std::memory_order_seq_cst))
+    {
+        for (auto& slot : block->slots)
+        {
+            uint64_t announced = slot.epoch.load(std::memory_order_seq_cst);
+
+            if (announced && announced < oldest)
+            {
+                oldest = announced;
+            }
+        }
+    }
+
+    while (!_retired.empty() && _retired.front().epoch < oldest)
+    {
+        for (node* n : _retired.front().nodes)
+        {
+            delete_node(n);
+        }
+
+        _retired.pop_front();
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::delete_subtree(node* n) noexcept
+{
+    // Rotating left children up flattens the subtree without a stack
+    while (n)
+    {
+        if (n->left_subtree)
+        {
+            node* left = n->left_subtree;
+            n->left_subtree = left->right_subtree;
+            left->right_subtree = n;
+            n = left;
+        }
+        else
+        {
+            node* right = n->right_subtree;
+            delete_node(n);
+            n = right;
+        }
+    }
+}
+
+// endregion writers implementation
+
+// region join-based path copying implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_red_black_tree<tkey, tvalue, compare>::is_red(const node* n) noexcept
+{
+    return n && n->is_red;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t concurrent_red_black_tree<tkey, tvalue, compare>::black_height(const node* n) noexcept
+{
+    return n ? n->black_height : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::update_black_height(node* n) noexcept
+{
+    n->black_height = static_cast<uint8_t>(black_height(n->left_subtree) + (n->is_red ? 0 : 1));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::rotate_left(node*& n) noexcept
+{
+    node* right = n->right_subtree;
+    n->right_subtree = right->left_subtree;
+    right->left_subtree = n;
+    update_black_height(n);
+    update_black_height(right);
+    n = right;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_red_black_tree<tkey, tvalue, compare>::rotate_right(node*& n) noexcept
+{
+    node* left = n->left_subtree;
+    n->left_subtree = left->right_subtree;
+    left->right_subtree = n;
+    update_black_height(n);
+    update_black_height(left);
+    n = left;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::link(
+        node* left,
+        node* middle,
+        node* right) noexcept
+{
+    middle->left_subtree = left;
+    middle->right_subtree = right;
+    update_black_height(middle);
+    return middle;
+}
+
+// middle is always changeable, left and right may be published subtrees
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::join(
+        node* left,
+        node* middle,
+        node* right)
+{
+    left = with_color(left, false);
+    right = with_color(right, false);
+
+    size_t left_black_height = black_height(left);
+    size_t right_black_height = black_height(right);
+
+    if (left_black_height > right_black_height)
+    {
+        node* joined = join_right(left, left_black_height, middle, right, right_black_height);
+
+        if (is_red(joined) && is_red(joined->right_subtree))
+        {
+            joined->is_red = false;
+            update_black_height(joined);
+        }
+
+        return joined;
+    }
+
+    if (right_black_height > left_black_height)
+    {
+        node* joined = join_left(left, left_black_height, middle, right, right_black_height);
+
+        if (is_red(joined) && is_red(joined->left_subtree))
+        {
+            joined->is_red = false;
+            update_black_height(joined);
+        }
+
+        return joined;
+    }
+
+    middle->is_red = true;
+    return link(left, middle, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::join_right(
+        node* left, size_t left_black_height,
+        node* middle,
+        node* right, size_t right_black_height)
+{
+    if (!is_red(left) && left_black_height == right_black_height)
+    {
+        middle->is_red = true;
+        return link(left, middle, right);
+    }
+
+    // Nodes along the right spine of left change, the rest of it is shared
+    node* joined = join_right(left->right_subtree, left_black_height - (is_red(left) ? 0 : 1),
+                              middle, right, right_black_height);
+
+    left = mutable_node(left);
+    left->right_subtree = joined;
+
+    // Red middle node under a red parent: rotate the black grandparent down
+    if (!is_red(left) && is_red(joined) && is_red(joined->right_subtree))
+    {
+        joined->right_subtree = with_color(joined->right_subtree, false);
+        rotate_left(left);
+    }
+
+    return left;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::join_left(
+        node* left, size_t left_black_height,
+        node* middle,
+        node* right, size_t right_black_height)
+{
+    if (!is_red(right) && left_black_height == right_black_height)
+    {
+        middle->is_red = true;
+        return link(left, middle, right);
+    }
+
+    node* joined = join_left(left, left_black_height, middle,
+                             right->left_subtree, right_black_height - (is_red(right) ? 0 : 1));
+
+    right = mutable_node(right);
+    right->left_subtree = joined;
+
+    if (!is_red(right) && is_red(joined) && is_red(joined->left_subtree))
+    {
+        joined->left_subtree = with_color(joined->left_subtree, false);
+        rotate_right(right);
+    }
+
+    return right;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+std::tuple<typename concurrent_red_black_tree<tkey, tvalue, compare>::node*,
+           typename concurrent_red_black_tree<tkey, tvalue, compare>::node*,
+           typename concurrent_red_black_tree<tkey, tvalue, compare>::node*>
+concurrent_red_black_tree<tkey, tvalue, compare>::split(node* n, const tkey& key)
+{
+    if (!n)
+    {
+        return {nullptr, nullptr, nullptr};
+    }
+
+    if (compare_keys(key, n->data.first))
+    {
+        auto [left, found, right] = split(n->left_subtree, key);
+        return {left, found, join(right, mutable_node(n), n->right_subtree)};
+    }
+
+    if (compare_keys(n->data.first, key))
+    {
+        auto [left, found, right] = split(n->right_subtree, key);
+        return {join(n->left_subtree, mutable_node(n), left), found, right};
+    }
+
+    return {n->left_subtree, n, n->right_subtree};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+std::pair<typename concurrent_red_black_tree<tkey, tvalue, compare>::node*,
+          typename concurrent_red_black_tree<tkey, tvalue, compare>::node*>
+concurrent_red_black_tree<tkey, tvalue, compare>::split_last(node* n)
+{
+    if (!n->right_subtree)
+    {
+        node* left = n->left_subtree;
+        return {left, mutable_node(n)};
+    }
+
+    auto [rest, last] = split_last(n->right_subtree);
+    node* left = n->left_subtree;
+
+    return {join(left, mutable_node(n), rest), last};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_red_black_tree<tkey, tvalue, compare>::node* concurrent_red_black_tree<tkey, tvalue, compare>::join(
+        node* left,
+        node* right)
+{
+    if (!left)
+    {
+        return right;
+    }
+
+    auto [rest, last] = split_last(left);
+    return join(rest, last, right);
+}
+
+// endregion join-based path copying implementation
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_RED_BLACK_TREE_H
@@ -10,10 +10,18 @@ namespace __detail
     template<typename tkey, typename tvalue, typename compare>
     class bst_impl<tkey, tvalue, compare, RB_TAG>
     {
+        friend class binary_search_tree<tkey, tvalue, compare, RB_TAG>;
+
         template<class ...Args>
         static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont);
+        // Only calls destructor and frees memory
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** node);
+
+        // Copies color and size along with the data
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* clone_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+                                                                                   const binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* source,
+                                                                                   binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* parent);
 
         //Does not invalidate node*, needed for splay tree
         static void post_search(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**){}
@@ -21,9 +29,54 @@ namespace __detail
         //Does not invalidate node*
         static void post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
 
+        // Colors a perfectly balanced tree: only the incomplete bottom level is red
+        static void post_build(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont);
+
+        static void paint_levels(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n, size_t depth, size_t red_depth) noexcept;
+
+        // 0 for nullptr and for every node while order statistics are off
+        static size_t subtree_size(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept;
+
+        static void recalculate_size(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept;
+
+        /** Links left, middle and right into one red-black subtree, its root may stay red.
+         *  Black heights are counted along the left spines, O(log n)
+         */
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* join(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right);
+
+        // left has the bigger black height, descends along its right spine
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* join_right(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left, size_t left_black_height,
+                                     binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right, size_t right_black_height) noexcept;
+
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* join_left(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left, size_t left_black_height,
+                                    binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right, size_t right_black_height) noexcept;
+
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* link(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right) noexcept;
+
+        // Black nodes on a path from n down to a leaf, n included
+        static size_t black_height(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept;
+
+        // The root of a red-black tree is black
+        static void post_join(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont) noexcept;
+
         static void erase(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, RB_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, RB_TAG>& rhs) noexcept;
+
+        // nullptr leaves are black
+        static bool is_red(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept;
+
+        static void set_color(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n, bool red) noexcept;
+
+        // Rotations keep subtree sizes
+        static void rotate_left(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept;
+
+        static void rotate_right(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept;
+
+        // Restores black height after a black node was unlinked above x (x may be nullptr, so its parent is passed)
+        static void erase_fixup(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+                                binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* x,
+                                binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* parent) noexcept;
     };
 }
 
@@ -42,16 +95,24 @@ public:
 private:
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG>;
     
     struct node final:
         parent::node
     {
         node_color color;
 
+        /** Nodes in this subtree while order statistics are on, otherwise 0.
+         *  Fits into the padding after color
+         */
+        unsigned int size;
+
+        void recalculate_size() noexcept;
+
         template<class ...Args>
         node(parent::node* par, Args&&... args);
 
-        ~node() noexcept override =default;
+        ~node() noexcept =default;
     };
 
 
@@ -84,6 +145,13 @@ public:
             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
             logger* log = nullptr);
 
+    /** Builds the tree from input sorted by key without duplicates in O(n)
+     */
+    template<std::input_iterator iterator>
+    red_black_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* log = nullptr);
+
 
     // region iterator definition
 
@@ -209,6 +277,16 @@ public:
 
         node_color get_color() const noexcept;
 
+        /** O(log n) with order statistics on, otherwise steps one by one
+         */
+        infix_iterator& operator+=(difference_type offset) & noexcept;
+        infix_iterator& operator-=(difference_type offset) & noexcept;
+
+        infix_iterator operator+(difference_type offset) const noexcept;
+        infix_iterator operator-(difference_type offset) const noexcept;
+
+        difference_type operator-(const infix_iterator& other) const noexcept;
+
         using parent::infix_iterator::depth;
         using parent::infix_iterator::operator*;
         using parent::infix_iterator::operator==;
@@ -218,7 +296,7 @@ public:
         using parent::infix_iterator::operator->;
     };
 
-    class infix_const_iterator : parent::infix_const_iterator
+    class infix_const_iterator : public parent::infix_const_iterator
     {
     public:
 
@@ -235,6 +313,16 @@ public:
 
         infix_const_iterator(infix_iterator) noexcept;
 
+        /** O(log n) with order statistics on, otherwise steps one by one
+         */
+        infix_const_iterator& operator+=(difference_type offset) & noexcept;
+        infix_const_iterator& operator-=(difference_type offset) & noexcept;
+
+        infix_const_iterator operator+(difference_type offset) const noexcept;
+        infix_const_iterator operator-(difference_type offset) const noexcept;
+
+        difference_type operator-(const infix_const_iterator& other) const noexcept;
+
         using parent::infix_const_iterator::depth;
         using parent::infix_const_iterator::operator*;
         using parent::infix_const_iterator::operator==;
@@ -544,24 +632,126 @@ public:
     template<class ...Args>
     infix_iterator emplace_or_assign(Args&&...args);
 
+    infix_iterator insert(parent::infix_const_iterator hint, const value_type&);
+    infix_iterator insert(parent::infix_const_iterator hint, value_type&&);
+
+    template<class ...Args>
+    infix_iterator emplace_hint(parent::infix_const_iterator hint, Args&&...args);
+
     infix_iterator find(const tkey&);
     infix_const_iterator find(const tkey&) const;
 
+    infix_iterator find_from(parent::infix_const_iterator pos, const tkey&);
+    infix_const_iterator find_from(parent::infix_const_iterator pos, const tkey&) const;
+
     infix_iterator lower_bound(const tkey&);
     infix_const_iterator lower_bound(const tkey&) const;
 
     infix_iterator upper_bound(const tkey&);
     infix_const_iterator upper_bound(const tkey&) const;
 
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_iterator find(const key_like& key);
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_const_iterator find(const key_like& key) const;
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_iterator lower_bound(const key_like& key);
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_const_iterator lower_bound(const key_like& key) const;
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_iterator upper_bound(const key_like& key);
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_const_iterator upper_bound(const key_like& key) const;
+
     infix_iterator erase(infix_iterator pos);
     infix_iterator erase(infix_const_iterator pos);
 
     infix_iterator erase(infix_iterator first, infix_iterator last);
     infix_iterator erase(infix_const_iterator first, infix_const_iterator last);
 
+    // region order statistics
+
+    /** Keeps subtree sizes in nodes from now on, existing nodes are counted in O(n).
+     *  Without it the queries below throw std::logic_error
+     */
+    void use_order_statistics() noexcept;
+
+    /** index-th smallest key, O(log n). Throws std::out_of_range if index >= size()
+     */
+    infix_iterator nth(size_t index);
+    infix_const_iterator nth(size_t index) const;
+
+    /** Number of keys less than key, O(log n)
+     */
+    size_t rank(const tkey& key) const;
+
+    /** Number of keys in [lo, hi], O(log n)
+     */
+    size_t count_range(const tkey& lo, const tkey& hi) const;
+
+    // endregion order statistics
+
+    // region join-based set operations
+
+    /** Appends other, whose keys all must be greater than the keys of this tree, otherwise std::invalid_argument.
+     *  Nodes are relinked when both trees use the same allocator and no node pool, otherwise copied.
+     *  other is left empty
+     */
+    void join(red_black_tree& other);
+
+    /** Moves the keys not less than key into the returned tree. O(log n) with order statistics on,
+     *  otherwise the moved nodes are counted
+     */
+    red_black_tree split(const tkey& key);
+
+    /** Join-based set operations in O(m log(n / m + 1)) for tree sizes m <= n.
+     *  Keys present in this tree keep their values. set_union takes the nodes of other the same way as join
+     */
+    void set_union(red_black_tree& other);
+    void set_intersection(const red_black_tree& other);
+    void set_difference(const red_black_tree& other);
+
+    // endregion join-based set operations
+
+    // region parallel bulk operations
+
+    /* Work is divided by subtrees and run on pool, the calling thread takes part in it.
+     * The allocator must be thread-safe; with the node pool on, nodes are created and deleted by the calling thread only
+     */
+
+    /** Bulk insert of unsorted input: halves are sorted into subtrees independently and united.
+     *  Existing keys keep their values, of equal keys in the input the first one is taken
+     */
+    template<std::ranges::input_range R>
+    void insert_range(fork_join_pool& pool, R&& rg);
+
+    /** Erases keys in [lo, hi] in O(log n + k), returns how many were erased
+     */
+    size_t erase_range(const tkey& lo, const tkey& hi);
+    size_t erase_range(fork_join_pool& pool, const tkey& lo, const tkey& hi);
+
+    /** Calls function for every element, elements of different subtrees may be visited at once and in any order
+     */
+    template<typename F>
+    void for_each(fork_join_pool& pool, F&& function);
+
+    template<typename F>
+    void for_each(fork_join_pool& pool, F&& function) const;
+
+    /** reduce(... reduce(reduce(identity, map(first)), map(second)) ..., map(last)) for an associative reduce
+     *  with identity as its neutral element
+     */
+    template<typename T, typename Map, typename Reduce>
+    T map_reduce(fork_join_pool& pool, Map&& map, Reduce&& reduce, T identity) const;
+
+    // endregion parallel bulk operations
+
     using parent::erase;
     using parent::insert;
     using parent::insert_or_assign;
+    using parent::insert_range;
 };
 
 template<typename compare, typename U, typename iterator>
@@ -588,14 +778,301 @@ namespace __detail {
     binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::create_node(
             binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args)
     {
-        throw not_implemented("template<typename tkey, typename tvalue, typename compare> template<class ...Args> binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::create_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args)", "your code should be here...");
+        using node_type = typename red_black_tree<tkey, tvalue, compare>::node;
+        auto* new_node = cont._pool.template new_object<node_type>(cont._allocator, std::forward<Args>(args)...);
+        new_node->size = cont._order_statistics ? 1 : 0;
+        return new_node;
     }
 
     template<typename tkey, typename tvalue, typename compare>
     void bst_impl<tkey, tvalue, compare, RB_TAG>::delete_node(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont)
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** node)
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare>::node;
+        if (node && *node) {
+            cont._pool.delete_object(cont._allocator, static_cast<node_type*>(*node));
+            *node = nullptr;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::clone_node(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            const binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* source,
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* parent)
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare>::node;
+        auto* typed_source = static_cast<const node_type*>(source);
+        auto* new_node = static_cast<node_type*>(create_node(cont, parent, source->data));
+        new_node->color = typed_source->color;
+        new_node->size = typed_source->size;
+        return new_node;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    bool bst_impl<tkey, tvalue, compare, RB_TAG>::is_red(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare>::node;
+        return n && static_cast<node_type*>(n)->color == red_black_tree<tkey, tvalue, compare>::node_color::RED;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::set_color(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n, bool red) noexcept
     {
-        throw not_implemented("template<typename tkey, typename tvalue, typename compare> void bst_impl<tkey, tvalue, compare, RB_TAG>::delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont)", "your code should be here...");
+        using node_type = typename red_black_tree<tkey, tvalue, compare>::node;
+        using node_color = typename red_black_tree<tkey, tvalue, compare>::node_color;
+        static_cast<node_type*>(n)->color = red ? node_color::RED : node_color::BLACK;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::post_build(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont)
+    {
+        // Leaves of a perfectly balanced tree lie on the two deepest levels, coloring the deepest one red
+        // keeps the black height of every path equal. A lone root stays black
+        size_t depth = std::bit_width(cont._size) - 1;
+        paint_levels(cont._root, 0, depth == 0 ? static_cast<size_t>(-1) : depth);
+
+        if (cont._order_statistics) {
+            cont.build_sizes(cont._root);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    size_t bst_impl<tkey, tvalue, compare, RB_TAG>::subtree_size(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept
+    {
+        return n ? static_cast<typename red_black_tree<tkey, tvalue, compare>::node*>(n)->size : 0;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::recalculate_size(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept
+    {
+        static_cast<typename red_black_tree<tkey, tvalue, compare>::node*>(n)->recalculate_size();
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::paint_levels(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n, size_t depth, size_t red_depth) noexcept
+    {
+        if (!n) {
+            return;
+        }
+
+        set_color(n, depth == red_depth);
+        paint_levels(n->left_subtree, depth + 1, red_depth);
+        paint_levels(n->right_subtree, depth + 1, red_depth);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    size_t bst_impl<tkey, tvalue, compare, RB_TAG>::black_height(typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept
+    {
+        size_t height = 0;
+
+        for (; n; n = n->left_subtree) {
+            if (!is_red(n)) {
+                ++height;
+            }
+        }
+
+        return height;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::link(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right) noexcept
+    {
+        middle->parent = nullptr;
+        middle->left_subtree = left;
+        middle->right_subtree = right;
+
+        if (left) {
+            left->parent = middle;
+        }
+
+        if (right) {
+            right->parent = middle;
+        }
+
+        if (cont._order_statistics) {
+            recalculate_size(middle);
+        }
+
+        return middle;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::join(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right)
+    {
+        // A black root keeps both subtrees valid and leaves only the red middle node to fix
+        if (left) {
+            set_color(left, false);
+        }
+
+        if (right) {
+            set_color(right, false);
+        }
+
+        size_t left_black_height = black_height(left);
+        size_t right_black_height = black_height(right);
+
+        if (left_black_height > right_black_height) {
+            auto* joined = join_right(cont, left, left_black_height, middle, right, right_black_height);
+
+            if (is_red(joined) && is_red(joined->right_subtree)) {
+                set_color(joined, false);
+            }
+
+            return joined;
+        }
+
+        if (right_black_height > left_black_height) {
+            auto* joined = join_left(cont, left, left_black_height, middle, right, right_black_height);
+
+            if (is_red(joined) && is_red(joined->left_subtree)) {
+                set_color(joined, false);
+            }
+
+            return joined;
+        }
+
+        set_color(middle, true);
+        return link(cont, left, middle, right);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::join_right(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left, size_t left_black_height,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right, size_t right_black_height) noexcept
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
+
+        if (!is_red(left) && left_black_height == right_black_height) {
+            set_color(middle, true);
+            return link(cont, left, middle, right);
+        }
+
+        node_type* joined = join_right(cont, left->right_subtree, left_black_height - (is_red(left) ? 0 : 1),
+                                       middle, right, right_black_height);
+
+        left->right_subtree = joined;
+        joined->parent = left;
+
+        if (cont._order_statistics) {
+            recalculate_size(left);
+        }
+
+        // Red middle node under a red parent: rotate the black grandparent down
+        if (!is_red(left) && is_red(joined) && is_red(joined->right_subtree)) {
+            set_color(joined->right_subtree, false);
+
+            node_type* top = left;
+            cont.small_left_rotation(top);
+
+            if (cont._order_statistics) {
+                recalculate_size(left);
+                recalculate_size(top);
+            }
+
+            return top;
+        }
+
+        return left;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::join_left(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* left, size_t left_black_height,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* right, size_t right_black_height) noexcept
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
+
+        if (!is_red(right) && left_black_height == right_black_height) {
+            set_color(middle, true);
+            return link(cont, left, middle, right);
+        }
+
+        node_type* joined = join_left(cont, left, left_black_height, middle,
+                                      right->left_subtree, right_black_height - (is_red(right) ? 0 : 1));
+
+        right->left_subtree = joined;
+        joined->parent = right;
+
+        if (cont._order_statistics) {
+            recalculate_size(right);
+        }
+
+        if (!is_red(right) && is_red(joined) && is_red(joined->left_subtree)) {
+            set_color(joined->left_subtree, false);
+
+            node_type* top = right;
+            cont.small_right_rotation(top);
+
+            if (cont._order_statistics) {
+                recalculate_size(right);
+                recalculate_size(top);
+            }
+
+            return top;
+        }
+
+        return right;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::post_join(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont) noexcept
+    {
+        if (cont._root) {
+            set_color(cont._root, false);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::rotate_left(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept
+    {
+        auto* lowered = n;
+        cont.small_left_rotation(n);
+        if (!n->parent) {
+            cont._root = n;
+        }
+
+        if (subtree_size(lowered)) {
+            recalculate_size(lowered);
+            recalculate_size(n);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::rotate_right(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n) noexcept
+    {
+        auto* lowered = n;
+        cont.small_right_rotation(n);
+        if (!n->parent) {
+            cont._root = n;
+        }
+
+        if (subtree_size(lowered)) {
+            recalculate_size(lowered);
+            recalculate_size(n);
+        }
     }
 
     template<typename tkey, typename tvalue, typename compare>
@@ -603,7 +1080,69 @@ namespace __detail {
             binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
             typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** n)
     {
-        throw not_implemented("template<typename tkey, typename tvalue, typename compare> void bst_impl<tkey, tvalue, compare, RB_TAG>::post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**)", "your code should be here...");
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
+
+        if (!n || !*n) {
+            return;
+        }
+
+        node_type* current = *n;
+
+        if (cont._order_statistics) {
+            for (node_type* ancestor = current->parent; ancestor; ancestor = ancestor->parent) {
+                ++static_cast<typename red_black_tree<tkey, tvalue, compare>::node*>(ancestor)->size;
+            }
+        }
+
+        // A red parent is never the root, so the grandparent exists
+        while (is_red(current->parent)) {
+            node_type* parent = current->parent;
+            node_type* grandparent = parent->parent;
+
+            if (parent == grandparent->left_subtree) {
+                node_type* uncle = grandparent->right_subtree;
+
+                if (is_red(uncle)) {
+                    set_color(parent, false);
+                    set_color(uncle, false);
+                    set_color(grandparent, true);
+                    current = grandparent;
+                    continue;
+                }
+
+                if (current == parent->right_subtree) {
+                    rotate_left(cont, parent);
+                    current = parent;
+                    parent = current->parent;
+                }
+
+                set_color(parent, false);
+                set_color(grandparent, true);
+                rotate_right(cont, grandparent);
+            } else {
+                node_type* uncle = grandparent->left_subtree;
+
+                if (is_red(uncle)) {
+                    set_color(parent, false);
+                    set_color(uncle, false);
+                    set_color(grandparent, true);
+                    current = grandparent;
+                    continue;
+                }
+
+                if (current == parent->left_subtree) {
+                    rotate_right(cont, parent);
+                    current = parent;
+                    parent = current->parent;
+                }
+
+                set_color(parent, false);
+                set_color(grandparent, true);
+                rotate_left(cont, grandparent);
+            }
+        }
+
+        set_color(cont._root, false);
     }
 
     template<typename tkey, typename tvalue, typename compare>
@@ -611,44 +1150,207 @@ namespace __detail {
             binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
             typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** n)
     {
-        throw not_implemented("template<typename tkey, typename tvalue, typename compare> void bst_impl<tkey, tvalue, compare, RB_TAG>::erase(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**)", "your code should be here...");
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
+        using rb_node = typename red_black_tree<tkey, tvalue, compare>::node;
+
+        if (!n || !*n) {
+            return;
+        }
+
+        node_type* target = *n;
+
+        // Keys are const, so a node with two children trades places (and colors) with its in-order predecessor
+        if (target->left_subtree && target->right_subtree) {
+            node_type* predecessor = target->left_subtree;
+            while (predecessor->right_subtree) {
+                predecessor = predecessor->right_subtree;
+            }
+
+            node_type* target_parent = target->parent;
+            node_type* predecessor_parent = predecessor->parent;
+            node_type* predecessor_left = predecessor->left_subtree;
+
+            predecessor->right_subtree = target->right_subtree;
+            predecessor->right_subtree->parent = predecessor;
+
+            if (predecessor_parent == target) {
+                predecessor->left_subtree = target;
+                target->parent = predecessor;
+            } else {
+                predecessor->left_subtree = target->left_subtree;
+                predecessor->left_subtree->parent = predecessor;
+                predecessor_parent->right_subtree = target;
+                target->parent = predecessor_parent;
+            }
+
+            predecessor->parent = target_parent;
+            if (!target_parent) {
+                cont._root = predecessor;
+            } else if (target_parent->left_subtree == target) {
+                target_parent->left_subtree = predecessor;
+            } else {
+                target_parent->right_subtree = predecessor;
+            }
+
+            target->left_subtree = predecessor_left;
+            if (predecessor_left) {
+                predecessor_left->parent = target;
+            }
+            target->right_subtree = nullptr;
+
+            std::swap(static_cast<rb_node*>(target)->color, static_cast<rb_node*>(predecessor)->color);
+            std::swap(static_cast<rb_node*>(target)->size, static_cast<rb_node*>(predecessor)->size);
+        }
+
+        node_type* child = target->left_subtree ? target->left_subtree : target->right_subtree;
+        node_type* parent = target->parent;
+
+        if (child) {
+            child->parent = parent;
+        }
+
+        if (!parent) {
+            cont._root = child;
+        } else if (parent->left_subtree == target) {
+            parent->left_subtree = child;
+        } else {
+            parent->right_subtree = child;
+        }
+
+        if (cont._order_statistics) {
+            for (node_type* ancestor = parent; ancestor; ancestor = ancestor->parent) {
+                --static_cast<rb_node*>(ancestor)->size;
+            }
+        }
+
+        if (!is_red(target)) {
+            erase_fixup(cont, child, parent);
+        }
+
+        delete_node(cont, &target);
+        --cont._size;
+        *n = nullptr;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::erase_fixup(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* x,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* parent) noexcept
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node;
+
+        // The sibling of a doubly black position always exists: its subtree has black height at least one
+        while (x != cont._root && !is_red(x)) {
+            if (x == parent->left_subtree) {
+                node_type* sibling = parent->right_subtree;
+
+                if (is_red(sibling)) {
+                    set_color(sibling, false);
+                    set_color(parent, true);
+                    rotate_left(cont, parent);
+                    sibling = parent->right_subtree;
+                }
+
+                if (!is_red(sibling->left_subtree) && !is_red(sibling->right_subtree)) {
+                    set_color(sibling, true);
+                    x = parent;
+                    parent = x->parent;
+                    continue;
+                }
+
+                if (!is_red(sibling->right_subtree)) {
+                    set_color(sibling->left_subtree, false);
+                    set_color(sibling, true);
+                    rotate_right(cont, sibling);
+                    sibling = parent->right_subtree;
+                }
+
+                set_color(sibling, is_red(parent));
+                set_color(parent, false);
+                set_color(sibling->right_subtree, false);
+                rotate_left(cont, parent);
+            } else {
+                node_type* sibling = parent->left_subtree;
+
+                if (is_red(sibling)) {
+                    set_color(sibling, false);
+                    set_color(parent, true);
+                    rotate_right(cont, parent);
+                    sibling = parent->left_subtree;
+                }
+
+                if (!is_red(sibling->left_subtree) && !is_red(sibling->right_subtree)) {
+                    set_color(sibling, true);
+                    x = parent;
+                    parent = x->parent;
+                    continue;
+                }
+
+                if (!is_red(sibling->left_subtree)) {
+                    set_color(sibling->right_subtree, false);
+                    set_color(sibling, true);
+                    rotate_left(cont, sibling);
+                    sibling = parent->left_subtree;
+                }
+
+                set_color(sibling, is_red(parent));
+                set_color(parent, false);
+                set_color(sibling->left_subtree, false);
+                rotate_right(cont, parent);
+            }
+
+            x = cont._root;
+        }
+
+        if (x) {
+            set_color(x, false);
+        }
     }
 
     template<typename tkey, typename tvalue, typename compare>
     void bst_impl<tkey, tvalue, compare, RB_TAG>::swap(binary_search_tree<tkey, tvalue, compare, RB_TAG> &lhs,
                                                                             binary_search_tree<tkey, tvalue, compare, RB_TAG> &rhs) noexcept
     {
-        throw not_implemented("template<typename tkey, typename tvalue, typename compare>\n"
-                              "void bst_impl<tkey, tvalue, compare, RB_TAG>::swap(binary_search_tree<tkey, tvalue, compare, RB_TAG> &lhs,\n"
-                              "binary_search_tree<tkey, tvalue, compare, RB_TAG> &rhs) noexcept", "your code should be here...");
+        std::swap(lhs._root, rhs._root);
+        std::swap(lhs._logger, rhs._logger);
+        std::swap(lhs._size, rhs._size);
+        std::swap(lhs._allocator, rhs._allocator);
+        lhs._pool.swap(rhs._pool);
+        std::swap(lhs._order_statistics, rhs._order_statistics);
     }
 }
 
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<class ...Args>
-red_black_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
+red_black_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args) : parent::node(par, std::forward<Args>(args)...), color(node_color::RED), size(0) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void red_black_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<class ...Args> red_black_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)", "your code should be here...");
+    size = 1;
+
+    if (this->left_subtree) {
+        size += static_cast<node*>(this->left_subtree)->size;
+    }
+
+    if (this->right_subtree) {
+        size += static_cast<node*>(this->right_subtree)->size;
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::red_black_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
-        logger *log)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> red_black_tree<tkey, tvalue, compare>::red_black_tree(const compare& , pp_allocator<value_type> , logger *)", "your code should be here...");
-}
+        logger *log) : parent(comp, alloc, log) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::red_black_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
-        logger *log)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> red_black_tree<tkey, tvalue, compare>::red_black_tree(pp_allocator<value_type> , const compare& , logger *)", "your code should be here...");
-}
+        logger *log) : parent(comp, alloc, log) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
@@ -656,10 +1358,7 @@ red_black_tree<tkey, tvalue, compare>::red_black_tree(
         iterator begin, iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<input_iterator_for_pair<tkey, tvalue> iterator> red_black_tree<tkey, tvalue, compare>::red_black_tree(iterator , iterator , const compare& , pp_allocator<value_type> , logger* )", "your code should be here...");
-}
+        logger* log) : parent(begin, end, cmp, alloc, log) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<std::ranges::input_range Range>
@@ -667,381 +1366,363 @@ red_black_tree<tkey, tvalue, compare>::red_black_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<std::ranges::input_range Range> red_black_tree<tkey, tvalue, compare>::red_black_tree( Range&& range, const compare& cmp, pp_allocator<value_type> alloc, logger* log)", "your code should be here...");
-}
+        logger* log) : parent(std::forward<Range>(range), cmp, alloc, log) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::red_black_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> red_black_tree<tkey, tvalue, compare>::red_black_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* log)", "your code should be here...");
-}
+        logger* log) : parent(data, cmp, alloc, log) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<std::input_iterator iterator>
+red_black_tree<tkey, tvalue, compare>::red_black_tree(
+        sorted_unique_t,
+        iterator begin, iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* log) : parent(sorted_unique, begin, end, cmp, alloc, log) {}
 
 // region iterator implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node* n) noexcept : parent::prefix_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept : parent::prefix_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::prefix_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::prefix_iterator::get_color() const noexcept ", "your code should be here...");
+    return static_cast<node*>(this->_data)->color;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept : parent::prefix_const_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::get_color() const noexcept ", "your code should be here...");
+    return prefix_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept : parent::prefix_const_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept : parent::prefix_reverse_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_color() const noexcept ", "your code should be here...");
+    return prefix_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept : parent::prefix_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::prefix_iterator() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::operator prefix_iterator() const noexcept ", "your code should be here...");
+    return parent::prefix_reverse_iterator::operator prefix_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
 red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_iterator red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept ", "your code should be here...");
+    return parent::prefix_reverse_iterator::base();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept : parent::prefix_const_reverse_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_color() const noexcept ", "your code should be here...");
+    return prefix_const_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::prefix_const_iterator() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::operator prefix_const_iterator() const noexcept ", "your code should be here...");
+    return parent::prefix_const_reverse_iterator::operator prefix_const_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
 red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noexcept ", "your code should be here...");
+    return parent::prefix_const_reverse_iterator::base();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node* n) noexcept
+red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node* n) noexcept : parent::infix_iterator(n) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept : parent::infix_iterator(it) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::node_color
+red_black_tree<tkey, tvalue, compare>::infix_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node* n) noexcept", "your code should be here...");
+    return static_cast<node*>(this->_data)->color;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator&
+red_black_tree<tkey, tvalue, compare>::infix_iterator::operator+=(difference_type offset) & noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept", "your code should be here...");
+    parent::advance_infix(*this, offset);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_iterator::get_color() const noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator&
+red_black_tree<tkey, tvalue, compare>::infix_iterator::operator-=(difference_type offset) & noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::infix_iterator::get_color() const noexcept ", "your code should be here...");
+    parent::advance_infix(*this, -offset);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::infix_iterator::operator+(difference_type offset) const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept", "your code should be here...");
+    infix_iterator result = *this;
+    return result += offset;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::infix_iterator::operator-(difference_type offset) const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept", "your code should be here...");
+    infix_iterator result = *this;
+    return result -= offset;
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator::difference_type
+red_black_tree<tkey, tvalue, compare>::infix_iterator::operator-(const infix_iterator& other) const noexcept
+{
+    return parent::infix_distance(other, *this);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept : parent::infix_const_iterator(n) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept : parent::infix_const_iterator(it) {}
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::infix_const_iterator::get_color() const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::infix_const_iterator::get_color() const noexcept", "your code should be here...");
+    return infix_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator&
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::operator+=(difference_type offset) & noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept", "your code should be here...");
+    parent::advance_infix(this->_base, offset);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator&
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::operator-=(difference_type offset) & noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept) noexcept", "your code should be here...");
+    parent::advance_infix(this->_base, -offset);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::operator+(difference_type offset) const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept", "your code should be here...");
+    infix_const_iterator result = *this;
+    return result += offset;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_color() const noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::operator-(difference_type offset) const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_color() const noexcept", "your code should be here...");
+    infix_const_iterator result = *this;
+    return result -= offset;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator::difference_type
+red_black_tree<tkey, tvalue, compare>::infix_const_iterator::operator-(const infix_const_iterator& other) const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept", "your code should be here...");
+    return parent::infix_distance(other._base, this->_base);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept : parent::infix_reverse_iterator(n) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept : parent::infix_reverse_iterator(it) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::node_color
+red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_color() const noexcept
+{
+    return infix_iterator(this->_base).get_color();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept : parent::infix_reverse_iterator(it) {}
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::infix_iterator() const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::operator infix_iterator() const noexcept", "your code should be here...");
+    return parent::infix_reverse_iterator::operator infix_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept", "your code should be here...");
+    return parent::infix_reverse_iterator::base();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept
-{
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept : parent::infix_const_reverse_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept
-{
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_color() const noexcept
 {
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_color() const noexcept", "your code should be here...");
+    return infix_const_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept
-{
-throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::infix_const_iterator() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::operator infix_const_iterator() const noexcept", "your code should be here...");
+    return parent::infix_const_reverse_iterator::operator infix_const_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noexcept", "your code should be here...");
+    return parent::infix_const_reverse_iterator::base();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node* n) noexcept : parent::postfix_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept : parent::postfix_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::postfix_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::postfix_iterator::get_color() const noexcept", "your code should be here...");
+    return static_cast<node*>(this->_data)->color;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept : parent::postfix_const_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept : parent::postfix_const_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::get_color() const noexcept", "your code should be here...");
+    return postfix_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept : parent::postfix_const_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_color() const noexcept", "your code should be here...");
+    return postfix_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept : parent::postfix_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::postfix_iterator() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::operator postfix_iterator() const noexcept", "your code should be here...");
+    return parent::postfix_reverse_iterator::operator postfix_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
 red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_iterator red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept", "your code should be here...");
+    return parent::postfix_reverse_iterator::base();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept : parent::postfix_const_reverse_iterator(n) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_const_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::node_color
 red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_color() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_color() const noexcept", "your code should be here...");
+    return postfix_const_iterator(this->_base).get_color();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::postfix_const_iterator() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::operator postfix_const_iterator() const noexcept", "your code should be here...");
+    return parent::postfix_const_reverse_iterator::operator postfix_const_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
 red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const noexcept", "your code should be here...");
+    return parent::postfix_const_reverse_iterator::base();
 }
 
 // endregion iterator implementation
@@ -1052,336 +1733,336 @@ template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::begin() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::begin() noexcept", "your code should be here...");
+    return parent::begin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::end() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::end() noexcept", "your code should be here...");
+    return parent::end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::begin() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::begin() const noexcept", "your code should be here...");
+    return parent::begin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::end() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::end() const noexcept", "your code should be here...");
+    return parent::end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cbegin() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::cbegin() const noexcept", "your code should be here...");
+    return parent::cbegin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cend() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::cend() const noexcept", "your code should be here...");
+    return parent::cend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator red_black_tree<tkey, tvalue, compare>::rbegin() noexcept", "your code should be here...");
+    return parent::rbegin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend() noexcept", "your code should be here...");
+    return parent::rend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rbegin() const noexcept", "your code should be here...");
+    return parent::rbegin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend() const noexcept", "your code should be here...");
+    return parent::rend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crbegin() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crbegin() const noexcept", "your code should be here...");
+    return parent::crbegin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crend() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crend() const noexcept", "your code should be here...");
+    return parent::crend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
 red_black_tree<tkey, tvalue, compare>::begin_prefix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_iterator red_black_tree<tkey, tvalue, compare>::begin_prefix() noexcept", "your code should be here...");
+    return parent::begin_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
 red_black_tree<tkey, tvalue, compare>::end_prefix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_iterator red_black_tree<tkey, tvalue, compare>::end_prefix() noexcept", "your code should be here...");
+    return parent::end_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
 red_black_tree<tkey, tvalue, compare>::begin_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator red_black_tree<tkey, tvalue, compare>::begin_prefix() const noexcept", "your code should be here...");
+    return parent::begin_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
 red_black_tree<tkey, tvalue, compare>::end_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator red_black_tree<tkey, tvalue, compare>::end_prefix() const noexcept", "your code should be here...");
+    return parent::end_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cbegin_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator red_black_tree<tkey, tvalue, compare>::cbegin_prefix() const noexcept", "your code should be here...");
+    return parent::cbegin_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cend_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator red_black_tree<tkey, tvalue, compare>::cend_prefix() const noexcept", "your code should be here...");
+    return parent::cend_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin_prefix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iteratorred_black_tree<tkey, tvalue, compare>::rbegin_prefix() noexcept", "your code should be here...");
+    return parent::rbegin_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend_prefix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend_prefix() noexcept", "your code should be here...");
+    return parent::rend_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rbegin_prefix() const noexcept", "your code should be here...");
+    return parent::rbegin_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend_prefix() const noexcept", "your code should be here...");
+    return parent::rend_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crbegin_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crbegin_prefix() const noexcept", "your code should be here...");
+    return parent::crbegin_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crend_prefix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crend_prefix() const noexcept", "your code should be here...");
+    return parent::crend_prefix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::begin_infix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::begin_infix() noexcept", "your code should be here...");
+    return parent::begin_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::end_infix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::end_infix() noexcept", "your code should be here...");
+    return parent::end_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::begin_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::begin_infix() const noexcept", "your code should be here...");
+    return parent::begin_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::end_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::end_infix() const noexcept", "your code should be here...");
+    return parent::end_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cbegin_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::cbegin_infix() const noexcept", "your code should be here...");
+    return parent::cbegin_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cend_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::cend_infix() const noexcept", "your code should be here...");
+    return parent::cend_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin_infix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator red_black_tree<tkey, tvalue, compare>::rbegin_infix() noexcept", "your code should be here...");
+    return parent::rbegin_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend_infix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend_infix() noexcept", "your code should be here...");
+    return parent::rend_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rbegin_infix() const noexcept", "your code should be here...");
+    return parent::rbegin_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend_infix() const noexcept", "your code should be here...");
+    return parent::rend_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crbegin_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crbegin_infix() const noexcept", "your code should be here...");
+    return parent::crbegin_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crend_infix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crend_infix() const noexcept", "your code should be here...");
+    return parent::crend_infix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
 red_black_tree<tkey, tvalue, compare>::begin_postfix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_iterator red_black_tree<tkey, tvalue, compare>::begin_postfix() noexcept", "your code should be here...");
+    return parent::begin_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
 red_black_tree<tkey, tvalue, compare>::end_postfix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_iterator red_black_tree<tkey, tvalue, compare>::end_postfix() noexcept", "your code should be here...");
+    return parent::end_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
 red_black_tree<tkey, tvalue, compare>::begin_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator red_black_tree<tkey, tvalue, compare>::begin_postfix() const noexcept", "your code should be here...");
+    return parent::begin_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
 red_black_tree<tkey, tvalue, compare>::end_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator red_black_tree<tkey, tvalue, compare>::end_postfix() const noexcept", "your code should be here...");
+    return parent::end_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cbegin_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator red_black_tree<tkey, tvalue, compare>::cbegin_postfix() const noexcept", "your code should be here...");
+    return parent::cbegin_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
 red_black_tree<tkey, tvalue, compare>::cend_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator red_black_tree<tkey, tvalue, compare>::cend_postfix() const noexcept", "your code should be here...");
+    return parent::cend_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin_postfix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator red_black_tree<tkey, tvalue, compare>::rbegin_postfix() noexcept", "your code should be here...");
+    return parent::rbegin_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend_postfix() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend_postfix() noexcept", "your code should be here...");
+    return parent::rend_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rbegin_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rbegin_postfix() const noexcept", "your code should be here...");
+    return parent::rbegin_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::rend_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::rend_postfix() const noexcept", "your code should be here...");
+    return parent::rend_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crbegin_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crbegin_postfix() const noexcept", "your code should be here...");
+    return parent::crbegin_postfix();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
 red_black_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator red_black_tree<tkey, tvalue, compare>::crend_postfix() const noexcept", "your code should be here...");
+    return parent::crend_postfix();
 }
 
 // endregion iterator requests implementation
@@ -1389,41 +2070,42 @@ red_black_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
 // region rb_tree implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::~red_black_tree() noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::~red_black_tree() noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::~red_black_tree() noexcept {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree const &other)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree const &other)", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree const &other) : parent(other) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare> &
 red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare> & red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree const &other)", "your code should be here...");
+    if (this != &other) {
+        parent::operator=(other);
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree &&other) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree &&other) noexcept", "your code should be here...");
-}
+red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree &&other) noexcept : parent(std::move(other)) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 red_black_tree<tkey, tvalue, compare> &
 red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree &&other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> red_black_tree<tkey, tvalue, compare> & red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree &&other) noexcept", "your code should be here...");
+    if (this != &other) {
+        parent::operator=(std::move(other));
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 void red_black_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> void red_black_tree<tkey, tvalue, compare>::swap(parent& other) noexcept", "your code should be here...");
+    if (this != &other) {
+        parent::swap(other);
+    }
 }
 
 // endregion rb_tree implementation
@@ -1432,14 +2114,14 @@ template<typename tkey, typename tvalue, compator<tkey> compare>
 std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
 red_black_tree<tkey, tvalue, compare>::insert(const value_type& value)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool> red_black_tree<tkey, tvalue, compare>::insert(const value_type& value)", "your code should be here...");
+    return parent::insert(value);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
 red_black_tree<tkey, tvalue, compare>::insert(value_type&& value)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool> red_black_tree<tkey, tvalue, compare>::insert(value_type&& value)", "your code should be here...");
+    return parent::insert(std::move(value));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -1447,21 +2129,21 @@ template<class ...Args>
 std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
 red_black_tree<tkey, tvalue, compare>::emplace(Args&&... args)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> template<class ...Args> std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool> red_black_tree<tkey, tvalue, compare>::emplace(Args&&... args)", "your code should be here...");
+    return parent::emplace(std::forward<Args>(args)...);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& value)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& value)", "your code should be here...");
+    return parent::insert_or_assign(value);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& value)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& value)", "your code should be here...");
+    return parent::insert_or_assign(std::move(value));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -1469,77 +2151,293 @@ template<class ...Args>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::emplace_or_assign(Args&&... args)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> template<class ...Args> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::emplace_or_assign(Args&&... args)", "your code should be here...");
+    return parent::emplace_or_assign(std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::insert(parent::infix_const_iterator hint, const value_type& value)
+{
+    return parent::insert(hint, value);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::insert(parent::infix_const_iterator hint, value_type&& value)
+{
+    return parent::insert(hint, std::move(value));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::emplace_hint(parent::infix_const_iterator hint, Args&&...args)
+{
+    return parent::emplace_hint(hint, std::forward<Args>(args)...);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::find(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::find(const tkey& key)", "your code should be here...");
+    return parent::find(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::find(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::find(const tkey& key) const", "your code should be here...");
+    return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::find_from(parent::infix_const_iterator pos, const tkey& key)
+{
+    return parent::find_from(pos, key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare>::find_from(parent::infix_const_iterator pos, const tkey& key) const
+{
+    return parent::find_from(pos, key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)", "your code should be here...");
+    return parent::lower_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key) const", "your code should be here...");
+    return parent::lower_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key)", "your code should be here...");
+    return parent::upper_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
 red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key) const", "your code should be here...");
+    return parent::upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::find(const key_like& key)
+{
+    return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare>::find(const key_like& key) const
+{
+    return parent::find(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::lower_bound(const key_like& key)
+{
+    return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare>::lower_bound(const key_like& key) const
+{
+    return parent::lower_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::upper_bound(const key_like& key)
+{
+    return parent::upper_bound(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare>::upper_bound(const key_like& key) const
+{
+    return parent::upper_bound(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::erase(infix_iterator pos)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::erase(infix_iterator pos)", "your code should be here...");
+    return parent::erase(pos);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator pos)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator pos)", "your code should be here...");
+    return parent::erase(pos);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::erase(infix_iterator first, infix_iterator last)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::erase(infix_iterator first, infix_iterator last)", "your code should be here...");
+    return parent::erase(first, last);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 typename red_black_tree<tkey, tvalue, compare>::infix_iterator
 red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator first, infix_const_iterator last)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, typename compare> typename red_black_tree<tkey, tvalue, compare>::infix_iterator red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator first, infix_const_iterator last)", "your code should be here...");
+    return parent::erase(first, last);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void red_black_tree<tkey, tvalue, compare>::use_order_statistics() noexcept
+{
+    parent::enable_order_statistics();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_iterator
+red_black_tree<tkey, tvalue, compare>::nth(size_t index)
+{
+    this->check_order_statistics();
+
+    if (index >= this->_size) {
+        throw std::out_of_range("Index is out of tree size");
+    }
+
+    return infix_iterator(parent::select_node(this->_root, index));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare>::nth(size_t index) const
+{
+    this->check_order_statistics();
+
+    if (index >= this->_size) {
+        throw std::out_of_range("Index is out of tree size");
+    }
+
+    return infix_const_iterator(parent::select_node(this->_root, index));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t red_black_tree<tkey, tvalue, compare>::rank(const tkey& key) const
+{
+    this->check_order_statistics();
+    return this->count_less(key, false);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t red_black_tree<tkey, tvalue, compare>::count_range(const tkey& lo, const tkey& hi) const
+{
+    this->check_order_statistics();
+
+    size_t before = this->count_less(lo, false);
+    size_t through = this->count_less(hi, true);
+
+    return through > before ? through - before : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void red_black_tree<tkey, tvalue, compare>::join(red_black_tree& other)
+{
+    this->join_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+red_black_tree<tkey, tvalue, compare> red_black_tree<tkey, tvalue, compare>::split(const tkey& key)
+{
+    red_black_tree result(this->key_comp(), this->_allocator, this->_logger);
+
+    if (this->_pool.chunk_nodes()) {
+        result.use_node_pool(this->_pool.chunk_nodes());
+    }
+
+    if (this->_order_statistics) {
+        result.use_order_statistics();
+    }
+
+    this->split_tree(key, result);
+
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void red_black_tree<tkey, tvalue, compare>::set_union(red_black_tree& other)
+{
+    this->union_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void red_black_tree<tkey, tvalue, compare>::set_intersection(const red_black_tree& other)
+{
+    this->intersect_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void red_black_tree<tkey, tvalue, compare>::set_difference(const red_black_tree& other)
+{
+    this->subtract_tree(other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<std::ranges::input_range R>
+void red_black_tree<tkey, tvalue, compare>::insert_range(fork_join_pool& pool, R&& rg)
+{
+    this->parallel_insert_range(pool, std::forward<R>(rg));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t red_black_tree<tkey, tvalue, compare>::erase_range(const tkey& lo, const tkey& hi)
+{
+    return this->erase_key_range(lo, hi, nullptr);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t red_black_tree<tkey, tvalue, compare>::erase_range(fork_join_pool& pool, const tkey& lo, const tkey& hi)
+{
+    return this->erase_key_range(lo, hi, this->node_workers(pool));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename F>
+void red_black_tree<tkey, tvalue, compare>::for_each(fork_join_pool& pool, F&& function)
+{
+    parent::visit_subtree(this->_root, function, &pool, parent::fork_depth(&pool));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename F>
+void red_black_tree<tkey, tvalue, compare>::for_each(fork_join_pool& pool, F&& function) const
+{
+    parent::visit_subtree(static_cast<const typename parent::node*>(this->_root), function, &pool, parent::fork_depth(&pool));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename T, typename Map, typename Reduce>
+T red_black_tree<tkey, tvalue, compare>::map_reduce(fork_join_pool& pool, Map&& map, Reduce&& reduce, T identity) const
+{
+    return parent::reduce_subtree(this->_root, map, reduce, identity, &pool, parent::fork_depth(&pool));
 }
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_RED_BLACK_TREE_H
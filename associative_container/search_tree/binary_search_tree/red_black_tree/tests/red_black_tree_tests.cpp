@@ -1,9 +1,14 @@
 #include "gtest/gtest.h"
 #include <red_black_tree.h>
+#include <concurrent_red_black_tree.h>
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <list>
 #include <map>
+#include <optional>
+#include <string_view>
+#include <thread>
 
 
 logger *create_logger(
@@ -628,6 +633,959 @@ TEST(redBlackTreePositiveTests, test17)
 }
 
 
+TEST(redBlackTreePositiveTests, test18)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test18 started");
+
+    using color = red_black_tree<int, std::string>::node_color;
+
+    std::vector<std::pair<int, std::string>> sorted =
+        {
+            { 1, "a" },
+            { 2, "b" },
+            { 3, "c" },
+            { 4, "d" },
+            { 5, "e" },
+            { 6, "f" }
+        };
+
+    red_black_tree<int, std::string> rb(sorted_unique, sorted.begin(), sorted.end(), std::less<int>(), nullptr, logger.get());
+
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+            test_data<int, std::string>(2, 1, "a", color::RED),
+            test_data<int, std::string>(1, 2, "b", color::BLACK),
+            test_data<int, std::string>(2, 3, "c", color::RED),
+            test_data<int, std::string>(0, 4, "d", color::BLACK),
+            test_data<int, std::string>(2, 5, "e", color::RED),
+            test_data<int, std::string>(1, 6, "f", color::BLACK)
+        };
+
+    EXPECT_TRUE(infix_iterator_test(rb, expected_result));
+
+    // Sorted run is merged, an existing key keeps its value
+    std::vector<std::pair<int, std::string>> tail =
+        {
+            { 4, "x" },
+            { 7, "g" },
+            { 8, "h" },
+            { 9, "i" }
+        };
+
+    rb.insert_range(tail);
+
+    expected_result =
+        {
+            test_data<int, std::string>(3, 1, "a", color::RED),
+            test_data<int, std::string>(2, 2, "b", color::BLACK),
+            test_data<int, std::string>(1, 3, "c", color::BLACK),
+            test_data<int, std::string>(2, 4, "d", color::BLACK),
+            test_data<int, std::string>(0, 5, "e", color::BLACK),
+            test_data<int, std::string>(3, 6, "f", color::RED),
+            test_data<int, std::string>(2, 7, "g", color::BLACK),
+            test_data<int, std::string>(1, 8, "h", color::BLACK),
+            test_data<int, std::string>(2, 9, "i", color::BLACK)
+        };
+
+    EXPECT_TRUE(infix_iterator_test(rb, expected_result));
+
+    for (int i = 1; i <= 9; ++i)
+    {
+        rb.erase(i);
+    }
+
+    EXPECT_TRUE(rb.empty());
+
+    logger->trace("redBlackTreePositiveTests.test18 finished");
+}
+
+TEST(redBlackTreePositiveTests, test19)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test19 started");
+
+    red_black_tree<int, int> rb(std::less<int>(), nullptr, logger.get());
+    std::map<int, int> map;
+
+    srand(42);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        int key = rand() % 1000;
+        rb.emplace(key, i);
+        map.emplace(key, i);
+    }
+
+    EXPECT_THROW(rb.rank(0), std::logic_error);
+
+    // Switched on for a filled tree, later changes keep sizes up to date
+    rb.use_order_statistics();
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        int key = rand() % 1000;
+
+        if (rand() % 2)
+        {
+            rb.emplace(key, i);
+            map.emplace(key, i);
+        }
+        else if (map.erase(key))
+        {
+            rb.erase(key);
+        }
+    }
+
+    ASSERT_EQ(rb.size(), map.size());
+
+    size_t index = 0;
+
+    for (auto& [key, value] : map)
+    {
+        EXPECT_EQ(rb.nth(index)->first, key);
+        EXPECT_EQ(rb.rank(key), index);
+        ++index;
+    }
+
+    EXPECT_THROW(rb.nth(map.size()), std::out_of_range);
+
+    for (int lo = -10; lo < 1010; lo += 37)
+    {
+        int hi = lo + rand() % 200;
+        auto expected = std::distance(map.lower_bound(lo), map.upper_bound(hi));
+
+        EXPECT_EQ(rb.count_range(lo, hi), expected);
+    }
+
+    EXPECT_EQ(rb.count_range(10, 5), 0);
+
+    auto begin = rb.begin_infix();
+    auto end = rb.end_infix();
+    auto it = begin + static_cast<ptrdiff_t>(map.size() / 2);
+
+    EXPECT_EQ(it->first, std::next(map.begin(), map.size() / 2)->first);
+    EXPECT_EQ(it - begin, static_cast<ptrdiff_t>(map.size() / 2));
+    EXPECT_EQ(end - it, static_cast<ptrdiff_t>(map.size() - map.size() / 2));
+    EXPECT_EQ((end - 1)->first, map.rbegin()->first);
+    EXPECT_TRUE(begin + static_cast<ptrdiff_t>(map.size()) == end);
+
+    it -= 3;
+    EXPECT_EQ(it->first, std::next(map.begin(), map.size() / 2 - 3)->first);
+
+    // Without order statistics iterators step one by one
+    red_black_tree<int, int> plain(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        plain.emplace(i, i);
+    }
+
+    auto plain_it = plain.begin_infix() + 7;
+
+    EXPECT_EQ(plain_it->first, 7);
+    EXPECT_EQ(plain.end_infix() - plain_it, 3);
+    EXPECT_EQ(plain_it - plain.end_infix(), -3);
+
+    logger->trace("redBlackTreePositiveTests.test19 finished");
+}
+
+TEST(redBlackTreePositiveTests, test20)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test20 started");
+
+    using tree = red_black_tree<int, int>;
+
+    auto fill = [&](tree& target, std::map<int, int>& expected, int count, int spread)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            int key = rand() % spread;
+            target.emplace(key, i);
+            expected.emplace(key, i);
+        }
+    };
+
+    auto same = [](tree const& actual, std::map<int, int> const& expected)
+    {
+        if (actual.size() != expected.size())
+        {
+            return false;
+        }
+
+        auto it = actual.cbegin_infix();
+
+        for (auto& [key, value] : expected)
+        {
+            if (it->first != key || it->second != value)
+            {
+                return false;
+            }
+
+            ++it;
+        }
+
+        return true;
+    };
+
+    srand(7);
+
+    for (bool statistics : {false, true})
+    {
+        tree lhs(std::less<int>(), nullptr, logger.get()), rhs(std::less<int>(), nullptr, logger.get());
+
+        if (statistics)
+        {
+            lhs.use_order_statistics();
+        }
+
+        std::map<int, int> lhs_map, rhs_map;
+        fill(lhs, lhs_map, 300, 1000);
+        fill(rhs, rhs_map, 300, 1000);
+
+        // Split, then join the halves back
+        tree upper = lhs.split(500);
+        std::map<int, int> upper_map(lhs_map.lower_bound(500), lhs_map.end());
+        lhs_map.erase(lhs_map.lower_bound(500), lhs_map.end());
+
+        EXPECT_TRUE(same(lhs, lhs_map));
+        EXPECT_TRUE(same(upper, upper_map));
+
+        upper.emplace(2000, -1);
+        upper_map.emplace(2000, -1);
+        lhs.erase(lhs_map.begin()->first);
+        lhs_map.erase(lhs_map.begin());
+
+        EXPECT_THROW(upper.join(lhs), std::invalid_argument);
+
+        lhs.join(upper);
+        lhs_map.merge(upper_map);
+
+        EXPECT_TRUE(upper.empty());
+        EXPECT_TRUE(same(lhs, lhs_map));
+
+        // Set operations keep values of this tree for equal keys
+        tree united(lhs), intersected(lhs), subtracted(lhs);
+        intersected.set_intersection(rhs);
+        subtracted.set_difference(rhs);
+        united.set_union(rhs);
+
+        std::map<int, int> united_map(lhs_map), intersected_map, subtracted_map;
+        united_map.insert(rhs_map.begin(), rhs_map.end());
+
+        for (auto& [key, value] : lhs_map)
+        {
+            (rhs_map.contains(key) ? intersected_map : subtracted_map).emplace(key, value);
+        }
+
+        EXPECT_TRUE(same(united, united_map));
+        EXPECT_TRUE(same(intersected, intersected_map));
+        EXPECT_TRUE(same(subtracted, subtracted_map));
+        EXPECT_TRUE(rhs.empty());
+
+        if (statistics)
+        {
+            size_t index = 0;
+
+            for (auto& [key, value] : united_map)
+            {
+                EXPECT_EQ(united.nth(index)->first, key);
+                EXPECT_EQ(united.rank(key), index++);
+            }
+        }
+
+        // Trees stay usable after relinking
+        for (int i = 0; i < 500; ++i)
+        {
+            int key = rand() % 1000;
+
+            if (rand() % 2)
+            {
+                united.emplace(key, i);
+                united_map.emplace(key, i);
+            }
+            else if (united_map.erase(key))
+            {
+                united.erase(key);
+            }
+        }
+
+        EXPECT_TRUE(same(united, united_map));
+
+        subtracted.set_difference(subtracted);
+        EXPECT_TRUE(subtracted.empty());
+    }
+
+    // Pooled trees cannot hand nodes over and copy them instead
+    tree pooled(std::less<int>(), nullptr, logger.get()), other(std::less<int>(), nullptr, logger.get());
+    pooled.use_node_pool(16);
+    std::map<int, int> pooled_map, other_map;
+    fill(pooled, pooled_map, 100, 300);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        other.emplace(1000 + i, i);
+        other_map.emplace(1000 + i, i);
+    }
+
+    pooled.join(other);
+    pooled_map.merge(other_map);
+
+    EXPECT_TRUE(other.empty());
+    EXPECT_TRUE(same(pooled, pooled_map));
+
+    tree pooled_upper = pooled.split(150);
+    std::map<int, int> pooled_upper_map(pooled_map.lower_bound(150), pooled_map.end());
+    pooled_map.erase(pooled_map.lower_bound(150), pooled_map.end());
+
+    EXPECT_TRUE(same(pooled, pooled_map));
+    EXPECT_TRUE(same(pooled_upper, pooled_upper_map));
+
+    logger->trace("redBlackTreePositiveTests.test20 finished");
+}
+
+TEST(redBlackTreePositiveTests, test21)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test21 started");
+
+    using tree = red_black_tree<int, int>;
+
+    fork_join_pool pool(4);
+
+    srand(11);
+
+    for (size_t chunk_nodes : {size_t(0), size_t(32)})
+    {
+        tree parallel(std::less<int>(), nullptr, logger.get());
+        std::map<int, int> map;
+
+        if (chunk_nodes)
+        {
+            parallel.use_node_pool(chunk_nodes);
+        }
+        else
+        {
+            parallel.use_order_statistics();
+        }
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            int key = rand() % 100000;
+            parallel.emplace(key, -i);
+            map.emplace(key, -i);
+        }
+
+        // Duplicates inside the batch and against the tree, the first value of a key wins
+        std::vector<std::pair<const int, int>> batch;
+
+        for (int i = 0; i < 50000; ++i)
+        {
+            int key = rand() % 100000;
+            batch.emplace_back(key, i);
+            map.emplace(key, i);
+        }
+
+        parallel.insert_range(pool, batch);
+
+        ASSERT_EQ(parallel.size(), map.size());
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+
+        std::list<std::pair<const int, int>> tail{{200000, 1}, {200001, 2}, {200000, 3}};
+        parallel.insert_range(pool, tail);
+        map.insert(tail.begin(), tail.end());
+
+        ASSERT_EQ(parallel.size(), map.size());
+        EXPECT_EQ(parallel.find(200000)->second, 1);
+
+        if (!chunk_nodes)
+        {
+            EXPECT_EQ(parallel.nth(map.size() / 3)->first, std::next(map.begin(), map.size() / 3)->first);
+            EXPECT_EQ(parallel.rank(50000), std::distance(map.begin(), map.lower_bound(50000)));
+        }
+
+        EXPECT_EQ(parallel.erase_range(pool, 20000, 60000), std::distance(map.lower_bound(20000), map.upper_bound(60000)));
+        map.erase(map.lower_bound(20000), map.upper_bound(60000));
+
+        int lo = map.begin()->first;
+        EXPECT_EQ(parallel.erase_range(lo, lo), 1);
+        map.erase(lo);
+
+        EXPECT_EQ(parallel.erase_range(10, 5), 0);
+        ASSERT_EQ(parallel.size(), map.size());
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+
+        parallel.for_each(pool, [](auto& value) { value.second *= 2; });
+
+        for (auto& [key, value] : map)
+        {
+            value *= 2;
+        }
+
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+
+        auto sum = parallel.map_reduce(pool, [](auto const& value) { return static_cast<long long>(value.second); }, std::plus<>(), 0LL);
+        long long expected_sum = 0;
+
+        for (auto& [key, value] : map)
+        {
+            expected_sum += value;
+        }
+
+        EXPECT_EQ(sum, expected_sum);
+
+        // Non-commutative reduce sees the keys in order
+        auto sorted = parallel.map_reduce(pool,
+                                          [](auto const& value) { return std::make_pair(value.first, value.first); },
+                                          [](std::optional<std::pair<int, int>> lhs, std::optional<std::pair<int, int>> rhs) -> std::optional<std::pair<int, int>>
+                                          {
+                                              if (!lhs || !rhs)
+                                              {
+                                                  return lhs ? lhs : rhs;
+                                              }
+
+                                              return lhs->second < rhs->first ? std::make_optional(std::make_pair(lhs->first, rhs->second)) : std::nullopt;
+                                          },
+                                          std::optional<std::pair<int, int>>());
+
+        ASSERT_TRUE(sorted.has_value());
+        EXPECT_EQ(sorted->first, map.begin()->first);
+        EXPECT_EQ(sorted->second, map.rbegin()->first);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int key = rand() % 100000;
+
+            if (rand() % 2)
+            {
+                parallel.emplace(key, i);
+                map.emplace(key, i);
+            }
+            else if (map.erase(key))
+            {
+                parallel.erase(key);
+            }
+        }
+
+        EXPECT_TRUE(std::equal(map.begin(), map.end(), parallel.cbegin_infix()));
+    }
+
+    EXPECT_THROW(pool.invoke([] {}, [] { throw std::runtime_error("forked"); }), std::runtime_error);
+
+    logger->trace("redBlackTreePositiveTests.test21 finished");
+}
+
+TEST(redBlackTreePositiveTests, test22)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test22 started");
+
+    srand(5);
+
+    for (size_t chunk_nodes : {size_t(0), size_t(64)})
+    {
+        red_black_tree<int, int> source(std::less<int>(), nullptr, logger.get());
+
+        if (chunk_nodes)
+        {
+            source.use_node_pool(chunk_nodes);
+            source.use_order_statistics();
+        }
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            source.emplace(rand() % 100000, i);
+        }
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            int key = rand() % 100000;
+
+            if (source.contains(key))
+            {
+                source.erase(key);
+            }
+        }
+
+        // The copy repeats the shape and the colors instead of inserting again
+        red_black_tree<int, int> copy(source);
+
+        ASSERT_EQ(copy.size(), source.size());
+
+        auto expected = source.begin_prefix();
+        auto it = copy.begin_prefix();
+
+        for (size_t i = 0; i < source.size(); ++i, ++it, ++expected)
+        {
+            ASSERT_EQ(it.depth(), expected.depth());
+            ASSERT_EQ(it->first, expected->first);
+            ASSERT_EQ(it->second, expected->second);
+            ASSERT_EQ(it.get_color(), expected.get_color());
+        }
+
+        if (chunk_nodes)
+        {
+            EXPECT_EQ(copy.nth(copy.size() / 2)->first, source.nth(source.size() / 2)->first);
+        }
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            copy.emplace(100000 + i, i);
+        }
+
+        EXPECT_EQ(copy.size(), source.size() + 1000);
+        EXPECT_FALSE(source.contains(100000));
+    }
+
+    logger->trace("redBlackTreePositiveTests.test22 finished");
+}
+
+TEST(redBlackTreePositiveTests, test23)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test23 started");
+
+    srand(7);
+
+    // Every size up to a few full levels of the implicit tree, then a large one
+    for (int count : {0, 1, 2, 3, 6, 7, 8, 15, 16, 17, 100, 5000})
+    {
+        red_black_tree<int, int> tree(std::less<int>(), nullptr, logger.get());
+        std::map<int, int> expected;
+
+        while (tree.size() < static_cast<size_t>(count))
+        {
+            int key = rand() % (count * 4 + 1);
+            tree.emplace(key, -key);
+            expected.emplace(key, -key);
+        }
+
+        auto frozen = tree.freeze();
+        auto same_pair = [](auto const &lhs, auto const &rhs) { return lhs.first == rhs.first && lhs.second == rhs.second; };
+
+        ASSERT_EQ(frozen.size(), expected.size());
+        EXPECT_TRUE(std::ranges::equal(frozen, expected, same_pair));
+        EXPECT_TRUE(std::ranges::equal(frozen | std::views::reverse, expected | std::views::reverse, same_pair));
+
+        for (int key = -1; key <= count * 4 + 1; ++key)
+        {
+            auto lower = expected.lower_bound(key);
+            auto upper = expected.upper_bound(key);
+            auto frozen_lower = frozen.lower_bound(key);
+            auto frozen_upper = frozen.upper_bound(key);
+
+            ASSERT_EQ(frozen_lower == frozen.end(), lower == expected.end());
+            ASSERT_EQ(frozen_upper == frozen.end(), upper == expected.end());
+
+            if (lower != expected.end())
+            {
+                ASSERT_EQ(frozen_lower->first, lower->first);
+            }
+
+            if (upper != expected.end())
+            {
+                ASSERT_EQ(frozen_upper->first, upper->first);
+            }
+
+            ASSERT_EQ(frozen.contains(key), expected.contains(key));
+        }
+    }
+
+    red_black_tree<int, int> tree(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        tree.emplace(i * 2, i);
+    }
+
+    auto frozen = tree.freeze();
+
+    // Same keys, new values: the layout is kept
+    tree.at(10) = 500;
+    EXPECT_FALSE(frozen.refresh(tree.cbegin_infix(), tree.cend_infix()));
+    EXPECT_EQ(frozen.at(10), 500);
+
+    tree.emplace(11, 11);
+    tree.erase(0);
+    EXPECT_TRUE(frozen.refresh(tree.cbegin_infix(), tree.cend_infix()));
+    EXPECT_EQ(frozen.size(), 100);
+    EXPECT_EQ(frozen.at(11), 11);
+    EXPECT_FALSE(frozen.contains(0));
+    EXPECT_EQ(frozen.find(12)->second, 6);
+    EXPECT_EQ(frozen.find(13), frozen.end());
+    EXPECT_THROW(frozen.at(13), std::out_of_range);
+
+    std::vector<std::pair<int, int>> unsorted{{1, 1}, {3, 3}, {2, 2}};
+    EXPECT_THROW(frozen.refresh(unsorted.begin(), unsorted.end()), std::invalid_argument);
+    EXPECT_TRUE(frozen.empty());
+
+    logger->trace("redBlackTreePositiveTests.test23 finished");
+}
+
+TEST(redBlackTreePositiveTests, test24)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }, false));
+
+    logger->trace("redBlackTreePositiveTests.test24 started");
+
+    srand(24);
+
+    concurrent_red_black_tree<int, int> tree(std::less<int>(), pp_allocator<std::pair<const int, int>>(), logger.get());
+    std::map<int, int> expected;
+
+    auto before = tree.read();
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        int key = rand() % 3000;
+
+        switch (rand() % 4)
+        {
+            case 0:
+                ASSERT_EQ(tree.emplace(key, i), expected.emplace(key, i).second);
+                break;
+            case 1:
+                ASSERT_EQ(tree.insert_or_assign({key, i}), !expected.contains(key));
+                expected.insert_or_assign(key, i);
+                break;
+            case 2:
+                ASSERT_EQ(tree.erase(key), expected.erase(key) == 1);
+                break;
+            default:
+            {
+                auto value = tree.lookup(key);
+                auto expected_it = expected.find(key);
+
+                ASSERT_EQ(value.has_value(), expected_it != expected.end());
+
+                if (value)
+                {
+                    ASSERT_EQ(*value, expected_it->second);
+                }
+
+                break;
+            }
+        }
+    }
+
+    // The snapshot taken first still sees the empty version
+    EXPECT_TRUE(before.empty());
+    EXPECT_EQ(before.begin(), before.end());
+
+    auto view = tree.read();
+
+    ASSERT_EQ(tree.size(), expected.size());
+    EXPECT_TRUE(std::ranges::equal(view, expected, [](auto const &lhs, auto const &rhs)
+    {
+        return lhs.first == rhs.first && lhs.second == rhs.second;
+    }));
+
+    for (int key = -1; key <= 3001; key += 7)
+    {
+        auto lower = expected.lower_bound(key);
+        auto upper = expected.upper_bound(key);
+
+        ASSERT_EQ(view.lower_bound(key) == view.end(), lower == expected.end());
+        ASSERT_EQ(view.upper_bound(key) == view.end(), upper == expected.end());
+
+        if (lower != expected.end())
+        {
+            ASSERT_EQ(view.lower_bound(key)->first, lower->first);
+        }
+
+        if (upper != expected.end())
+        {
+            ASSERT_EQ(view.upper_bound(key)->first, upper->first);
+        }
+
+        ASSERT_EQ(view.contains(key), expected.contains(key));
+    }
+
+    EXPECT_THROW(view.at(-1), std::out_of_range);
+
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(view.find(expected.begin()->first)->second, expected.begin()->second);
+
+    // Readers run while a writer changes odd keys, even keys are never touched
+    for (int key = 0; key < 4000; key += 2)
+    {
+        tree.emplace(key, key * 10);
+    }
+
+    std::atomic<bool> stop = false;
+    std::atomic<size_t> failures = 0;
+    std::vector<std::thread> readers;
+
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&tree, &stop, &failures, t]
+        {
+            unsigned seed = t;
+
+            while (!stop.load())
+            {
+                int key = (rand_r(&seed) % 2000) * 2;
+
+                if (tree.lookup(key) != key * 10)
+                {
+                    ++failures;
+                }
+
+                auto reader_view = tree.read();
+                int previous = -1;
+                size_t even = 0;
+
+                for (auto const &[k, v] : reader_view)
+                {
+                    if (k <= previous)
+                    {
+                        ++failures;
+                    }
+
+                    previous = k;
+                    even += k % 2 == 0;
+                }
+
+                if (even != 2000)
+                {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        int key = (rand() % 2000) * 2 + 1;
+
+        if (rand() % 2)
+        {
+            tree.emplace(key, key);
+        }
+        else
+        {
+            tree.erase(key);
+        }
+    }
+
+    stop = true;
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+
+    logger->trace("redBlackTreePositiveTests.test24 finished");
+}
+
+TEST(redBlackTreePositiveTests, test25)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test25 started");
+
+    srand(25);
+
+    for (int pattern = 0; pattern < 3; ++pattern)
+    {
+        red_black_tree<int, int> plain(std::less<int>(), nullptr, logger.get());
+        red_black_tree<int, int> hinted(std::less<int>(), nullptr, logger.get());
+
+        // Sorted, nearly sorted and random ingest; the place of a new key does not depend on the hint,
+        // so rebalancing has to leave both trees in the same shape
+        auto last = hinted.end();
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int key = pattern == 0 ? i : pattern == 1 ? i + rand() % 16 : rand() % 100000;
+
+            plain.emplace(key, i);
+
+            if (i % 2)
+            {
+                last = hinted.emplace_hint(last, key, i);
+            }
+            else
+            {
+                last = hinted.insert(hinted.end(), std::make_pair(key, i));
+            }
+
+            ASSERT_EQ(last->first, key);
+        }
+
+        ASSERT_EQ(hinted.size(), plain.size());
+
+        auto expected = plain.begin_prefix();
+
+        for (auto it = hinted.begin_prefix(); it != hinted.end_prefix(); ++it, ++expected)
+        {
+            ASSERT_EQ(it.depth(), expected.depth());
+            ASSERT_EQ(it->first, expected->first);
+            ASSERT_EQ(it->second, expected->second);
+            ASSERT_EQ(it.get_color(), expected.get_color());
+        }
+
+        auto from = hinted.begin();
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            int key = rand() % 100020;
+            auto found = hinted.find_from(from, key);
+
+            ASSERT_TRUE(found == hinted.find(key));
+
+            if (found != hinted.end())
+            {
+                from = found;
+            }
+        }
+    }
+
+    logger->trace("redBlackTreePositiveTests.test25 finished");
+}
+
+TEST(redBlackTreePositiveTests, test26)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test26 started");
+
+    red_black_tree<std::string, int, std::less<>> tree(std::less<>(), nullptr, logger.get());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.emplace("a long key that does not fit in place " + std::to_string(i * 2), i);
+    }
+
+    // Lookups by std::string_view and by const char* find the same nodes as by std::string
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string key = "a long key that does not fit in place " + std::to_string(i);
+        std::string_view view = key;
+
+        ASSERT_TRUE(tree.find(view) == tree.find(key));
+        ASSERT_TRUE(tree.find(key.c_str()) == tree.find(key));
+        ASSERT_TRUE(tree.lower_bound(view) == tree.lower_bound(key));
+        ASSERT_TRUE(tree.upper_bound(view) == tree.upper_bound(key));
+        ASSERT_EQ(tree.contains(view), i % 2 == 0);
+    }
+
+    auto const &view_tree = tree;
+    EXPECT_EQ(view_tree.find(std::string_view("a long key that does not fit in place 10"))->second, 5);
+
+    logger->trace("redBlackTreePositiveTests.test26 finished");
+}
+
+TEST(redBlackTreePositiveTests, test27)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "red_black_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("redBlackTreePositiveTests.test27 started");
+
+    concurrent_red_black_tree<int, int> tree(std::less<int>(), pp_allocator<std::pair<const int, int>>(), logger.get());
+    std::vector<concurrent_red_black_tree<int, int>::snapshot> views;
+
+    // More live snapshots than one block of reader slots holds, each of them sees its own version
+    for (int i = 0; i < 300; ++i)
+    {
+        views.push_back(tree.read());
+        tree.emplace(i, i);
+    }
+
+    for (int i = 0; i < 300; ++i)
+    {
+        ASSERT_EQ(std::ranges::distance(views[i]), i);
+        ASSERT_FALSE(views[i].contains(i));
+    }
+
+    // Slots of destroyed snapshots are taken again
+    views.clear();
+
+    for (int i = 0; i < 300; ++i)
+    {
+        views.push_back(tree.read());
+        tree.erase(i);
+    }
+
+    for (int i = 0; i < 300; ++i)
+    {
+        ASSERT_EQ(std::ranges::distance(views[i]), 300 - i);
+        ASSERT_TRUE(views[i].contains(i));
+    }
+
+    logger->trace("redBlackTreePositiveTests.test27 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -11,17 +11,27 @@ namespace __detail
     template<typename tkey, typename tvalue, typename compare>
     class bst_impl<tkey, tvalue, compare, SPG_TAG>
     {
+        friend class binary_search_tree<tkey, tvalue, compare, SPG_TAG>;
+
         template<class ...Args>
         static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node);
+
+        // Copies the subtree size along with the data
+        static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* clone_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+                                                                                     const binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* source,
+                                                                                     binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* parent);
 
         //Does not invalidate node*, needed for splay tree
         static void post_search(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**){}
 
-        //Does not invalidate node*
+        // Counts the new leaf on its path and rebuilds the highest subtree that lost alpha-balance
         static void post_insert(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
+        // A perfectly balanced tree is alpha-balanced for every alpha, only sizes are filled in
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont);
+
         static void erase(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPG_TAG>& rhs) noexcept;
@@ -36,6 +46,7 @@ class scapegoat_tree final:
 private:
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPG_TAG>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::SPG_TAG>;
     
     struct node final:
         parent::node
@@ -96,11 +107,42 @@ public:
 
 public:
     
+    /** A subtree is rebuilt once one of its children holds more than alpha of its nodes.
+     *  Lower alpha keeps the tree shallower for more rebuilds, 0.5 allows only perfectly balanced subtrees.
+     *  Takes effect from the next insert or erase. Throws std::invalid_argument unless 0.5 <= alpha < 1
+     */
     void setup_alpha(double alpha);
 
+    double get_alpha() const noexcept;
+
+    // Subtrees rebuilt since construction, the whole tree counts as one
+    size_t rebuild_count() const noexcept;
+
 private:
 
     double _alpha;
+
+    // Largest size since the last rebuild of the whole tree
+    size_t _max_size = 0;
+
+    size_t _rebuilds = 0;
+
+    static size_t subtree_size(typename parent::node* n) noexcept;
+
+    // Adds delta to the sizes from n up to the root, returns the highest node that lost alpha-balance
+    node* update_path(typename parent::node* n, ptrdiff_t delta) noexcept;
+
+    // Takes n out of the tree and rebalances, n itself is left to the caller
+    void unlink(node* n) noexcept;
+
+    /** Relinks the subtree of n into a perfectly balanced one without extra memory:
+     *  right rotations flatten it into a vine in key order, then the vine is linked back
+     *  with the middle node as the root of every subtree
+     */
+    void rebuild(node* n) noexcept;
+
+    // Links the first count nodes of the vine starting at head, head moves past them
+    static node* link_vine(node*& head, size_t count, typename parent::node* parent) noexcept;
 };
 
 template<typename compare, typename U, typename iterator>
@@ -118,37 +160,154 @@ scapegoat_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compar
         pp_allocator<U> alloc = pp_allocator<U>(),
         logger* log = nullptr, double alpha = 0.7) -> scapegoat_tree<tkey, tvalue, compare>;
 
+namespace __detail
+{
+    template<typename tkey, typename tvalue, typename compare>
+    template<class ...Args>
+    binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::create_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, Args&& ...args)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+        return cont._pool.template new_object<node_type>(cont._allocator, std::forward<Args>(args)...);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+
+        if (node && *node)
+        {
+            cont._pool.delete_object(cont._allocator, static_cast<node_type*>(*node));
+            *node = nullptr;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::clone_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+            const binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* source,
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* parent)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+
+        auto* new_node = static_cast<node_type*>(create_node(cont, parent, source->data));
+        new_node->size = static_cast<const node_type*>(source)->size;
+        return new_node;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node)
+    {
+        if (!node || !*node)
+        {
+            return;
+        }
+
+        auto& tree = static_cast<scapegoat_tree<tkey, tvalue, compare>&>(cont);
+        auto* scapegoat = tree.update_path((*node)->parent, 1);
+
+        tree._max_size = std::max(tree._max_size, cont._size);
+
+        if (scapegoat)
+        {
+            tree.rebuild(scapegoat);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::post_build(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+
+        auto& tree = static_cast<scapegoat_tree<tkey, tvalue, compare>&>(cont);
+
+        // Post-order walk along parent links, children are done before their parent
+        auto* current = cont._root;
+        typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* previous = nullptr;
+
+        while (current)
+        {
+            if (previous == current->parent && current->left_subtree)
+            {
+                previous = current;
+                current = current->left_subtree;
+            }
+            else if (previous != current->right_subtree && current->right_subtree)
+            {
+                previous = current;
+                current = current->right_subtree;
+            }
+            else
+            {
+                static_cast<node_type*>(current)->recalculate_size();
+                previous = current;
+                current = current->parent;
+            }
+        }
+
+        tree._max_size = cont._size;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::erase(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+
+        if (node && *node)
+        {
+            static_cast<scapegoat_tree<tkey, tvalue, compare>&>(cont).unlink(static_cast<node_type*>(*node));
+            delete_node(cont, node);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::swap(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& lhs,
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& rhs) noexcept
+    {
+        // Only the base part: copy assignment swaps with a temporary binary_search_tree,
+        // the scapegoat fields are assigned by the scapegoat_tree operators
+        std::swap(lhs._root, rhs._root);
+        std::swap(lhs._logger, rhs._logger);
+        std::swap(lhs._size, rhs._size);
+        std::swap(lhs._allocator, rhs._allocator);
+        lhs._pool.swap(rhs._pool);
+        std::swap(lhs._order_statistics, rhs._order_statistics);
+    }
+}
+
 // region implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, tvalue &&value_)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, tvalue &&value_)", "your code should be here...");
-}
+    : parent::node(nullptr, key_, std::move(value_)), size(1) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, const tvalue& value_)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, const tvalue& value_)", "your code should be here...");
-}
+    : parent::node(nullptr, key_, value_), size(1) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<class ...Args>
 scapegoat_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<class ...Args> scapegoat_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)", "your code should be here...");
-}
+    : parent::node(par, std::forward<Args>(args)...), size(1) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 void scapegoat_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> void scapegoat_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept ", "your code should be here...");
+    size = subtree_size(this->left_subtree) + subtree_size(this->right_subtree) + 1;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 bool scapegoat_tree<tkey, tvalue, compare>::node::is_disbalanced(double alpha) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> bool scapegoat_tree<tkey, tvalue, compare>::node::is_disbalanced(double alpha) noexcept ", "your code should be here...");
+    size_t heavier = std::max(subtree_size(this->left_subtree), subtree_size(this->right_subtree));
+    return static_cast<double>(heavier) > alpha * static_cast<double>(size);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -156,9 +315,9 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger *log,
-        double alpha)
+        double alpha) : parent(comp, alloc, log)
 {
-    throw not_implemented("emplate<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(const compare& comp, pp_allocator<value_type> alloc, logger *log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -166,11 +325,13 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger *log,
-        double alpha)
+        double alpha) : parent(comp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(pp_allocator<value_type> alloc, const compare& comp, logger *log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
+// Range constructors insert after alpha is set, post_insert of the base constructors would read it uninitialized
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
 scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
@@ -179,9 +340,10 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<input_iterator_for_pair<tkey, tvalue> iterator> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(iterator begin, iterator end, const compare& cmp, pp_allocator<value_type> alloc, logger* log,double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    this->insert(begin, end);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -191,9 +353,10 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<std::ranges::input_range Range>scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(Range&& range, const compare& cmp, pp_allocator<value_type> alloc, logger* log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    this->insert_range(std::forward<Range>(range));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -202,47 +365,264 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    this->insert(data.begin(), data.end());
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::~scapegoat_tree() noexcept
+scapegoat_tree<tkey, tvalue, compare>::~scapegoat_tree() noexcept {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other)
+    : parent(other), _alpha(other._alpha), _max_size(other._size) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::~scapegoat_tree() noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        parent::operator=(other);
+        _alpha = other._alpha;
+        _max_size = other._size;
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other)
+scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree &&other) noexcept
+    : parent(std::move(other)), _alpha(other._alpha), _max_size(std::exchange(other._max_size, 0)), _rebuilds(other._rebuilds) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree &&other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other)", "your code should be here...");
+    if (this != &other)
+    {
+        // The base swaps the nodes, other keeps the old ones together with the fields that describe them
+        parent::operator=(std::move(other));
+        std::swap(_alpha, other._alpha);
+        std::swap(_max_size, other._max_size);
+        std::swap(_rebuilds, other._rebuilds);
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other)
+void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other) ", "your code should be here...");
+    if (!(alpha >= 0.5 && alpha < 1))
+    {
+        throw std::invalid_argument("Alpha must be in [0.5, 1)");
+    }
+
+    _alpha = alpha;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree &&other) noexcept
+double scapegoat_tree<tkey, tvalue, compare>::get_alpha() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree &&other) noexcept", "your code should be here...");
+    return _alpha;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree &&other) noexcept
+size_t scapegoat_tree<tkey, tvalue, compare>::rebuild_count() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree &&other) noexcept", "your code should be here...");
+    return _rebuilds;
 }
 
+// region rebalancing implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
-void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)
+size_t scapegoat_tree<tkey, tvalue, compare>::subtree_size(typename parent::node* n) noexcept
+{
+    return n ? static_cast<node*>(n)->size : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename scapegoat_tree<tkey, tvalue, compare>::node* scapegoat_tree<tkey, tvalue, compare>::update_path(
+        typename parent::node* n,
+        ptrdiff_t delta) noexcept
+{
+    node* scapegoat = nullptr;
+
+    for (; n; n = n->parent)
+    {
+        auto* current = static_cast<node*>(n);
+        current->size += delta;
+
+        if (current->is_disbalanced(_alpha))
+        {
+            scapegoat = current;
+        }
+    }
+
+    return scapegoat;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void scapegoat_tree<tkey, tvalue, compare>::unlink(node* n) noexcept
+{
+    using base_node = typename parent::node;
+
+    // Lowest node whose subtree loses a node
+    base_node* lowest;
+    base_node* replacement;
+
+    if (!n->left_subtree || !n->right_subtree)
+    {
+        replacement = n->left_subtree ? n->left_subtree : n->right_subtree;
+        lowest = n->parent;
+    }
+    else
+    {
+        // The in-order predecessor takes the place and the size of n
+        base_node* predecessor = n->left_subtree;
+
+        while (predecessor->right_subtree)
+        {
+            predecessor = predecessor->right_subtree;
+        }
+
+        if (predecessor != n->left_subtree)
+        {
+            lowest = predecessor->parent;
+            lowest->right_subtree = predecessor->left_subtree;
+
+            if (predecessor->left_subtree)
+            {
+                predecessor->left_subtree->parent = lowest;
+            }
+
+            predecessor->left_subtree = n->left_subtree;
+            predecessor->left_subtree->parent = predecessor;
+        }
+        else
+        {
+            lowest = predecessor;
+        }
+
+        predecessor->right_subtree = n->right_subtree;
+        predecessor->right_subtree->parent = predecessor;
+        static_cast<node*>(predecessor)->size = n->size;
+        replacement = predecessor;
+    }
+
+    if (replacement)
+    {
+        replacement->parent = n->parent;
+    }
+
+    if (!n->parent)
+    {
+        this->_root = replacement;
+    }
+    else if (n->parent->left_subtree == n)
+    {
+        n->parent->left_subtree = replacement;
+    }
+    else
+    {
+        n->parent->right_subtree = replacement;
+    }
+
+    node* scapegoat = update_path(lowest, -1);
+    --this->_size;
+
+    // Deletions only shrink subtrees, the whole tree is rebuilt once it lost enough since the last time
+    if (this->_root && static_cast<double>(this->_size) < _alpha * static_cast<double>(_max_size))
+    {
+        rebuild(static_cast<node*>(this->_root));
+    }
+    else if (scapegoat)
+    {
+        rebuild(scapegoat);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void scapegoat_tree<tkey, tvalue, compare>::rebuild(node* n) noexcept
+{
+    using base_node = typename parent::node;
+
+    base_node* above = n->parent;
+    size_t count = n->size;
+
+    // Rotating every left child up leaves a vine linked through right_subtree, in key order
+    base_node* vine = n;
+    base_node** link = &vine;
+
+    while (*link)
+    {
+        base_node* current = *link;
+
+        if (current->left_subtree)
+        {
+            base_node* left = current->left_subtree;
+            current->left_subtree = left->right_subtree;
+            left->right_subtree = current;
+            *link = left;
+        }
+        else
+        {
+            link = &current->right_subtree;
+        }
+    }
+
+    auto* head = static_cast<node*>(vine);
+    node* root = link_vine(head, count, above);
+
+    if (!above)
+    {
+        this->_root = root;
+        _max_size = count;
+    }
+    else if (above->left_subtree == n)
+    {
+        above->left_subtree = root;
+    }
+    else
+    {
+        above->right_subtree = root;
+    }
+
+    ++_rebuilds;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename scapegoat_tree<tkey, tvalue, compare>::node* scapegoat_tree<tkey, tvalue, compare>::link_vine(
+        node*& head,
+        size_t count,
+        typename parent::node* parent) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)", "your code should be here...");
+    if (count == 0)
+    {
+        return nullptr;
+    }
+
+    // Same shape as binary_search_tree::link_balanced: count / 2 nodes go to the left
+    node* left = link_vine(head, count / 2, nullptr);
+    node* root = head;
+    head = static_cast<node*>(root->right_subtree);
+
+    root->parent = parent;
+    root->left_subtree = left;
+
+    if (left)
+    {
+        left->parent = root;
+    }
+
+    root->right_subtree = link_vine(head, count - count / 2 - 1, root);
+    root->size = count;
+
+    return root;
 }
 
+// endregion rebalancing implementation
+
 // endregion implementation
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SCAPEGOAT_TREE_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SCAPEGOAT_TREE_H
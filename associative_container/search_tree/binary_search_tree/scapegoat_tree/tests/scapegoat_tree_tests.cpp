@@ -2,7 +2,9 @@
 #include <scapegoat_tree.h>
 #include <logger_builder.h>
 #include <client_logger_builder.h>
+#include <cmath>
 #include <iostream>
+#include <map>
 
 
 logger *create_logger(
@@ -517,6 +519,173 @@ TEST(scapegoatTreePositiveTests, test10)
     logger->trace("scapegoatTreePositiveTests.test10 finished");
 }
 
+TEST(scapegoatTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "scapegoat_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+    
+    logger->trace("scapegoatTreePositiveTests.test11 started");
+
+    auto max_depth = [](scapegoat_tree<int, int> const &tree)
+    {
+        size_t depth = 0;
+
+        for (auto it = tree.cbegin_infix(); it != tree.cend_infix(); ++it)
+        {
+            depth = std::max(depth, it.depth());
+        }
+
+        return depth;
+    };
+
+    srand(42);
+
+    for (double alpha : {0.55, 0.7, 0.9})
+    {
+        scapegoat_tree<int, int> sg(std::less<int>(), nullptr, logger.get(), alpha);
+        std::map<int, int> expected;
+
+        // Ascending keys force a rebuild every few inserts, the height stays within log of the size
+        for (int i = 0; i < 2000; ++i)
+        {
+            sg.emplace(i, i);
+            expected.emplace(i, i);
+        }
+
+        EXPECT_GT(sg.rebuild_count(), 0);
+        EXPECT_LE(max_depth(sg), std::log(2000.0) / std::log(1 / alpha) + 1);
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int key = rand() % 4000;
+
+            if (rand() % 2)
+            {
+                sg.emplace_or_assign(key, i);
+                expected.insert_or_assign(key, i);
+            }
+            else
+            {
+                ASSERT_EQ(sg.erase(key), expected.erase(key));
+            }
+        }
+
+        std::vector<std::pair<int, int>> actual(sg.begin(), sg.end());
+
+        ASSERT_EQ(sg.size(), expected.size());
+        EXPECT_TRUE(std::ranges::equal(actual, expected, [](auto const &lhs, auto const &rhs)
+        {
+            return lhs.first == rhs.first && lhs.second == rhs.second;
+        }));
+
+        // Erasing most keys rebuilds the whole tree instead of leaving it sparse
+        for (int key = 0; key < 4000; ++key)
+        {
+            if (key % 16)
+            {
+                sg.erase(key);
+            }
+        }
+
+        EXPECT_LE(max_depth(sg), std::log(static_cast<double>(sg.size())) / std::log(1 / alpha) + 2);
+
+        scapegoat_tree<int, int> copy(sg);
+        EXPECT_EQ(copy.get_alpha(), alpha);
+        EXPECT_TRUE(std::ranges::equal(std::vector<std::pair<int, int>>(copy.begin(), copy.end()),
+                                       std::vector<std::pair<int, int>>(sg.begin(), sg.end())));
+    }
+
+    std::vector<std::pair<int, int>> sorted;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        sorted.emplace_back(i, i);
+    }
+
+    scapegoat_tree<int, int> built(sorted.begin(), sorted.end(), std::less<int>(), nullptr, logger.get(), 0.6);
+    EXPECT_EQ(built.size(), 100);
+    EXPECT_LE(max_depth(built), 7);
+
+    built.erase(50);
+    EXPECT_FALSE(built.contains(50));
+    EXPECT_THROW(built.setup_alpha(0.4), std::invalid_argument);
+    EXPECT_THROW(built.setup_alpha(1), std::invalid_argument);
+
+    logger->trace("scapegoatTreePositiveTests.test11 finished");
+}
+
+TEST(scapegoatTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                         {
+                                                                 {
+                                                                         "scapegoat_tree_tests_logs.txt",
+                                                                         logger::severity::trace
+                                                                 },
+                                                         }));
+
+    logger->trace("scapegoatTreePositiveTests.test12 started");
+
+    auto contents = [](scapegoat_tree<int, int> const &tree)
+    {
+        return std::vector<std::pair<int, int>>(tree.begin(), tree.end());
+    };
+
+    scapegoat_tree<int, int> source(std::less<int>(), nullptr, logger.get(), 0.6);
+    std::vector<std::pair<int, int>> expected;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        source.emplace(i, i * 2);
+        expected.emplace_back(i, i * 2);
+    }
+
+    // Copy assignment takes the contents and alpha of the source and leaves the source as it was
+    scapegoat_tree<int, int> copy(std::less<int>(), nullptr, logger.get(), 0.9);
+    copy.emplace(-1, -1);
+    copy = source;
+
+    EXPECT_EQ(copy.get_alpha(), 0.6);
+    EXPECT_EQ(contents(copy), expected);
+    EXPECT_EQ(source.get_alpha(), 0.6);
+    EXPECT_EQ(contents(source), expected);
+
+    // Move assignment takes them as well, the moved from tree keeps a usable tree
+    scapegoat_tree<int, int> moved(std::less<int>(), nullptr, logger.get(), 0.9);
+    moved.emplace(-1, -1);
+    moved = std::move(source);
+
+    EXPECT_EQ(moved.get_alpha(), 0.6);
+    EXPECT_EQ(contents(moved), expected);
+
+    source.clear();
+    source.emplace(1, 1);
+    EXPECT_TRUE(source.contains(1));
+
+    // The assigned trees keep rebalancing after erasures and insertions
+    for (int i = 0; i < 500; i += 2)
+    {
+        copy.erase(i);
+        moved.erase(i);
+    }
+
+    for (int i = 500; i < 1000; ++i)
+    {
+        copy.emplace(i, i);
+        moved.emplace(i, i);
+    }
+
+    EXPECT_EQ(copy.size(), 750);
+    EXPECT_EQ(contents(copy), contents(moved));
+
+    logger->trace("scapegoatTreePositiveTests.test12 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -10,17 +10,27 @@ namespace __detail
     template<typename tkey, typename tvalue, typename compare>
     class bst_impl<tkey, tvalue, compare, SPL_TAG>
     {
+        friend class binary_search_tree<tkey, tvalue, compare, SPL_TAG>;
+
         template<class ...Args>
         static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node);
+
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* clone_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+                                                                                     const binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* source,
+                                                                                     binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* parent);
 
-        //Does not invalidate node*, needed for splay tree
+        // Lookups of splay_tree splay by themselves, see splay_tree::access
         static void post_search(binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**){}
 
-        //Does not invalidate node*
+        // Splays the new node in the mode of the tree
         static void post_insert(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
 
+        // Any shape is a valid splay tree
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont) {}
+
+        // Splays the node to the root, then joins its subtrees under the maximum of the left one
         static void erase(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPL_TAG>& rhs) noexcept;
@@ -32,10 +42,41 @@ class splay_tree final: public binary_search_tree<tkey, tvalue, compare, __detai
 {
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::SPL_TAG>;
+
+    using node = typename parent::node;
+
 public:
 
     using value_type = parent::value_type;
 
+    using infix_iterator = typename parent::infix_iterator;
+    using infix_const_iterator = typename parent::infix_const_iterator;
+
+    /** How an access restructures the tree:
+     *  bottom_up - the found node is splayed to the root along parent links after the search;
+     *  top_down - one pass from the root searches and splays at once, splitting the path into two side trees;
+     *  semi - zig-zig steps rotate only the parent and continue from it, so the node rises about halfway
+     *  and far fewer links are written
+     */
+    enum class splay_mode
+    {
+        bottom_up,
+        top_down,
+        semi
+    };
+
+private:
+
+    splay_mode _mode = splay_mode::bottom_up;
+
+    // Lookups restructure the tree only on every _period-th call
+    size_t _period = 1;
+
+    size_t _accesses = 0;
+
+public:
+
     explicit splay_tree(
             const compare& comp = compare(),
             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
@@ -73,6 +114,74 @@ public:
     
     splay_tree &operator=(splay_tree &&other) noexcept;
 
+public:
+
+    /** Lookups through non-const find, at, operator[], lower_bound and upper_bound splay
+     *  only on every period-th call, the others are plain read-only descents. Inserts and erases always splay.
+     *  Throws std::invalid_argument if period is 0
+     */
+    void set_splay_mode(splay_mode mode, size_t period = 1);
+
+    splay_mode get_splay_mode() const noexcept;
+
+    size_t get_splay_period() const noexcept;
+
+    tvalue& at(const tkey& key);
+
+    tvalue& operator[](const tkey& key);
+    tvalue& operator[](tkey&& key);
+
+    infix_iterator find(const tkey& key);
+
+    infix_iterator lower_bound(const tkey& key);
+
+    infix_iterator upper_bound(const tkey& key);
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_iterator find(const key_like& key);
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_iterator lower_bound(const key_like& key);
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    infix_iterator upper_bound(const key_like& key);
+
+    // Const lookups never restructure the tree
+    using parent::at;
+    using parent::find;
+    using parent::lower_bound;
+    using parent::upper_bound;
+
+private:
+
+    // Last node on the search path of key, the key itself or one of its neighbours
+    template<typename key_like>
+    node* descend(const key_like& key) const noexcept;
+
+    // Searches for key and splays according to mode and period, returns the node the search ended at
+    template<typename key_like>
+    node* access(const key_like& key);
+
+    // Moves n up according to mode, the node is never top-down splayed by a different key
+    void splay(node* n);
+
+    // Rotates n over its parent
+    static void rotate_up(node* n) noexcept;
+
+    // Bottom-up splay of n to the top of its subtree
+    static void splay_to_top(node* n) noexcept;
+
+    static void semi_splay(node* n) noexcept;
+
+    /** Top-down splay of the detached subtree rooted at subtree_root for key,
+     *  afterwards subtree_root is the last node on the search path
+     */
+    template<typename key_like>
+    void top_down_splay(node*& subtree_root, const key_like& key) const noexcept;
+
+    // Splays n to the root and replaces it by the join of its subtrees, n itself is left to the caller
+    void unlink(node* n);
+
 };
 
 template<typename compare, typename U, typename iterator>
@@ -90,25 +199,92 @@ splay_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& c
         pp_allocator<U> alloc = pp_allocator<U>(),
         logger* log = nullptr) -> splay_tree<tkey, tvalue, compare>;
 
+namespace __detail
+{
+    template<typename tkey, typename tvalue, typename compare>
+    template<class ...Args>
+    binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* bst_impl<tkey, tvalue, compare, SPL_TAG>::create_node(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, Args&& ...args)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+        return cont._pool.template new_object<node_type>(cont._allocator, std::forward<Args>(args)...);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+
+        if (node && *node)
+        {
+            cont._pool.delete_object(cont._allocator, static_cast<node_type*>(*node));
+            *node = nullptr;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* bst_impl<tkey, tvalue, compare, SPL_TAG>::clone_node(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            const binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* source,
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* parent)
+    {
+        return create_node(cont, parent, source->data);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node)
+    {
+        if (node && *node)
+        {
+            static_cast<splay_tree<tkey, tvalue, compare>&>(cont).splay(*node);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::erase(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node)
+    {
+        if (node && *node)
+        {
+            static_cast<splay_tree<tkey, tvalue, compare>&>(cont).unlink(*node);
+            delete_node(cont, node);
+            --cont._size;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::swap(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& lhs,
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& rhs) noexcept
+    {
+        std::swap(lhs._root, rhs._root);
+        std::swap(lhs._logger, rhs._logger);
+        std::swap(lhs._size, rhs._size);
+        std::swap(lhs._allocator, rhs._allocator);
+        lhs._pool.swap(rhs._pool);
+        std::swap(lhs._order_statistics, rhs._order_statistics);
+    }
+}
+
 // region implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare>::splay_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
-        logger *log)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(const compare& comp, pp_allocator<value_type> alloc, logger *log)", "your code should be here...");
-}
+        logger *log) : parent(comp, alloc, log) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare>::splay_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
-        logger *log)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(pp_allocator<value_type> alloc, const compare& comp, logger *log)", "your code should be here...");
-}
+        logger *log) : parent(comp, alloc, log) {}
+
+// Range constructors insert in the body, post_insert of the base constructors would splay a splay_tree not yet constructed
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
@@ -117,9 +293,9 @@ splay_tree<tkey, tvalue, compare>::splay_tree(
         iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
+        logger* log) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<input_iterator_for_pair<tkey, tvalue> iterator>splay_tree<tkey, tvalue, compare>::splay_tree(iterator begin,iterator end,const compare& cmp,pp_allocator<value_type> alloc,logger* log)", "your code should be here...");
+    this->insert(begin, end);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -128,9 +304,9 @@ splay_tree<tkey, tvalue, compare>::splay_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
+        logger* log) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<std::ranges::input_range Range> splay_tree<tkey, tvalue, compare>::splay_tree(Range&& range, const compare& cmp, pp_allocator<value_type> alloc, logger* log)", "your code should be here...");
+    this->insert_range(std::forward<Range>(range));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -138,41 +314,516 @@ splay_tree<tkey, tvalue, compare>::splay_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
+        logger* log) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* log)", "your code should be here...");
+    this->insert(data.begin(), data.end());
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare>::~splay_tree() noexcept
+splay_tree<tkey, tvalue, compare>::~splay_tree() noexcept {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree const &other) : parent(other), _mode(other._mode), _period(other._period) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::~splay_tree() noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        parent::operator=(other);
+        _mode = other._mode;
+        _period = other._period;
+        _accesses = 0;
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree const &other)
+splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree &&other) noexcept : parent(std::move(other)), _mode(other._mode), _period(other._period) {}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree &&other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree const &other)", "your code should be here...");
+    if (this != &other)
+    {
+        parent::operator=(std::move(other));
+        _mode = other._mode;
+        _period = other._period;
+        _accesses = 0;
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree const &other)
+void splay_tree<tkey, tvalue, compare>::set_splay_mode(splay_mode mode, size_t period)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree const &other)", "your code should be here...");
+    if (period == 0)
+    {
+        throw std::invalid_argument("Splay period must be positive");
+    }
+
+    _mode = mode;
+    _period = period;
+    _accesses = 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree &&other) noexcept
+typename splay_tree<tkey, tvalue, compare>::splay_mode splay_tree<tkey, tvalue, compare>::get_splay_mode() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree &&other) noexcept", "your code should be here...");
+    return _mode;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
-splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree &&other) noexcept
+size_t splay_tree<tkey, tvalue, compare>::get_splay_period() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree &&other) noexcept", "your code should be here...");
+    return _period;
 }
 
+// region lookups implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+tvalue& splay_tree<tkey, tvalue, compare>::at(const tkey& key)
+{
+    auto it = find(key);
+
+    if (it == this->end())
+    {
+        throw std::out_of_range("Key not found");
+    }
+
+    return it->second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+tvalue& splay_tree<tkey, tvalue, compare>::operator[](const tkey& key)
+{
+    return at(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+tvalue& splay_tree<tkey, tvalue, compare>::operator[](tkey&& key)
+{
+    return at(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename splay_tree<tkey, tvalue, compare>::infix_iterator splay_tree<tkey, tvalue, compare>::find(const tkey& key)
+{
+    node* n = access(key);
+
+    if (!n || this->compare_keys(key, n->data.first) || this->compare_keys(n->data.first, key))
+    {
+        return this->end();
+    }
+
+    return infix_iterator(n);
+}
+
+// The search ends at the key or at a neighbour of it, rotations keep the in-order position of that node
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename splay_tree<tkey, tvalue, compare>::infix_iterator splay_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)
+{
+    node* n = access(key);
+    infix_iterator it(n);
+
+    return n && this->compare_keys(n->data.first, key) ? ++it : it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename splay_tree<tkey, tvalue, compare>::infix_iterator splay_tree<tkey, tvalue, compare>::upper_bound(const tkey& key)
+{
+    node* n = access(key);
+    infix_iterator it(n);
+
+    return n && !this->compare_keys(key, n->data.first) ? ++it : it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename splay_tree<tkey, tvalue, compare>::infix_iterator splay_tree<tkey, tvalue, compare>::find(const key_like& key)
+{
+    node* n = access(key);
+
+    if (!n || this->compare_keys(key, n->data.first) || this->compare_keys(n->data.first, key))
+    {
+        return this->end();
+    }
+
+    return infix_iterator(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename splay_tree<tkey, tvalue, compare>::infix_iterator splay_tree<tkey, tvalue, compare>::lower_bound(const key_like& key)
+{
+    node* n = access(key);
+    infix_iterator it(n);
+
+    return n && this->compare_keys(n->data.first, key) ? ++it : it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename splay_tree<tkey, tvalue, compare>::infix_iterator splay_tree<tkey, tvalue, compare>::upper_bound(const key_like& key)
+{
+    node* n = access(key);
+    infix_iterator it(n);
+
+    return n && !this->compare_keys(key, n->data.first) ? ++it : it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like>
+typename splay_tree<tkey, tvalue, compare>::node* splay_tree<tkey, tvalue, compare>::descend(const key_like& key) const noexcept
+{
+    node* current = this->_root;
+    node* last = nullptr;
+
+    while (current)
+    {
+        last = current;
+
+        if (this->compare_keys(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (this->compare_keys(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return last;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like>
+typename splay_tree<tkey, tvalue, compare>::node* splay_tree<tkey, tvalue, compare>::access(const key_like& key)
+{
+    if (++_accesses < _period)
+    {
+        return descend(key);
+    }
+
+    _accesses = 0;
+
+    if (_mode == splay_mode::top_down)
+    {
+        if (this->_root)
+        {
+            top_down_splay(this->_root, key);
+        }
+
+        return this->_root;
+    }
+
+    node* n = descend(key);
+
+    if (n)
+    {
+        splay(n);
+    }
+
+    return n;
+}
+
+// endregion lookups implementation
+
+// region splaying implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::splay(node* n)
+{
+    switch (_mode)
+    {
+        case splay_mode::bottom_up:
+            splay_to_top(n);
+            this->_root = n;
+            break;
+        case splay_mode::top_down:
+            top_down_splay(this->_root, n->data.first);
+            break;
+        case splay_mode::semi:
+            semi_splay(n);
+
+            // The old root sank by at most two levels per step at the top
+            while (this->_root->parent)
+            {
+                this->_root = this->_root->parent;
+            }
+
+            break;
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::rotate_up(node* n) noexcept
+{
+    node* subtree_root = n->parent;
+
+    if (subtree_root->left_subtree == n)
+    {
+        parent::small_right_rotation(subtree_root);
+    }
+    else
+    {
+        parent::small_left_rotation(subtree_root);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::splay_to_top(node* n) noexcept
+{
+    while (n->parent)
+    {
+        node* p = n->parent;
+        node* g = p->parent;
+
+        if (!g)
+        {
+            rotate_up(n);
+        }
+        else if ((g->left_subtree == p) == (p->left_subtree == n))
+        {
+            // zig-zig
+            rotate_up(p);
+            rotate_up(n);
+        }
+        else
+        {
+            // zig-zag
+            rotate_up(n);
+            rotate_up(n);
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::semi_splay(node* n) noexcept
+{
+    while (n->parent)
+    {
+        node* p = n->parent;
+        node* g = p->parent;
+
+        if (!g)
+        {
+            rotate_up(n);
+        }
+        else if ((g->left_subtree == p) == (p->left_subtree == n))
+        {
+            rotate_up(p);
+            n = p;
+        }
+        else
+        {
+            rotate_up(n);
+            rotate_up(n);
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename key_like>
+void splay_tree<tkey, tvalue, compare>::top_down_splay(node*& subtree_root, const key_like& key) const noexcept
+{
+    node* current = subtree_root;
+
+    // Nodes less than key gather into the left tree along its right spine, greater ones into the right tree
+    node* left_root = nullptr;
+    node* left_max = nullptr;
+    node* right_root = nullptr;
+    node* right_min = nullptr;
+
+    while (true)
+    {
+        if (this->compare_keys(key, current->data.first))
+        {
+            node* child = current->left_subtree;
+
+            if (!child)
+            {
+                break;
+            }
+
+            if (this->compare_keys(key, child->data.first))
+            {
+                // zig-zig: rotate right before linking
+                current->left_subtree = child->right_subtree;
+
+                if (current->left_subtree)
+                {
+                    current->left_subtree->parent = current;
+                }
+
+                child->right_subtree = current;
+                current->parent = child;
+                current = child;
+
+                if (!current->left_subtree)
+                {
+                    break;
+                }
+            }
+
+            // current and its right subtree go to the right tree as its new minimum
+            if (right_min)
+            {
+                right_min->left_subtree = current;
+            }
+            else
+            {
+                right_root = current;
+            }
+
+            current->parent = right_min;
+            right_min = current;
+            current = current->left_subtree;
+        }
+        else if (this->compare_keys(current->data.first, key))
+        {
+            node* child = current->right_subtree;
+
+            if (!child)
+            {
+                break;
+            }
+
+            if (this->compare_keys(child->data.first, key))
+            {
+                current->right_subtree = child->left_subtree;
+
+                if (current->right_subtree)
+                {
+                    current->right_subtree->parent = current;
+                }
+
+                child->left_subtree = current;
+                current->parent = child;
+                current = child;
+
+                if (!current->right_subtree)
+                {
+                    break;
+                }
+            }
+
+            if (left_max)
+            {
+                left_max->right_subtree = current;
+            }
+            else
+            {
+                left_root = current;
+            }
+
+            current->parent = left_max;
+            left_max = current;
+            current = current->right_subtree;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // Children of the last node fill the open ends of the side trees, which become its children
+    if (left_max)
+    {
+        left_max->right_subtree = current->left_subtree;
+
+        if (current->left_subtree)
+        {
+            current->left_subtree->parent = left_max;
+        }
+
+        current->left_subtree = left_root;
+        left_root->parent = current;
+    }
+
+    if (right_min)
+    {
+        right_min->left_subtree = current->right_subtree;
+
+        if (current->right_subtree)
+        {
+            current->right_subtree->parent = right_min;
+        }
+
+        current->right_subtree = right_root;
+        right_root->parent = current;
+    }
+
+    current->parent = nullptr;
+    subtree_root = current;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::unlink(node* n)
+{
+    if (_mode == splay_mode::top_down)
+    {
+        top_down_splay(this->_root, n->data.first);
+    }
+    else
+    {
+        splay_to_top(n);
+    }
+
+    node* left = n->left_subtree;
+    node* right = n->right_subtree;
+
+    if (right)
+    {
+        right->parent = nullptr;
+    }
+
+    if (left)
+    {
+        left->parent = nullptr;
+
+        // Every key on the left is less, so the splay ends at its maximum, which has no right child
+        if (_mode == splay_mode::top_down)
+        {
+            top_down_splay(left, n->data.first);
+        }
+        else
+        {
+            node* max = left;
+
+            while (max->right_subtree)
+            {
+                max = max->right_subtree;
+            }
+
+            splay_to_top(max);
+            left = max;
+        }
+
+        left->right_subtree = right;
+
+        if (right)
+        {
+            right->parent = left;
+        }
+
+        this->_root = left;
+    }
+    else
+    {
+        this->_root = right;
+    }
+}
+
+// endregion splaying implementation
+
 // endregion implementation
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SPLAY_TREE_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SPLAY_TREE_H
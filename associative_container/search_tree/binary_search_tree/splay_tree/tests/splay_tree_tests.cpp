@@ -3,6 +3,8 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <map>
+#include <string_view>
 
 logger *create_logger(
         std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -517,6 +519,278 @@ TEST(splayTreePositiveTests, test10)
     logger->trace("splayTreePositiveTests.test10 finished");
 }
 
+TEST(splayTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test11 started");
+
+    using mode = splay_tree<int, int>::splay_mode;
+
+    srand(11);
+
+    for (auto [splay_mode, period] : std::vector<std::pair<mode, size_t>>{
+            {mode::bottom_up, 1}, {mode::top_down, 1}, {mode::semi, 1}, {mode::top_down, 3}, {mode::semi, 4}})
+    {
+        splay_tree<int, int> tree(std::less<int>(), nullptr, logger.get());
+        std::map<int, int> expected;
+
+        tree.set_splay_mode(splay_mode, period);
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int key = rand() % 2000;
+
+            switch (rand() % 5)
+            {
+                case 0:
+                    tree.emplace_or_assign(key, i);
+                    expected.insert_or_assign(key, i);
+                    break;
+                case 1:
+                    if (expected.erase(key))
+                    {
+                        tree.erase(key);
+                    }
+                    break;
+                case 2:
+                {
+                    auto it = tree.find(key);
+                    auto expected_it = expected.find(key);
+
+                    ASSERT_EQ(it == tree.end(), expected_it == expected.end());
+
+                    if (expected_it != expected.end())
+                    {
+                        ASSERT_EQ(it->second, expected_it->second);
+                    }
+
+                    break;
+                }
+                case 3:
+                {
+                    auto it = tree.lower_bound(key);
+                    auto expected_it = expected.lower_bound(key);
+
+                    ASSERT_EQ(it == tree.end(), expected_it == expected.end());
+
+                    if (expected_it != expected.end())
+                    {
+                        ASSERT_EQ(it->first, expected_it->first);
+                    }
+
+                    break;
+                }
+                default:
+                {
+                    auto it = tree.upper_bound(key);
+                    auto expected_it = expected.upper_bound(key);
+
+                    ASSERT_EQ(it == tree.end(), expected_it == expected.end());
+
+                    if (expected_it != expected.end())
+                    {
+                        ASSERT_EQ(it->first, expected_it->first);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        ASSERT_EQ(tree.size(), expected.size());
+        std::vector<std::pair<int, int>> forward(tree.begin(), tree.end());
+        EXPECT_TRUE(std::ranges::equal(forward, expected, [](auto const &lhs, auto const &rhs)
+        {
+            return lhs.first == rhs.first && lhs.second == rhs.second;
+        }));
+
+        // Walking backwards uses the parent links the splaying rewired
+        std::vector<int> backward;
+
+        for (auto it = tree.end(); it != tree.begin();)
+        {
+            backward.push_back((--it)->first);
+        }
+
+        EXPECT_TRUE(std::ranges::equal(backward, expected | std::views::reverse | std::views::keys));
+
+        EXPECT_THROW(tree.at(-1), std::out_of_range);
+    }
+
+    splay_tree<int, int> tree;
+    EXPECT_THROW(tree.set_splay_mode(splay_tree<int, int>::splay_mode::semi, 0), std::invalid_argument);
+
+    logger->trace("splayTreePositiveTests.test11 finished");
+}
+
+TEST(splayTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test12 started");
+
+    using mode = splay_tree<int, std::string>::splay_mode;
+
+    auto depth_of = [](splay_tree<int, std::string> const &tree, int key)
+    {
+        for (auto it = tree.cbegin_infix(); it != tree.cend_infix(); ++it)
+        {
+            if (it->first == key)
+            {
+                return it.depth();
+            }
+        }
+
+        return size_t(-1);
+    };
+
+    // Ascending inserts splay every new key to the root, leaving a left path
+    splay_tree<int, std::string> tree(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 64; ++i)
+    {
+        tree.emplace(i, std::to_string(i));
+    }
+
+    ASSERT_EQ(depth_of(tree, 0), 63);
+
+    // Top-down splaying brings the key to the root in the same pass as the search
+    tree.set_splay_mode(mode::top_down);
+    EXPECT_EQ(tree.find(0)->second, "0");
+    EXPECT_EQ(tree.cbegin_prefix()->first, 0);
+    EXPECT_EQ(tree.lower_bound(31)->first, 31);
+    EXPECT_EQ(tree.cbegin_prefix()->first, 31);
+
+    // A semi-splay only about halves the depth of the accessed node
+    splay_tree<int, std::string> semi(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 64; ++i)
+    {
+        semi.emplace(i, std::to_string(i));
+    }
+
+    semi.set_splay_mode(mode::semi);
+    EXPECT_EQ(semi.at(0), "0");
+    EXPECT_EQ(depth_of(semi, 0), 31);
+
+    // With a period only every k-th lookup restructures the tree
+    splay_tree<int, std::string> sampled(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 64; ++i)
+    {
+        sampled.emplace(i, std::to_string(i));
+    }
+
+    sampled.set_splay_mode(mode::bottom_up, 3);
+    EXPECT_EQ(sampled.find(0)->second, "0");
+    EXPECT_EQ(sampled[0], "0");
+    EXPECT_EQ(depth_of(sampled, 0), 63);
+    EXPECT_EQ(sampled.find(0)->second, "0");
+    EXPECT_EQ(depth_of(sampled, 0), 0);
+
+    // Const lookups never splay
+    auto const &const_sampled = sampled;
+    EXPECT_EQ(const_sampled.find(63)->second, "63");
+    EXPECT_EQ(const_sampled.cbegin_prefix()->first, 0);
+
+    splay_tree<int, std::string> copy(sampled);
+    EXPECT_EQ(copy.get_splay_mode(), mode::bottom_up);
+    EXPECT_EQ(copy.get_splay_period(), 3);
+
+    logger->trace("splayTreePositiveTests.test12 finished");
+}
+
+TEST(splayTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test13 started");
+
+    using tree_type = splay_tree<std::string, int, std::less<>>;
+
+    for (auto mode : {tree_type::splay_mode::bottom_up, tree_type::splay_mode::top_down})
+    {
+        tree_type tree(std::less<>(), nullptr, logger.get());
+        tree.set_splay_mode(mode);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            tree.emplace("a long key that does not fit in place " + std::to_string(i * 2), i);
+        }
+
+        // Lookups by std::string_view splay the same way as by std::string
+        std::string_view view = "a long key that does not fit in place 100";
+        auto it = tree.find(view);
+
+        ASSERT_TRUE(it != tree.end());
+        EXPECT_EQ(it->second, 50);
+        EXPECT_EQ(it.depth(), 0);
+
+        EXPECT_EQ(tree.lower_bound(std::string_view("a long key that does not fit in place 101"))->second, 51);
+        EXPECT_EQ(tree.upper_bound(view)->second, 51);
+        EXPECT_TRUE(tree.find(std::string_view("a long key that does not fit in place 7")) == tree.end());
+        EXPECT_TRUE(tree.contains(view));
+
+        tree_type const &view_tree = tree;
+        EXPECT_EQ(view_tree.find(view)->second, 50);
+    }
+
+    logger->trace("splayTreePositiveTests.test13 finished");
+}
+
+TEST(splayTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test14 started");
+
+    // Unsorted input splays every inserted node, which needs the splay_tree part to be constructed already
+    splay_tree<int, int> from_list({{5, 0}, {1, 1}, {9, 2}, {3, 3}, {7, 4}}, std::less<int>(), nullptr, logger.get());
+
+    std::vector<std::pair<int, int>> unsorted{{8, 0}, {2, 1}, {6, 2}, {4, 3}};
+    splay_tree<int, int> from_iterators(unsorted.begin(), unsorted.end(), std::less<int>(), nullptr, logger.get());
+    splay_tree<int, int> from_range(unsorted, std::less<int>(), nullptr, logger.get());
+
+    using items = std::vector<std::pair<int, int>>;
+
+    EXPECT_EQ(items(from_list.begin(), from_list.end()), (items{{1, 1}, {3, 3}, {5, 0}, {7, 4}, {9, 2}}));
+    EXPECT_EQ(items(from_iterators.begin(), from_iterators.end()), (items{{2, 1}, {4, 3}, {6, 2}, {8, 0}}));
+    EXPECT_EQ(items(from_range.begin(), from_range.end()), items(from_iterators.begin(), from_iterators.end()));
+    EXPECT_EQ(from_list.get_splay_mode(), (splay_tree<int, int>::splay_mode::bottom_up));
+    EXPECT_EQ(from_list.get_splay_period(), 1);
+
+    // The key inserted last was splayed to the root
+    EXPECT_EQ(from_list.cbegin_prefix()->first, 7);
+    EXPECT_EQ(from_iterators.cbegin_prefix()->first, 4);
+
+    logger->trace("splayTreePositiveTests.test14 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <ranges>
 #include <algorithm>
+#include <string_view>
 
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -139,6 +140,27 @@ bool postfix_iterator_test(
     return true;
 }
 
+// Counts every key built, so a lookup by int can be checked to build none
+struct counted_key
+{
+    static inline size_t built = 0;
+
+    int value;
+
+    counted_key(int value = 0) : value(value) { ++built; }
+    counted_key(const counted_key& other) : value(other.value) { ++built; }
+    counted_key& operator=(const counted_key& other) = default;
+};
+
+struct counted_less
+{
+    using is_transparent = void;
+
+    bool operator()(const counted_key& lhs, const counted_key& rhs) const { return lhs.value < rhs.value; }
+    bool operator()(const counted_key& lhs, int rhs) const { return lhs.value < rhs; }
+    bool operator()(int lhs, const counted_key& rhs) const { return lhs < rhs.value; }
+};
+
 TEST(binarySearchTreePositiveTests, noIteratorTest)
 {
     std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
@@ -544,6 +566,236 @@ TEST(binarySearchTreePositiveTests, test10)
     logger->trace("binarySearchTreePositiveTests.test10 finished");
 }
 
+TEST(binarySearchTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test11 started");
+
+    // Sorted inserts degenerate into a right spine, copy and teardown must not recurse along it
+    binary_search_tree<int, int> spine(std::less<int>(), nullptr, logger.get());
+    constexpr int count = 10000;
+
+    for (int i = 0; i < count; ++i)
+    {
+        spine.emplace(i, -i);
+    }
+
+    spine.emplace(-1, 1);
+    spine.emplace(count / 2 * 3, 0);
+
+    binary_search_tree<int, int> copy(spine);
+    binary_search_tree<int, int> assigned(std::less<int>(), nullptr, logger.get());
+    assigned.emplace(100, 100);
+    assigned = copy;
+
+    for (auto const *tree : {&copy, &assigned})
+    {
+        ASSERT_EQ(tree->size(), spine.size());
+
+        auto expected = spine.cbegin_prefix();
+        size_t deepest = 0;
+
+        auto it = tree->cbegin_prefix();
+
+        for (size_t i = 0; i < spine.size(); ++i, ++it, ++expected)
+        {
+            ASSERT_EQ(it.depth(), expected.depth());
+            ASSERT_EQ(it->first, expected->first);
+            ASSERT_EQ(it->second, expected->second);
+            deepest = std::max(deepest, it.depth());
+        }
+
+        EXPECT_EQ(deepest, count);
+    }
+
+    copy.emplace(count * 2, 0);
+    copy.erase(0);
+    EXPECT_TRUE(copy.contains(count * 2));
+    EXPECT_FALSE(copy.contains(0));
+    EXPECT_FALSE(spine.contains(count * 2));
+    EXPECT_TRUE(spine.contains(0));
+
+    assigned.clear();
+    EXPECT_TRUE(assigned.empty());
+
+    logger->trace("binarySearchTreePositiveTests.test11 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test12)
+{
+    using tree = binary_search_tree<int, std::string>;
+
+    static_assert(std::is_trivially_copyable_v<tree::prefix_iterator>);
+    static_assert(std::is_trivially_copyable_v<tree::infix_const_iterator>);
+    static_assert(std::is_trivially_copyable_v<tree::postfix_const_reverse_iterator>);
+
+    tree bst;
+    bst.emplace(5, "a");
+    bst.emplace(2, "b");
+    bst.emplace(8, "c");
+
+    tree const &view = bst;
+
+    // Const iterators compare with each other and with non-const ones
+    size_t visited = 0;
+
+    for (auto it = view.cbegin_prefix(); it != view.cend_prefix(); ++it)
+    {
+        ++visited;
+    }
+
+    for (auto it = view.cbegin_infix(); it != bst.end_infix(); ++it)
+    {
+        ++visited;
+    }
+
+    for (auto it = view.cbegin_postfix(); it != view.cend_postfix(); ++it)
+    {
+        ++visited;
+    }
+
+    EXPECT_EQ(visited, 9);
+    EXPECT_TRUE(view.cbegin_infix() == bst.begin_infix());
+    EXPECT_TRUE(bst.begin_prefix() == view.cbegin_prefix());
+    EXPECT_FALSE(view.cbegin_postfix() != bst.begin_postfix());
+}
+
+TEST(binarySearchTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("binarySearchTreePositiveTests.test13 started");
+
+    srand(13);
+
+    binary_search_tree<int, int> plain(std::less<int>(), nullptr, logger.get());
+    binary_search_tree<int, int> hinted(std::less<int>(), nullptr, logger.get());
+    std::vector<int> keys;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        keys.push_back(rand() % 10000);
+    }
+
+    // The hint only changes where the search starts, so both trees end up with the same shape
+    auto last = hinted.end();
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        plain.emplace(keys[i], static_cast<int>(i));
+
+        switch (i % 3)
+        {
+            case 0:
+                last = hinted.emplace_hint(hinted.end(), keys[i], static_cast<int>(i));
+                break;
+            case 1:
+                last = hinted.insert(last, std::make_pair(keys[i], static_cast<int>(i)));
+                break;
+            default:
+                last = hinted.emplace_hint(hinted.find(keys[rand() % (i + 1)]), keys[i], static_cast<int>(i));
+                break;
+        }
+
+        ASSERT_EQ(last->first, keys[i]);
+    }
+
+    ASSERT_EQ(hinted.size(), plain.size());
+
+    auto expected = plain.cbegin_prefix();
+
+    for (auto it = hinted.cbegin_prefix(); it != hinted.cend_prefix(); ++it, ++expected)
+    {
+        ASSERT_EQ(it.depth(), expected.depth());
+        ASSERT_EQ(it->first, expected->first);
+        ASSERT_EQ(it->second, expected->second);
+    }
+
+    binary_search_tree<int, int> const &view = hinted;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        int key = rand() % 10001;
+        auto from = hinted.find(keys[rand() % keys.size()]);
+
+        EXPECT_TRUE(hinted.find_from(from, key) == hinted.find(key));
+        EXPECT_TRUE(view.find_from(from, key) == view.find(key));
+    }
+
+    EXPECT_TRUE(hinted.find_from(hinted.end(), 10000) == hinted.end());
+
+    binary_search_tree<int, int> empty;
+    EXPECT_TRUE(empty.find_from(empty.begin(), 1) == empty.end());
+    EXPECT_EQ(empty.insert(empty.end(), std::make_pair(1, 1))->first, 1);
+    EXPECT_EQ(empty.size(), 1);
+
+    logger->trace("binarySearchTreePositiveTests.test13 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("binarySearchTreePositiveTests.test14 started");
+
+    binary_search_tree<std::string, int, std::less<>> bst(std::less<>(), nullptr, logger.get());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        bst.emplace("a long key that does not fit in place " + std::to_string(i * 2), i);
+    }
+
+    std::string_view view = "a long key that does not fit in place 42";
+
+    ASSERT_TRUE(bst.find(view) != bst.end());
+    EXPECT_EQ(bst.find(view)->second, 21);
+    EXPECT_TRUE(bst.contains("a long key that does not fit in place 198"));
+    EXPECT_FALSE(bst.contains(std::string_view("a long key that does not fit in place 43")));
+    EXPECT_TRUE(bst.find("missing") == bst.end());
+
+    auto const &view_tree = bst;
+    std::string_view between = "a long key that does not fit in place 43";
+
+    EXPECT_EQ(view_tree.lower_bound(between)->first, "a long key that does not fit in place 44");
+    EXPECT_EQ(bst.upper_bound(view)->first, view_tree.upper_bound(std::string(view))->first);
+    EXPECT_TRUE(view_tree.find(view) == view_tree.find(std::string(view)));
+
+    binary_search_tree<counted_key, int, counted_less> counted;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        counted.emplace(i * 3, i);
+    }
+
+    size_t built = counted_key::built;
+
+    EXPECT_EQ(counted.find(30)->second, 10);
+    EXPECT_TRUE(counted.contains(3));
+    EXPECT_FALSE(counted.contains(4));
+    EXPECT_EQ(counted.lower_bound(4)->first.value, 6);
+    EXPECT_EQ(counted.upper_bound(6)->first.value, 9);
+    EXPECT_EQ(counted_key::built, built);
+
+    logger->trace("binarySearchTreePositiveTests.test14 finished");
+}
 
 int main(
     int argc,
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <iterator>
+#include <optional>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 #include <boost/container/static_vector.hpp>
@@ -29,6 +32,10 @@ private:
     // region comparators declaration
 
     inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+    // Mixed comparisons for the lookups by key_like, see transparent_compator
+    template<typename lhs_key, typename rhs_key>
+    inline bool compare_keys(const lhs_key& lhs, const rhs_key& rhs) const;
     inline bool compare_pairs(const tree_data_type& lhs, const tree_data_type& rhs) const;
 
     // endregion comparators declaration
@@ -65,6 +72,14 @@ private:
         bptree_node_middle() noexcept;
     };
 
+    // Element of the iterators' pointer type, keeps the pair of references alive for operator->
+    template<typename reference>
+    struct arrow_proxy
+    {
+        reference _ref;
+        const reference* operator->() const noexcept { return &_ref; }
+    };
+
     pp_allocator<value_type> _allocator;
     logger* _logger;
     bptree_node_base* _root;
@@ -114,8 +129,8 @@ public:
 
     public:
         using value_type = tree_data_type_const;
-        using reference = value_type&;
-        using pointer = value_type*;
+        using reference = std::pair<const tkey&, tvalue&>;
+        using pointer = arrow_proxy<reference>;
         using iterator_category = std::forward_iterator_tag;
         using difference_type = ptrdiff_t;
         using self = bptree_iterator;
@@ -147,8 +162,8 @@ public:
     public:
 
         using value_type = tree_data_type_const;
-        using reference = const value_type&;
-        using pointer = const value_type*;
+        using reference = std::pair<const tkey&, const tvalue&>;
+        using pointer = arrow_proxy<reference>;
         using iterator_category = std::forward_iterator_tag;
         using difference_type = ptrdiff_t;
         using self = bptree_const_iterator;
@@ -226,6 +241,36 @@ public:
 
     bool contains(const tkey& key) const;
 
+    /** Lookups by a key of another type that compare orders against tkey (compare::is_transparent),
+     *  no temporary tkey is built
+     */
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    bptree_iterator find(const key_like& key);
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    bptree_const_iterator find(const key_like& key) const;
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    bptree_iterator lower_bound(const key_like& key);
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    bptree_const_iterator lower_bound(const key_like& key) const;
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    bptree_iterator upper_bound(const key_like& key);
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    bptree_const_iterator upper_bound(const key_like& key) const;
+
+    template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+    bool contains(const key_like& key) const;
+
+    /** Streams the elements with keys in [lo, hi) to visit in key order as the iterators' references, walking the linked leaves
+     *  instead of the iterators; the leaves a few positions ahead are prefetched while the current one is visited.
+     *  Returns the number of visited elements
+     */
+    template<typename visitor>
+    size_t scan(const tkey& lo, const tkey& hi, visitor&& visit);
+    template<typename visitor>
+    size_t scan(const tkey& lo, const tkey& hi, visitor&& visit) const;
+
     // endregion lookup declaration
 
     // region modifiers declaration
@@ -264,6 +309,60 @@ public:
     bptree_iterator erase(const tkey& key);
 
     // endregion modifiers declaration
+
+private:
+
+    // Middle nodes passed from the root to a leaf together with the positions of the children taken in them
+    using node_path = std::stack<std::pair<bptree_node_middle*, size_t>, std::vector<std::pair<bptree_node_middle*, size_t>>>;
+
+    /** Position of the first element of leaf that does not precede key:
+     *  with upper false an element precedes when its key is less than key, with upper true when it is not greater
+     */
+    template<bool upper, typename key_like>
+    size_t search_in_leaf(const bptree_node_term* leaf, const key_like& key) const;
+
+    // Position of the child of node whose subtree holds key, keys equal to a separator are on its right
+    template<typename key_like>
+    size_t child_position(const bptree_node_middle* node, const key_like& key) const;
+
+    // Leaf that holds key in a non-empty tree, the middle nodes passed are pushed to path when it is given
+    template<typename key_like>
+    bptree_node_term* find_leaf(const key_like& key, node_path* path = nullptr) const;
+
+    // Element of the search_in_leaf bound over the whole tree, {nullptr, 0} when there is none
+    template<bool upper, typename key_like>
+    std::pair<bptree_node_term*, size_t> bound(const key_like& key) const;
+
+    template<typename key_like>
+    std::pair<bptree_node_term*, size_t> find_position(const key_like& key) const;
+
+    bptree_node_term* leftmost_leaf() const noexcept;
+
+    // Moves the upper half of an overflowing leaf to a new right sibling and links it in, returns the sibling
+    bptree_node_term* split_leaf(bptree_node_term* leaf, node_path& path);
+
+    // Adds key and right after left to the parent on top of path, splitting the middle nodes that overflow up to the root
+    void insert_separator(node_path& path, tkey&& key, bptree_node_base* left, bptree_node_base* right);
+
+    // Restores the minimum fill from node up to the root after a removal from node; collapses an empty root
+    void restore_after_removal(bptree_node_base* node, node_path& path);
+
+    // Borrow from or merge with a sibling for the child at index of parent; true when it was merged
+    bool rebalance_leaf(bptree_node_middle* parent, size_t index);
+    bool rebalance_middle(bptree_node_middle* parent, size_t index);
+
+    template<typename reference, typename visitor>
+    size_t scan_leaves(const tkey& lo, const tkey& hi, visitor& visit) const;
+
+    // Hints the cache to load the beginning of leaf, so the walk of the linked leaves does not stall on it
+    static void prefetch_leaf(const bptree_node_term* leaf) noexcept;
+
+    // How many leaves ahead of the visited one scan starts loading
+    static constexpr const size_t scan_prefetch_distance = 2;
+
+    // Copies a subtree, linking its leaves after last_leaf
+    static bptree_node_base* clone_subtree(const bptree_node_base* node, bptree_node_term*& last_leaf);
+    static void destroy_subtree(bptree_node_base* node) noexcept;
 };
 
 template<std::input_iterator iterator, compator<typename std::iterator_traits<iterator>::value_type::first_type> compare = std::less<typename std::iterator_traits<iterator>::value_type::first_type>,
@@ -275,6 +374,8 @@ template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey
 BP_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare &cmp = compare(), pp_allocator<U> = pp_allocator<U>(),
         logger *logger = nullptr) -> BP_tree<tkey, tvalue, compare, t>;
 
+// region comparators implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::compare_pairs(const BP_tree::tree_data_type &lhs,
                                                      const BP_tree::tree_data_type &rhs) const
@@ -283,407 +384,1075 @@ bool BP_tree<tkey, tvalue, compare, t>::compare_pairs(const BP_tree::tree_data_t
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-BP_tree<tkey, tvalue, compare, t>::bptree_node_base::bptree_node_base() noexcept
+bool BP_tree<tkey, tvalue, compare, t>::compare_keys(const tkey &lhs, const tkey &rhs) const
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return compare::operator()(lhs, rhs);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-BP_tree<tkey, tvalue, compare, t>::bptree_node_term::bptree_node_term() noexcept
+template<typename lhs_key, typename rhs_key>
+bool BP_tree<tkey, tvalue, compare, t>::compare_keys(const lhs_key &lhs, const rhs_key &rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
+// endregion comparators implementation
+
+// region nodes implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+BP_tree<tkey, tvalue, compare, t>::bptree_node_base::bptree_node_base() noexcept : _is_terminate(false)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+BP_tree<tkey, tvalue, compare, t>::bptree_node_term::bptree_node_term() noexcept : _next(nullptr)
+{
+    this->_is_terminate = true;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>::bptree_node_middle::bptree_node_middle() noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    this->_is_terminate = false;
 }
 
+// endregion nodes implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 logger * BP_tree<tkey, tvalue, compare, t>::get_logger() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _logger;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 pp_allocator<typename BP_tree<tkey, tvalue, compare, t>::value_type> BP_tree<tkey, tvalue, compare, t>::
 get_allocator() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _allocator;
 }
 
+// region iterators implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator::reference BP_tree<tkey, tvalue, compare, t>::
 bptree_iterator::operator*() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    // Leaves store pairs with a mutable key, they are handed out as references with the key made const
+    return reference(_node->_data[_index].first, _node->_data[_index].second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator::pointer BP_tree<tkey, tvalue, compare, t>::bptree_iterator
 ::operator->() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator::self & BP_tree<tkey, tvalue, compare, t>::bptree_iterator::
 operator++()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    if (_node != nullptr && ++_index == _node->_data.size())
+    {
+        _node = _node->_next;
+        _index = 0;
+        if (_node != nullptr)
+        {
+            prefetch_leaf(_node->_next);
+        }
+    }
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator::self BP_tree<tkey, tvalue, compare, t>::bptree_iterator::
 operator++(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    ++*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::bptree_iterator::operator==(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _node == other._node && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::bptree_iterator::operator!=(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return !(*this == other);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BP_tree<tkey, tvalue, compare, t>::bptree_iterator::current_node_keys_count() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _node == nullptr ? 0 : _node->_data.size();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BP_tree<tkey, tvalue, compare, t>::bptree_iterator::index() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-BP_tree<tkey, tvalue, compare, t>::bptree_iterator::bptree_iterator(bptree_node_term *node, size_t index)
+BP_tree<tkey, tvalue, compare, t>::bptree_iterator::bptree_iterator(bptree_node_term *node, size_t index) : _node(node), _index(index)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::bptree_const_iterator(const bptree_iterator &it) noexcept
+BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::bptree_const_iterator(const bptree_iterator &it) noexcept : _node(it._node), _index(it._index)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::reference BP_tree<tkey, tvalue, compare, t>::
 bptree_const_iterator::operator*() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return reference(_node->_data[_index].first, _node->_data[_index].second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::pointer BP_tree<tkey, tvalue, compare, t>::
 bptree_const_iterator::operator->() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::self & BP_tree<tkey, tvalue, compare, t>::
 bptree_const_iterator::operator++()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    if (_node != nullptr && ++_index == _node->_data.size())
+    {
+        _node = _node->_next;
+        _index = 0;
+        if (_node != nullptr)
+        {
+            prefetch_leaf(_node->_next);
+        }
+    }
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::self BP_tree<tkey, tvalue, compare, t>::
 bptree_const_iterator::operator++(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    ++*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::operator==(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _node == other._node && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::operator!=(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return !(*this == other);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::current_node_keys_count() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _node == nullptr ? 0 : _node->_data.size();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::index() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::bptree_const_iterator(const bptree_node_term *node, size_t index)
+BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator::bptree_const_iterator(const bptree_node_term *node, size_t index) : _node(node), _index(index)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
 }
 
+// endregion iterators implementation
+
+// region element access implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-tvalue & BP_tree<tkey, tvalue, compare, t>::at(const tkey &)
+tvalue & BP_tree<tkey, tvalue, compare, t>::at(const tkey &key)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto it = find(key);
+    if (it == end())
+    {
+        throw std::out_of_range("Key not found in B+ tree");
+    }
+    return it->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-const tvalue & BP_tree<tkey, tvalue, compare, t>::at(const tkey &) const
+const tvalue & BP_tree<tkey, tvalue, compare, t>::at(const tkey &key) const
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto it = find(key);
+    if (it == end())
+    {
+        throw std::out_of_range("Key not found in B+ tree");
+    }
+    return it->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue & BP_tree<tkey, tvalue, compare, t>::operator[](const tkey &key)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto it = find(key);
+    if (it == end())
+    {
+        it = insert(tree_data_type(key, tvalue())).first;
+    }
+    return it->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue & BP_tree<tkey, tvalue, compare, t>::operator[](tkey &&key)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto it = find(key);
+    if (it == end())
+    {
+        it = insert(tree_data_type(std::move(key), tvalue())).first;
+    }
+    return it->second;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator, bool> BP_tree<tkey, tvalue, compare, t>::insert(
-    const tree_data_type &data)
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
-
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool BP_tree<tkey, tvalue, compare, t>::compare_keys(const tkey &lhs, const tkey &rhs) const
-{
-    return compare::operator()(lhs, rhs);
-}
+// endregion element access implementation
 
+// region constructors implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>::BP_tree(const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
+    : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>::BP_tree(const compare& cmp, pp_allocator<value_type> alloc, logger* logger)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>::BP_tree(pp_allocator<value_type> alloc, const compare& cmp, logger* logger)
+    : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>::BP_tree(pp_allocator<value_type> alloc, const compare& cmp, logger* logger)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
 BP_tree<tkey, tvalue, compare, t>::BP_tree(iterator begin, iterator end, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
+    : BP_tree(cmp, alloc, logger)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> template<input_iterator_for_pair<tkey, tvalue> iterator> BP_tree<tkey, tvalue, compare, t>::BP_tree(iterator begin, iterator end, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)", "your code should be here...");
+    for (; begin != end; ++begin)
+    {
+        insert(tree_data_type(*begin));
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>::BP_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
+    : BP_tree(data.begin(), data.end(), cmp, alloc, logger)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>::BP_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)", "your code should be here...");
 }
 
+// endregion constructors implementation
+
+// region five implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>::BP_tree(const BP_tree& other)
+    : compare(other), _allocator(other._allocator), _logger(other._logger), _root(nullptr), _size(0)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>::BP_tree(const BP_tree& other)", "your code should be here...");
+    if (other._root != nullptr)
+    {
+        bptree_node_term* last_leaf = nullptr;
+        _root = clone_subtree(other._root, last_leaf);
+        _size = other._size;
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>::BP_tree(BP_tree&& other) noexcept
+    : compare(std::move(other)), _allocator(std::move(other._allocator)), _logger(other._logger), _root(other._root), _size(other._size)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>::BP_tree(BP_tree&& other) noexcept", "your code should be here...");
+    other._root = nullptr;
+    other._size = 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>& BP_tree<tkey, tvalue, compare, t>::operator=(const BP_tree& other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>& BP_tree<tkey, tvalue, compare, t>::operator=(const BP_tree& other)", "your code should be here...");
+    if (this != &other)
+    {
+        BP_tree copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>& BP_tree<tkey, tvalue, compare, t>::operator=(BP_tree&& other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>& BP_tree<tkey, tvalue, compare, t>::operator=(BP_tree&& other) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        clear();
+        compare::operator=(std::move(other));
+        _allocator = std::move(other._allocator);
+        _logger = other._logger;
+        _root = other._root;
+        _size = other._size;
+        other._root = nullptr;
+        other._size = 0;
+    }
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BP_tree<tkey, tvalue, compare, t>::~BP_tree() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BP_tree<tkey, tvalue, compare, t>::~BP_tree() noexcept", "your code should be here...");
+    destroy_subtree(_root);
 }
 
+// endregion five implementation
+
+// region iterator begins implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::begin()
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::begin()", "your code should be here...");
+    return bptree_iterator(leftmost_leaf(), 0);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::end()
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::end()", "your code should be here...");
+    return bptree_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::begin() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::begin() const", "your code should be here...");
+    return cbegin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::end() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::end() const", "your code should be here...");
+    return cend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::cbegin() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::cbegin() const", "your code should be here...");
+    return bptree_const_iterator(leftmost_leaf(), 0);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::cend() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::cend() const", "your code should be here...");
+    return bptree_const_iterator();
 }
 
+// endregion iterator begins implementation
+
+// region lookup implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BP_tree<tkey, tvalue, compare, t>::size() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> size_t BP_tree<tkey, tvalue, compare, t>::size() const noexcept", "your code should be here...");
+    return _size;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::empty() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> bool BP_tree<tkey, tvalue, compare, t>::empty() const noexcept", "your code should be here...");
+    return _size == 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::find(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::find(const tkey& key)", "your code should be here...");
+    auto [leaf, index] = find_position(key);
+    return bptree_iterator(leaf, index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::find(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::find(const tkey& key) const", "your code should be here...");
+    auto [leaf, index] = find_position(key);
+    return bptree_const_iterator(leaf, index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key)", "your code should be here...");
+    auto [leaf, index] = bound<false>(key);
+    return bptree_iterator(leaf, index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const", "your code should be here...");
+    auto [leaf, index] = bound<false>(key);
+    return bptree_const_iterator(leaf, index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key)", "your code should be here...");
+    auto [leaf, index] = bound<true>(key);
+    return bptree_iterator(leaf, index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const", "your code should be here...");
+    auto [leaf, index] = bound<true>(key);
+    return bptree_const_iterator(leaf, index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BP_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> bool BP_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const", "your code should be here...");
+    return find_position(key).first != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::find(const key_like& key)
+{
+    auto [leaf, index] = find_position(key);
+    return bptree_iterator(leaf, index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::find(const key_like& key) const
+{
+    auto [leaf, index] = find_position(key);
+    return bptree_const_iterator(leaf, index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const key_like& key)
+{
+    auto [leaf, index] = bound<false>(key);
+    return bptree_iterator(leaf, index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::lower_bound(const key_like& key) const
+{
+    auto [leaf, index] = bound<false>(key);
+    return bptree_const_iterator(leaf, index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const key_like& key)
+{
+    auto [leaf, index] = bound<true>(key);
+    return bptree_iterator(leaf, index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_const_iterator BP_tree<tkey, tvalue, compare, t>::upper_bound(const key_like& key) const
+{
+    auto [leaf, index] = bound<true>(key);
+    return bptree_const_iterator(leaf, index);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+bool BP_tree<tkey, tvalue, compare, t>::contains(const key_like& key) const
+{
+    return find_position(key).first != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename visitor>
+size_t BP_tree<tkey, tvalue, compare, t>::scan(const tkey& lo, const tkey& hi, visitor&& visit)
+{
+    return scan_leaves<typename bptree_iterator::reference>(lo, hi, visit);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename visitor>
+size_t BP_tree<tkey, tvalue, compare, t>::scan(const tkey& lo, const tkey& hi, visitor&& visit) const
+{
+    return scan_leaves<typename bptree_const_iterator::reference>(lo, hi, visit);
+}
+
+// endregion lookup implementation
+
+// region modifiers implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 void BP_tree<tkey, tvalue, compare, t>::clear() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> void BP_tree<tkey, tvalue, compare, t>::clear() noexcept", "your code should be here...");
+    destroy_subtree(_root);
+    _root = nullptr;
+    _size = 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator, bool> BP_tree<tkey, tvalue, compare, t>::insert(
+    const tree_data_type &data)
+{
+    return insert(tree_data_type(data));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator, bool> BP_tree<tkey, tvalue, compare, t>::insert(tree_data_type&& data)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator, bool> BP_tree<tkey, tvalue, compare, t>::insert(tree_data_type&& data)", "your code should be here...");
+    if (_root == nullptr)
+    {
+        _root = new bptree_node_term();
+    }
+
+    node_path path;
+    bptree_node_term* leaf = find_leaf(data.first, &path);
+    size_t index = search_in_leaf<false>(leaf, data.first);
+    if (index < leaf->_data.size() && !compare_keys(data.first, leaf->_data[index].first))
+    {
+        return {bptree_iterator(leaf, index), false};
+    }
+
+    leaf->_data.insert(leaf->_data.begin() + index, std::move(data));
+    ++_size;
+
+    if (leaf->_data.size() > maximum_keys_in_node)
+    {
+        bptree_node_term* right = split_leaf(leaf, path);
+        if (index >= leaf->_data.size())
+        {
+            index -= leaf->_data.size();
+            leaf = right;
+        }
+    }
+    return {bptree_iterator(leaf, index), true};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 template <typename ...Args>
 std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator, bool> BP_tree<tkey, tvalue, compare, t>::emplace(Args&&... args)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> template <typename ...Args> std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator, bool> BP_tree<tkey, tvalue, compare, t>::emplace(Args&&... args)", "your code should be here...");
+    return insert(tree_data_type(std::forward<Args>(args)...));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::insert_or_assign(const tree_data_type& data)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::insert_or_assign(const tree_data_type& data)", "your code should be here...");
+    return insert_or_assign(tree_data_type(data));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::insert_or_assign(tree_data_type&& data)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::insert_or_assign(tree_data_type&& data)", "your code should be here...");
+    auto it = find(data.first);
+    if (it != end())
+    {
+        it->second = std::move(data.second);
+        return it;
+    }
+    return insert(std::move(data)).first;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 template <typename ...Args>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::emplace_or_assign(Args&&... args)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> template <typename ...Args> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::emplace_or_assign(Args&&... args)", "your code should be here...");
+    return insert_or_assign(tree_data_type(std::forward<Args>(args)...));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_iterator pos)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_iterator pos)", "your code should be here...");
+    if (pos == end())
+    {
+        return end();
+    }
+    return erase(tkey(pos->first));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_const_iterator pos)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_const_iterator pos)", "your code should be here...");
+    return erase(bptree_iterator(const_cast<bptree_node_term*>(pos._node), pos._index));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_iterator beg, bptree_iterator en)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_iterator beg, bptree_iterator en)", "your code should be here...");
+    if (beg == en)
+    {
+        return en;
+    }
+
+    // Rebalancing moves elements between leaves, so the bounds are kept as keys
+    std::optional<tkey> hi;
+    if (en != end())
+    {
+        hi.emplace(en->first);
+    }
+    auto it = beg;
+    while (it != end() && (!hi || compare_keys(it->first, *hi)))
+    {
+        it = erase(it);
+    }
+    return it;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_const_iterator beg, bptree_const_iterator en)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(bptree_const_iterator beg, bptree_const_iterator en)", "your code should be here...");
+    return erase(bptree_iterator(const_cast<bptree_node_term*>(beg._node), beg._index),
+                 bptree_iterator(const_cast<bptree_node_term*>(en._node), en._index));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BP_tree<tkey, tvalue, compare, t>::bptree_iterator BP_tree<tkey, tvalue, compare, t>::erase(const tkey& key)", "your code should be here...");
+    if (_root == nullptr)
+    {
+        return end();
+    }
+
+    node_path path;
+    bptree_node_term* leaf = find_leaf(key, &path);
+    size_t index = search_in_leaf<false>(leaf, key);
+    if (index == leaf->_data.size() || compare_keys(key, leaf->_data[index].first))
+    {
+        return end();
+    }
+
+    leaf->_data.erase(leaf->_data.begin() + index);
+    --_size;
+
+    if (leaf->_data.size() >= minimum_keys_in_node && leaf != _root)
+    {
+        return index < leaf->_data.size() ? bptree_iterator(leaf, index) : bptree_iterator(leaf->_next, 0);
+    }
+    restore_after_removal(leaf, path);
+    return lower_bound(key);
+}
+
+// endregion modifiers implementation
+
+// region helpers implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<bool upper, typename key_like>
+size_t BP_tree<tkey, tvalue, compare, t>::search_in_leaf(const bptree_node_term* leaf, const key_like& key) const
+{
+    if constexpr (upper)
+    {
+        return std::upper_bound(leaf->_data.begin(), leaf->_data.end(), key,
+                                [this](const key_like& lhs, const tree_data_type& rhs) { return compare_keys(lhs, rhs.first); })
+               - leaf->_data.begin();
+    }
+    else
+    {
+        return std::lower_bound(leaf->_data.begin(), leaf->_data.end(), key,
+                                [this](const tree_data_type& lhs, const key_like& rhs) { return compare_keys(lhs.first, rhs); })
+               - leaf->_data.begin();
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like>
+size_t BP_tree<tkey, tvalue, compare, t>::child_position(const bptree_node_middle* node, const key_like& key) const
+{
+    return std::upper_bound(node->_keys.begin(), node->_keys.end(), key,
+                            [this](const key_like& lhs, const tkey& rhs) { return compare_keys(lhs, rhs); })
+           - node->_keys.begin();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_node_term* BP_tree<tkey, tvalue, compare, t>::find_leaf(const key_like& key, node_path* path) const
+{
+    bptree_node_base* node = _root;
+    while (!node->_is_terminate)
+    {
+        auto* middle = static_cast<bptree_node_middle*>(node);
+        size_t index = child_position(middle, key);
+        if (path != nullptr)
+        {
+            path->emplace(middle, index);
+        }
+        node = middle->_pointers[index];
+    }
+    return static_cast<bptree_node_term*>(node);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<bool upper, typename key_like>
+std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_node_term*, size_t> BP_tree<tkey, tvalue, compare, t>::bound(const key_like& key) const
+{
+    if (_root == nullptr)
+    {
+        return {nullptr, 0};
+    }
+
+    bptree_node_term* leaf = find_leaf(key);
+    size_t index = search_in_leaf<upper>(leaf, key);
+    if (index == leaf->_data.size())
+    {
+        // Every leaf but the root holds elements, so the bound is the first one of the next leaf
+        return {leaf->_next, 0};
+    }
+    return {leaf, index};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like>
+std::pair<typename BP_tree<tkey, tvalue, compare, t>::bptree_node_term*, size_t> BP_tree<tkey, tvalue, compare, t>::find_position(const key_like& key) const
+{
+    if (_root == nullptr)
+    {
+        return {nullptr, 0};
+    }
+
+    bptree_node_term* leaf = find_leaf(key);
+    size_t index = search_in_leaf<false>(leaf, key);
+    if (index == leaf->_data.size() || compare_keys(key, leaf->_data[index].first))
+    {
+        return {nullptr, 0};
+    }
+    return {leaf, index};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_node_term* BP_tree<tkey, tvalue, compare, t>::leftmost_leaf() const noexcept
+{
+    bptree_node_base* node = _root;
+    if (node == nullptr)
+    {
+        return nullptr;
+    }
+    while (!node->_is_terminate)
+    {
+        node = static_cast<bptree_node_middle*>(node)->_pointers.front();
+    }
+    return static_cast<bptree_node_term*>(node);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_node_term* BP_tree<tkey, tvalue, compare, t>::split_leaf(bptree_node_term* leaf, node_path& path)
+{
+    auto* right = new bptree_node_term();
+    size_t middle = leaf->_data.size() / 2;
+
+    right->_data.assign(std::make_move_iterator(leaf->_data.begin() + middle), std::make_move_iterator(leaf->_data.end()));
+    leaf->_data.erase(leaf->_data.begin() + middle, leaf->_data.end());
+    right->_next = leaf->_next;
+    leaf->_next = right;
+
+    insert_separator(path, tkey(right->_data.front().first), leaf, right);
+    return right;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BP_tree<tkey, tvalue, compare, t>::insert_separator(node_path& path, tkey&& key, bptree_node_base* left, bptree_node_base* right)
+{
+    while (!path.empty())
+    {
+        auto [parent, index] = path.top();
+        path.pop();
+
+        parent->_keys.insert(parent->_keys.begin() + index, std::move(key));
+        parent->_pointers.insert(parent->_pointers.begin() + index + 1, right);
+        if (parent->_keys.size() <= maximum_keys_in_node)
+        {
+            return;
+        }
+
+        // Unlike in a leaf, the middle key leaves the node and goes up
+        auto* sibling = new bptree_node_middle();
+        size_t middle = parent->_keys.size() / 2;
+
+        key = std::move(parent->_keys[middle]);
+        sibling->_keys.assign(std::make_move_iterator(parent->_keys.begin() + middle + 1), std::make_move_iterator(parent->_keys.end()));
+        sibling->_pointers.assign(parent->_pointers.begin() + middle + 1, parent->_pointers.end());
+        parent->_keys.erase(parent->_keys.begin() + middle, parent->_keys.end());
+        parent->_pointers.erase(parent->_pointers.begin() + middle + 1, parent->_pointers.end());
+
+        left = parent;
+        right = sibling;
+    }
+
+    auto* root = new bptree_node_middle();
+    root->_keys.push_back(std::move(key));
+    root->_pointers.push_back(left);
+    root->_pointers.push_back(right);
+    _root = root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BP_tree<tkey, tvalue, compare, t>::restore_after_removal(bptree_node_base* node, node_path& path)
+{
+    while (!path.empty())
+    {
+        size_t count = node->_is_terminate
+                ? static_cast<bptree_node_term*>(node)->_data.size()
+                : static_cast<bptree_node_middle*>(node)->_keys.size();
+        if (count >= minimum_keys_in_node)
+        {
+            return;
+        }
+
+        auto [parent, index] = path.top();
+        path.pop();
+
+        bool merged = node->_is_terminate ? rebalance_leaf(parent, index) : rebalance_middle(parent, index);
+        if (!merged)
+        {
+            return;
+        }
+        node = parent;
+    }
+
+    if (node->_is_terminate)
+    {
+        if (static_cast<bptree_node_term*>(node)->_data.empty())
+        {
+            delete node;
+            _root = nullptr;
+        }
+    }
+    else
+    {
+        auto* root = static_cast<bptree_node_middle*>(node);
+        if (root->_keys.empty())
+        {
+            _root = root->_pointers.front();
+            delete root;
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+bool BP_tree<tkey, tvalue, compare, t>::rebalance_leaf(bptree_node_middle* parent, size_t index)
+{
+    auto* node = static_cast<bptree_node_term*>(parent->_pointers[index]);
+    auto* left = index > 0 ? static_cast<bptree_node_term*>(parent->_pointers[index - 1]) : nullptr;
+    auto* right = index + 1 < parent->_pointers.size() ? static_cast<bptree_node_term*>(parent->_pointers[index + 1]) : nullptr;
+
+    if (left != nullptr && left->_data.size() > minimum_keys_in_node)
+    {
+        node->_data.insert(node->_data.begin(), std::move(left->_data.back()));
+        left->_data.pop_back();
+        parent->_keys[index - 1] = node->_data.front().first;
+        return false;
+    }
+    if (right != nullptr && right->_data.size() > minimum_keys_in_node)
+    {
+        node->_data.push_back(std::move(right->_data.front()));
+        right->_data.erase(right->_data.begin());
+        parent->_keys[index] = right->_data.front().first;
+        return false;
+    }
+
+    // The right one of the two leaves is merged into the left one
+    if (left == nullptr)
+    {
+        left = node;
+        node = right;
+        ++index;
+    }
+    left->_data.insert(left->_data.end(), std::make_move_iterator(node->_data.begin()), std::make_move_iterator(node->_data.end()));
+    left->_next = node->_next;
+    parent->_keys.erase(parent->_keys.begin() + index - 1);
+    parent->_pointers.erase(parent->_pointers.begin() + index);
+    delete node;
+    return true;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+bool BP_tree<tkey, tvalue, compare, t>::rebalance_middle(bptree_node_middle* parent, size_t index)
+{
+    auto* node = static_cast<bptree_node_middle*>(parent->_pointers[index]);
+    auto* left = index > 0 ? static_cast<bptree_node_middle*>(parent->_pointers[index - 1]) : nullptr;
+    auto* right = index + 1 < parent->_pointers.size() ? static_cast<bptree_node_middle*>(parent->_pointers[index + 1]) : nullptr;
+
+    // Borrowing rotates a key through the parent
+    if (left != nullptr && left->_keys.size() > minimum_keys_in_node)
+    {
+        node->_keys.insert(node->_keys.begin(), std::move(parent->_keys[index - 1]));
+        node->_pointers.insert(node->_pointers.begin(), left->_pointers.back());
+        parent->_keys[index - 1] = std::move(left->_keys.back());
+        left->_keys.pop_back();
+        left->_pointers.pop_back();
+        return false;
+    }
+    if (right != nullptr && right->_keys.size() > minimum_keys_in_node)
+    {
+        node->_keys.push_back(std::move(parent->_keys[index]));
+        node->_pointers.push_back(right->_pointers.front());
+        parent->_keys[index] = std::move(right->_keys.front());
+        right->_keys.erase(right->_keys.begin());
+        right->_pointers.erase(right->_pointers.begin());
+        return false;
+    }
+
+    // Merging pulls the separator down between the keys of the two nodes
+    if (left == nullptr)
+    {
+        left = node;
+        node = right;
+        ++index;
+    }
+    left->_keys.push_back(std::move(parent->_keys[index - 1]));
+    left->_keys.insert(left->_keys.end(), std::make_move_iterator(node->_keys.begin()), std::make_move_iterator(node->_keys.end()));
+    left->_pointers.insert(left->_pointers.end(), node->_pointers.begin(), node->_pointers.end());
+    parent->_keys.erase(parent->_keys.begin() + index - 1);
+    parent->_pointers.erase(parent->_pointers.begin() + index);
+    delete node;
+    return true;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename reference, typename visitor>
+size_t BP_tree<tkey, tvalue, compare, t>::scan_leaves(const tkey& lo, const tkey& hi, visitor& visit) const
+{
+    if (_root == nullptr || !compare_keys(lo, hi))
+    {
+        return 0;
+    }
+
+    node_path path;
+    bptree_node_term* leaf = find_leaf(lo, &path);
+    size_t index = search_in_leaf<false>(leaf, lo);
+
+    // The leaves ahead are taken from the parent, which lists them, rather than from the links, which have to be
+    // followed one at a time: the fetch of a leaf then starts scan_prefetch_distance leaves before it is reached
+    const bptree_node_middle* parent = nullptr;
+    size_t position = 0;
+    auto enter_parent = [&]()
+    {
+        parent = path.top().first;
+        position = path.top().second;
+        for (size_t i = 1; i <= scan_prefetch_distance && position + i < parent->_pointers.size(); ++i)
+        {
+            prefetch_leaf(static_cast<const bptree_node_term*>(parent->_pointers[position + i]));
+        }
+    };
+    if (!path.empty())
+    {
+        enter_parent();
+    }
+
+    size_t visited = 0;
+    while (true)
+    {
+        // Only the leaf holding hi is searched for it, the leaves before are streamed without comparisons
+        size_t last = compare_keys(leaf->_data.back().first, hi) ? leaf->_data.size() : search_in_leaf<false>(leaf, hi);
+        for (size_t i = index; i < last; ++i)
+        {
+            reference item(leaf->_data[i].first, leaf->_data[i].second);
+            visit(item);
+        }
+        visited += last > index ? last - index : 0;
+
+        if (last < leaf->_data.size() || leaf->_next == nullptr)
+        {
+            return visited;
+        }
+        leaf = leaf->_next;
+        index = 0;
+
+        if (++position < parent->_pointers.size())
+        {
+            if (position + scan_prefetch_distance < parent->_pointers.size())
+            {
+                prefetch_leaf(static_cast<const bptree_node_term*>(parent->_pointers[position + scan_prefetch_distance]));
+            }
+        }
+        else
+        {
+            // Once in a parent's worth of leaves the next parent is found from the root
+            path = node_path();
+            find_leaf(leaf->_data.front().first, &path);
+            enter_parent();
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BP_tree<tkey, tvalue, compare, t>::prefetch_leaf(const bptree_node_term* leaf) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (leaf != nullptr)
+    {
+        __builtin_prefetch(leaf);
+    }
+#endif
 }
 
-#endif
\ No newline at end of file
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename BP_tree<tkey, tvalue, compare, t>::bptree_node_base* BP_tree<tkey, tvalue, compare, t>::clone_subtree(const bptree_node_base* node, bptree_node_term*& last_leaf)
+{
+    if (node->_is_terminate)
+    {
+        auto* copy = new bptree_node_term();
+        try
+        {
+            copy->_data = static_cast<const bptree_node_term*>(node)->_data;
+        }
+        catch (...)
+        {
+            delete copy;
+            throw;
+        }
+        if (last_leaf != nullptr)
+        {
+            last_leaf->_next = copy;
+        }
+        last_leaf = copy;
+        return copy;
+    }
+
+    auto* middle = static_cast<const bptree_node_middle*>(node);
+    auto* copy = new bptree_node_middle();
+    try
+    {
+        copy->_keys = middle->_keys;
+        for (auto* child : middle->_pointers)
+        {
+            copy->_pointers.push_back(clone_subtree(child, last_leaf));
+        }
+    }
+    catch (...)
+    {
+        destroy_subtree(copy);
+        throw;
+    }
+    return copy;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BP_tree<tkey, tvalue, compare, t>::destroy_subtree(bptree_node_base* node) noexcept
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+    if (!node->_is_terminate)
+    {
+        for (auto* child : static_cast<bptree_node_middle*>(node)->_pointers)
+        {
+            destroy_subtree(child);
+        }
+    }
+    delete node;
+}
+
+// endregion helpers implementation
+
+#endif
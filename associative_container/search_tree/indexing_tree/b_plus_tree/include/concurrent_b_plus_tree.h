@@ -0,0 +1,786 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_B_PLUS_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_B_PLUS_TREE_H
+
+#include <search_tree.h>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/** Types that readers of concurrent_BP_tree copy out of nodes a writer may be changing at the same time.
+ *  Such copies go through std::atomic_ref, so the types have to be trivially copyable and lock-free as atomics
+ */
+template<typename T>
+concept optimistically_readable = std::is_trivially_copyable_v<T> && std::default_initializable<T>
+        && std::atomic_ref<T>::is_always_lock_free;
+
+/** B+ tree for many threads, built on optimistic lock coupling.
+ *  Every node has a version. A writer latches a node by setting the lowest bit of its version and bumps the
+ *  version when it releases the node. Readers latch nothing: they read a node between two loads of its version
+ *  and start over when the version changed. A descent validates the parent after it reads the child's version,
+ *  so lookups and scans never block, and a writer latches at most a node and its parent.
+ *  Inserts split full nodes on the way down, so a split never has to go up the tree.
+ *  Erase leaves underfull leaves as they are. Nodes are freed only by clear() and the destructor,
+ *  so a reader may follow a pointer before validating it, and no memory reclamation scheme is needed.
+ *  The tree takes no logger: loggers are not synchronized, and writers here run in parallel.
+ */
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare = std::less<tkey>, std::size_t t = 5>
+class concurrent_BP_tree final : private compare
+{
+public:
+
+    using value_type = std::pair<const tkey, tvalue>;
+
+private:
+
+    static constexpr const size_t maximum_keys_in_node = 2 * t - 1;
+
+    static constexpr const uint64_t latched = 1;
+
+    // Nodes are cache line aligned, so a latch never shares a line with another node
+    struct alignas(64) node_base
+    {
+        std::atomic<uint64_t> _version = 0;
+
+        std::atomic<size_t> _count = 0;
+
+        const bool _is_terminate;
+
+        explicit node_base(bool is_terminate) noexcept;
+    };
+
+    struct node_term final : node_base
+    {
+        alignas(std::atomic_ref<tkey>::required_alignment) tkey _keys[maximum_keys_in_node]{};
+
+        alignas(std::atomic_ref<tvalue>::required_alignment) tvalue _values[maximum_keys_in_node]{};
+
+        std::atomic<node_term*> _next = nullptr;
+
+        node_term() noexcept;
+    };
+
+    struct node_middle final : node_base
+    {
+        alignas(std::atomic_ref<tkey>::required_alignment) tkey _keys[maximum_keys_in_node]{};
+
+        std::atomic<node_base*> _children[maximum_keys_in_node + 1]{};
+
+        node_middle() noexcept;
+    };
+
+    std::atomic<node_base*> _root;
+
+    std::atomic<size_t> _size = 0;
+
+public:
+
+    explicit concurrent_BP_tree(const compare& comp = compare());
+
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    explicit concurrent_BP_tree(iterator begin, iterator end, const compare& cmp = compare());
+
+    concurrent_BP_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp = compare());
+
+    concurrent_BP_tree(concurrent_BP_tree const &other) = delete;
+
+    concurrent_BP_tree &operator=(concurrent_BP_tree const &other) = delete;
+
+    // No operation may run while the tree is destroyed
+    ~concurrent_BP_tree() noexcept;
+
+public:
+
+    // region readers, safe from any thread at any time, never block
+
+    bool contains(const tkey& key) const;
+
+    // Copy of the value, empty if the key is absent
+    std::optional<tvalue> lookup(const tkey& key) const;
+
+    /** Streams copies of the elements with keys in [lo, hi) to visit in key order, leaf by leaf.
+     *  Each leaf is copied and validated before any of its elements is visited, so visit sees every key once
+     *  and never sees a torn element. The scan is not one atomic view: writes made during it may be missed.
+     *  Returns the number of visited elements
+     */
+    template<typename visitor>
+    size_t scan(const tkey& lo, const tkey& hi, visitor&& visit) const;
+
+    size_t size() const noexcept;
+
+    bool empty() const noexcept;
+
+    compare key_comp() const;
+
+    // endregion readers, safe from any thread at any time, never block
+
+    // region writers, safe from any thread at any time, latch the nodes they change
+
+    // Returns whether the key was absent
+    bool insert(const value_type& value);
+
+    template<class ...Args>
+    bool emplace(Args&& ...args);
+
+    // Returns whether the key was absent
+    bool insert_or_assign(const value_type& value);
+
+    // Returns whether the key was present
+    bool erase(const tkey& key);
+
+    // endregion writers, safe from any thread at any time, latch the nodes they change
+
+    // No operation may run concurrently with clear
+    void clear() noexcept;
+
+private:
+
+    inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+    // Fields that a reader may read while a writer changes them are accessed through these
+    template<typename T>
+    static T load(const T& field) noexcept;
+
+    template<typename T>
+    static void store(T& field, const T& value) noexcept;
+
+    // region latches
+
+    // Version of node once no writer holds it
+    static uint64_t read_version(const node_base* node) noexcept;
+
+    // Whether node kept version while it was read
+    static bool validate(const node_base* node, uint64_t version) noexcept;
+
+    // Latches node if it still has version
+    static bool try_latch(node_base* node, uint64_t version) noexcept;
+
+    static void release(node_base* node) noexcept;
+
+    // endregion latches
+
+    // Number of keys of node, kept within bounds while the node is being read optimistically
+    static size_t key_count(const node_base* node) noexcept;
+
+    // Position of the first key of node's keys that does not precede key, with upper the first greater one
+    template<bool upper>
+    size_t search(const tkey* keys, size_t count, const tkey& key) const;
+
+    // Leaf holding key and the version it was read at
+    std::pair<node_term*, uint64_t> descend(const tkey& key) const;
+
+    bool insert_data(const tkey& key, const tvalue& value, bool assign);
+
+    /** Splits the full node, whose version is version, and adds the separator to parent, or to a new root
+     *  when parent is nullptr. Does nothing when either node changed since its version was read
+     */
+    void split(node_middle* parent, uint64_t parent_version, node_base* node, uint64_t version);
+
+    static void destroy_subtree(node_base* node) noexcept;
+};
+
+// region node implementation
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+concurrent_BP_tree<tkey, tvalue, compare, t>::node_base::node_base(bool is_terminate) noexcept : _is_terminate(is_terminate) {}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+concurrent_BP_tree<tkey, tvalue, compare, t>::node_term::node_term() noexcept : node_base(true) {}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+concurrent_BP_tree<tkey, tvalue, compare, t>::node_middle::node_middle() noexcept : node_base(false) {}
+
+// endregion node implementation
+
+// region construction implementation
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+concurrent_BP_tree<tkey, tvalue, compare, t>::concurrent_BP_tree(
+        const compare& comp) : compare(comp), _root(new node_term()) {}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+concurrent_BP_tree<tkey, tvalue, compare, t>::concurrent_BP_tree(
+        iterator begin,
+        iterator end,
+        const compare& cmp) : concurrent_BP_tree(cmp)
+{
+    for (; begin != end; ++begin)
+    {
+        emplace(*begin);
+    }
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+concurrent_BP_tree<tkey, tvalue, compare, t>::concurrent_BP_tree(
+        std::initializer_list<std::pair<tkey, tvalue>> data,
+        const compare& cmp) : concurrent_BP_tree(data.begin(), data.end(), cmp) {}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+concurrent_BP_tree<tkey, tvalue, compare, t>::~concurrent_BP_tree() noexcept
+{
+    destroy_subtree(_root.load(std::memory_order_relaxed));
+}
+
+// endregion construction implementation
+
+// region readers implementation
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const
+{
+    return lookup(key).has_value();
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+std::optional<tvalue> concurrent_BP_tree<tkey, tvalue, compare, t>::lookup(const tkey& key) const
+{
+    while (true)
+    {
+        auto [leaf, version] = descend(key);
+        size_t count = key_count(leaf);
+        size_t index = search<false>(leaf->_keys, count, key);
+        std::optional<tvalue> found;
+
+        if (index < count && !compare_keys(key, load(leaf->_keys[index])))
+        {
+            found = load(leaf->_values[index]);
+        }
+
+        if (validate(leaf, version))
+        {
+            return found;
+        }
+    }
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+template<typename visitor>
+size_t concurrent_BP_tree<tkey, tvalue, compare, t>::scan(const tkey& lo, const tkey& hi, visitor&& visit) const
+{
+    if (!compare_keys(lo, hi))
+    {
+        return 0;
+    }
+
+    // Keys and values are copied apart, visit gets a value_type built from them
+    tkey copied_keys[maximum_keys_in_node];
+    tvalue copied_values[maximum_keys_in_node];
+    size_t visited = 0;
+
+    // After a restart the scan goes on after the last visited key
+    tkey last{};
+    bool has_last = false;
+
+    while (true)
+    {
+        auto [leaf, version] = descend(has_last ? last : lo);
+        bool descended = true;
+
+        while (true)
+        {
+            size_t count = key_count(leaf);
+            size_t index = !descended ? 0 : has_last ? search<true>(leaf->_keys, count, last) : search<false>(leaf->_keys, count, lo);
+            size_t taken = 0;
+            bool reached_hi = false;
+
+            for (; index < count; ++index)
+            {
+                tkey key = load(leaf->_keys[index]);
+                if (!compare_keys(key, hi))
+                {
+                    reached_hi = true;
+                    break;
+                }
+                copied_keys[taken] = key;
+                copied_values[taken++] = load(leaf->_values[index]);
+            }
+
+            node_term* next = leaf->_next.load(std::memory_order_acquire);
+
+            if (!validate(leaf, version))
+            {
+                break;
+            }
+
+#if defined(__GNUC__) || defined(__clang__)
+            if (next != nullptr)
+            {
+                __builtin_prefetch(next);
+            }
+#endif
+
+            for (size_t i = 0; i < taken; ++i)
+            {
+                const value_type item(copied_keys[i], copied_values[i]);
+                visit(item);
+            }
+
+            visited += taken;
+            if (taken != 0)
+            {
+                last = copied_keys[taken - 1];
+                has_last = true;
+            }
+
+            if (reached_hi || next == nullptr)
+            {
+                return visited;
+            }
+
+            // Keys of next are greater than the keys of leaf, even when either splits in between
+            leaf = next;
+            version = read_version(leaf);
+            descended = false;
+        }
+    }
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+size_t concurrent_BP_tree<tkey, tvalue, compare, t>::size() const noexcept
+{
+    return _size.load(std::memory_order_acquire);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+compare concurrent_BP_tree<tkey, tvalue, compare, t>::key_comp() const
+{
+    return static_cast<const compare&>(*this);
+}
+
+// endregion readers implementation
+
+// region writers implementation
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::insert(const value_type& value)
+{
+    return insert_data(value.first, value.second, false);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+template<class ...Args>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::emplace(Args&& ...args)
+{
+    std::pair<tkey, tvalue> data(std::forward<Args>(args)...);
+    return insert_data(data.first, data.second, false);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::insert_or_assign(const value_type& value)
+{
+    return insert_data(value.first, value.second, true);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::erase(const tkey& key)
+{
+    while (true)
+    {
+        auto [leaf, version] = descend(key);
+
+        // The key range of a leaf changes only when the leaf itself splits, so the latched leaf is still the one of key
+        if (!try_latch(leaf, version))
+        {
+            continue;
+        }
+
+        size_t count = leaf->_count.load(std::memory_order_relaxed);
+        size_t index = search<false>(leaf->_keys, count, key);
+
+        if (index == count || compare_keys(key, leaf->_keys[index]))
+        {
+            release(leaf);
+            return false;
+        }
+
+        for (size_t i = index + 1; i < count; ++i)
+        {
+            store(leaf->_keys[i - 1], leaf->_keys[i]);
+            store(leaf->_values[i - 1], leaf->_values[i]);
+        }
+        leaf->_count.store(count - 1, std::memory_order_relaxed);
+
+        release(leaf);
+        _size.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+void concurrent_BP_tree<tkey, tvalue, compare, t>::clear() noexcept
+{
+    destroy_subtree(_root.load(std::memory_order_relaxed));
+    _root.store(new node_term(), std::memory_order_release);
+    _size.store(0, std::memory_order_release);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::insert_data(const tkey& key, const tvalue& value, bool assign)
+{
+    while (true)
+    {
+        node_base* node = _root.load(std::memory_order_acquire);
+        uint64_t version = read_version(node);
+        if (node != _root.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        node_middle* parent = nullptr;
+        uint64_t parent_version = 0;
+        bool restart = false;
+
+        while (true)
+        {
+            // A full node is split on the way down, so its parent always has room for the separator
+            if (key_count(node) == maximum_keys_in_node)
+            {
+                if (validate(node, version))
+                {
+                    split(parent, parent_version, node, version);
+                }
+                restart = true;
+                break;
+            }
+
+            if (node->_is_terminate)
+            {
+                break;
+            }
+
+            auto* middle = static_cast<node_middle*>(node);
+            node_base* child = load(middle->_children[search<true>(middle->_keys, key_count(middle), key)]);
+            if (child == nullptr || !validate(middle, version))
+            {
+                restart = true;
+                break;
+            }
+
+            uint64_t child_version = read_version(child);
+            if (!validate(middle, version))
+            {
+                restart = true;
+                break;
+            }
+
+            parent = middle;
+            parent_version = version;
+            node = child;
+            version = child_version;
+        }
+
+        auto* leaf = static_cast<node_term*>(node);
+        if (restart || !try_latch(leaf, version))
+        {
+            continue;
+        }
+
+        size_t count = leaf->_count.load(std::memory_order_relaxed);
+        size_t index = search<false>(leaf->_keys, count, key);
+
+        if (index < count && !compare_keys(key, leaf->_keys[index]))
+        {
+            if (assign)
+            {
+                store(leaf->_values[index], value);
+            }
+            release(leaf);
+            return false;
+        }
+
+        for (size_t i = count; i > index; --i)
+        {
+            store(leaf->_keys[i], leaf->_keys[i - 1]);
+            store(leaf->_values[i], leaf->_values[i - 1]);
+        }
+        store(leaf->_keys[index], key);
+        store(leaf->_values[index], value);
+        leaf->_count.store(count + 1, std::memory_order_relaxed);
+
+        release(leaf);
+        _size.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+void concurrent_BP_tree<tkey, tvalue, compare, t>::split(node_middle* parent, uint64_t parent_version, node_base* node, uint64_t version)
+{
+    if (parent != nullptr && !try_latch(parent, parent_version))
+    {
+        return;
+    }
+    if (!try_latch(node, version))
+    {
+        if (parent != nullptr)
+        {
+            release(parent);
+        }
+        return;
+    }
+
+    // The root only changes by a split of the root, which would have changed the version of node
+    node_base* sibling = nullptr;
+    node_middle* root = nullptr;
+    try
+    {
+        sibling = node->_is_terminate ? static_cast<node_base*>(new node_term()) : new node_middle();
+        root = parent == nullptr ? new node_middle() : nullptr;
+    }
+    catch (...)
+    {
+        destroy_subtree(sibling);
+        release(node);
+        if (parent != nullptr)
+        {
+            release(parent);
+        }
+        throw;
+    }
+
+    // The sibling is filled before it is linked in, the release stores of the links publish its contents
+    size_t count = node->_count.load(std::memory_order_relaxed);
+    size_t middle = count / 2;
+    tkey separator;
+
+    if (node->_is_terminate)
+    {
+        auto* leaf = static_cast<node_term*>(node);
+        auto* right = static_cast<node_term*>(sibling);
+
+        std::copy(leaf->_keys + middle, leaf->_keys + count, right->_keys);
+        std::copy(leaf->_values + middle, leaf->_values + count, right->_values);
+        right->_count.store(count - middle, std::memory_order_relaxed);
+        right->_next.store(leaf->_next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        separator = right->_keys[0];
+
+        leaf->_count.store(middle, std::memory_order_relaxed);
+        leaf->_next.store(right, std::memory_order_release);
+    }
+    else
+    {
+        // Unlike in a leaf, the middle key leaves the node and goes up
+        auto* inner = static_cast<node_middle*>(node);
+        auto* right = static_cast<node_middle*>(sibling);
+
+        std::copy(inner->_keys + middle + 1, inner->_keys + count, right->_keys);
+        for (size_t i = middle + 1; i <= count; ++i)
+        {
+            right->_children[i - middle - 1].store(inner->_children[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        right->_count.store(count - middle - 1, std::memory_order_relaxed);
+        separator = inner->_keys[middle];
+
+        inner->_count.store(middle, std::memory_order_relaxed);
+    }
+
+    if (parent == nullptr)
+    {
+        root->_keys[0] = separator;
+        root->_children[0].store(node, std::memory_order_relaxed);
+        root->_children[1].store(sibling, std::memory_order_relaxed);
+        root->_count.store(1, std::memory_order_relaxed);
+        _root.store(root, std::memory_order_release);
+    }
+    else
+    {
+        size_t parent_count = parent->_count.load(std::memory_order_relaxed);
+        size_t position = search<true>(parent->_keys, parent_count, separator);
+
+        for (size_t i = parent_count; i > position; --i)
+        {
+            store(parent->_keys[i], parent->_keys[i - 1]);
+            parent->_children[i + 1].store(parent->_children[i].load(std::memory_order_relaxed), std::memory_order_release);
+        }
+        store(parent->_keys[position], separator);
+        parent->_children[position + 1].store(sibling, std::memory_order_release);
+        parent->_count.store(parent_count + 1, std::memory_order_relaxed);
+        release(parent);
+    }
+
+    release(node);
+}
+
+// endregion writers implementation
+
+// region helpers implementation
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::compare_keys(const tkey& lhs, const tkey& rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+template<typename T>
+T concurrent_BP_tree<tkey, tvalue, compare, t>::load(const T& field) noexcept
+{
+    if constexpr (std::is_same_v<T, std::atomic<node_base*>>)
+    {
+        return field.load(std::memory_order_acquire);
+    }
+    else
+    {
+        return std::atomic_ref<T>(const_cast<T&>(field)).load(std::memory_order_relaxed);
+    }
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+template<typename T>
+void concurrent_BP_tree<tkey, tvalue, compare, t>::store(T& field, const T& value) noexcept
+{
+    std::atomic_ref<T>(field).store(value, std::memory_order_relaxed);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+uint64_t concurrent_BP_tree<tkey, tvalue, compare, t>::read_version(const node_base* node) noexcept
+{
+    uint64_t version = node->_version.load(std::memory_order_acquire);
+
+    for (size_t spins = 1; version & latched; ++spins)
+    {
+        // A latch is held for a few stores, unless its holder was preempted
+        if (spins % 16 == 0)
+        {
+            std::this_thread::yield();
+        }
+        version = node->_version.load(std::memory_order_acquire);
+    }
+
+    return version;
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::validate(const node_base* node, uint64_t version) noexcept
+{
+    // Keeps the reads of the node before the second load of the version
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return node->_version.load(std::memory_order_relaxed) == version;
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+bool concurrent_BP_tree<tkey, tvalue, compare, t>::try_latch(node_base* node, uint64_t version) noexcept
+{
+    if (!node->_version.compare_exchange_strong(version, version | latched, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    // Keeps the changes of the node after the latch, as a reader that sees a change has to see the latch
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+void concurrent_BP_tree<tkey, tvalue, compare, t>::release(node_base* node) noexcept
+{
+    node->_version.fetch_add(latched, std::memory_order_release);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+size_t concurrent_BP_tree<tkey, tvalue, compare, t>::key_count(const node_base* node) noexcept
+{
+    return std::min(node->_count.load(std::memory_order_relaxed), maximum_keys_in_node);
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+template<bool upper>
+size_t concurrent_BP_tree<tkey, tvalue, compare, t>::search(const tkey* keys, size_t count, const tkey& key) const
+{
+    size_t lo = 0;
+    size_t hi = count;
+
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        tkey current = load(keys[mid]);
+
+        if (upper ? !compare_keys(key, current) : compare_keys(current, key))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+std::pair<typename concurrent_BP_tree<tkey, tvalue, compare, t>::node_term*, uint64_t> concurrent_BP_tree<tkey, tvalue, compare, t>::descend(const tkey& key) const
+{
+    while (true)
+    {
+        node_base* node = _root.load(std::memory_order_acquire);
+        uint64_t version = read_version(node);
+        if (node != _root.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        bool restart = false;
+
+        while (!node->_is_terminate)
+        {
+            auto* middle = static_cast<node_middle*>(node);
+            node_base* child = load(middle->_children[search<true>(middle->_keys, key_count(middle), key)]);
+
+            // Nodes are never freed while the tree lives, so child can be read before the parent is validated
+            uint64_t child_version = child == nullptr ? 0 : read_version(child);
+            if (child == nullptr || !validate(middle, version))
+            {
+                restart = true;
+                break;
+            }
+
+            node = child;
+            version = child_version;
+        }
+
+        if (!restart)
+        {
+            return {static_cast<node_term*>(node), version};
+        }
+    }
+}
+
+template<optimistically_readable tkey, optimistically_readable tvalue, compator<tkey> compare, std::size_t t>
+void concurrent_BP_tree<tkey, tvalue, compare, t>::destroy_subtree(node_base* node) noexcept
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+
+    if (node->_is_terminate)
+    {
+        delete static_cast<node_term*>(node);
+        return;
+    }
+
+    auto* middle = static_cast<node_middle*>(node);
+    for (size_t i = 0; i <= middle->_count.load(std::memory_order_relaxed); ++i)
+    {
+        destroy_subtree(middle->_children[i].load(std::memory_order_relaxed));
+    }
+    delete middle;
+}
+
+// endregion helpers implementation
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_B_PLUS_TREE_H
@@ -1,9 +1,13 @@
 #include "gtest/gtest.h"
 
 #include <list>
+#include <map>
 #include <random>
+#include <thread>
 #include <vector>
 #include <b_plus_tree.h>
+#include <concurrent_b_plus_tree.h>
+#include <random_operations_test.h>
 #include <client_logger_builder.h>
 
 
@@ -146,8 +150,8 @@ TEST(bTreePositiveTests, test1)
                     test_data<int, std::string>(1, 2, "b"),
                     test_data<int, std::string>(2, 3, "d"),
                     test_data<int, std::string>(0, 4, "e"),
-                    test_data<int, std::string>(0, 15, "c"),
-                    test_data<int, std::string>(1, 27, "f")
+                    test_data<int, std::string>(1, 15, "c"),
+                    test_data<int, std::string>(2, 27, "f")
             };
 
     BP_tree<int, std::string, std::less<int>, 3> tree(std::less<int>(), nullptr, logger.get());
@@ -181,12 +185,12 @@ TEST(bTreePositiveTests, test2)
                     test_data<int, std::string>(3, 4, "e"),
                     test_data<int, std::string>(4, 15, "c"),
                     test_data<int, std::string>(0, 24, "g"),
-                    test_data<int, std::string>(0, 45, "k"),
-                    test_data<int, std::string>(1, 100, "f"),
-                    test_data<int, std::string>(2, 101, "j"),
-                    test_data<int, std::string>(3, 193, "l"),
-                    test_data<int, std::string>(4, 456, "h"),
-                    test_data<int, std::string>(5, 534, "m")
+                    test_data<int, std::string>(1, 45, "k"),
+                    test_data<int, std::string>(2, 100, "f"),
+                    test_data<int, std::string>(3, 101, "j"),
+                    test_data<int, std::string>(4, 193, "l"),
+                    test_data<int, std::string>(5, 456, "h"),
+                    test_data<int, std::string>(6, 534, "m")
             };
 
     BP_tree<int, std::string, std::less<int>, 5> tree(std::less<int>(), nullptr, logger.get());
@@ -269,14 +273,14 @@ TEST(bTreePositiveTests, test4)
                     test_data<int, std::string>(1, 2, "b"),
                     test_data<int, std::string>(2, 3, "d"),
                     test_data<int, std::string>(0, 4, "e"),
-                    test_data<int, std::string>(0, 15, "c"),
-                    test_data<int, std::string>(1, 24, "g"),
-                    test_data<int, std::string>(2, 45, "k"),
-                    test_data<int, std::string>(1, 100, "f"),
-                    test_data<int, std::string>(0, 101, "j"),
-                    test_data<int, std::string>(1, 193, "l"),
-                    test_data<int, std::string>(2, 456, "h"),
-                    test_data<int, std::string>(3, 534, "m")
+                    test_data<int, std::string>(1, 15, "c"),
+                    test_data<int, std::string>(2, 24, "g"),
+                    test_data<int, std::string>(3, 45, "k"),
+                    test_data<int, std::string>(0, 100, "f"),
+                    test_data<int, std::string>(1, 101, "j"),
+                    test_data<int, std::string>(2, 193, "l"),
+                    test_data<int, std::string>(3, 456, "h"),
+                    test_data<int, std::string>(4, 534, "m")
             };
 
     BP_tree<int, std::string, std::less<int>, 3> tree(std::less<int>(), nullptr, logger.get());
@@ -346,11 +350,11 @@ TEST(bTreePositiveTests, test6)
                     test_data<int, std::string>(0, 2, "b"),
                     test_data<int, std::string>(1, 3, "d"),
                     test_data<int, std::string>(2, 4, "e"),
-                    test_data<int, std::string>(0, 15, "c"),
-                    test_data<int, std::string>(0, 45, "k"),
-                    test_data<int, std::string>(1, 101, "j"),
-                    test_data<int, std::string>(2, 456, "h"),
-                    test_data<int, std::string>(3, 534, "m")
+                    test_data<int, std::string>(3, 15, "c"),
+                    test_data<int, std::string>(4, 45, "k"),
+                    test_data<int, std::string>(0, 101, "j"),
+                    test_data<int, std::string>(1, 456, "h"),
+                    test_data<int, std::string>(2, 534, "m")
             };
 
     BP_tree<int, std::string, std::less<int>, 4> tree(std::less<int>(), nullptr, logger.get());
@@ -530,8 +534,8 @@ TEST(bTreePositiveTests, test9)
     tree.emplace(193, std::string("l"));
     tree.emplace(534, std::string("m"));
 
-    auto b = tree.begin();
-    auto e = tree.end();
+    auto b = tree.lower_bound(4);
+    auto e = tree.upper_bound(101);
     std::vector<decltype(tree)::value_type> actual_result(b, e);
 
     EXPECT_TRUE(compare_obtain_results(expected_result, actual_result));
@@ -539,6 +543,212 @@ TEST(bTreePositiveTests, test9)
     logger->trace("bTreePositiveTests.test9 finished");
 }
 
+TEST(bTreePositiveTests, test10)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test10 started");
+
+    // Insertions and removals with leaf and middle node splits, borrows and merges
+    // Scans cross leaf boundaries through the links between the leaves
+    auto scans_agree = [](auto const &tree, std::map<int, int> const &expected)
+    {
+        for (int key = -1; key <= 2001; ++key)
+        {
+            std::vector<int> scanned;
+            size_t count = tree.scan(key, key + 100, [&scanned](auto const &item) { scanned.push_back(item.first); });
+            std::vector<int> expected_scanned;
+            for (auto it = expected.lower_bound(key); it != expected.end() && it->first < key + 100; ++it)
+            {
+                expected_scanned.push_back(it->first);
+            }
+            ASSERT_EQ(count, expected_scanned.size());
+            ASSERT_EQ(scanned, expected_scanned);
+        }
+    };
+
+    std::mt19937 engine(10);
+    random_operations_test<BP_tree<int, int, std::less<int>, 2>>(engine, scans_agree);
+    random_operations_test<BP_tree<int, int, std::less<int>, 3>>(engine, scans_agree);
+    random_operations_test<BP_tree<int, int, std::less<int>, 16>>(engine, scans_agree);
+    random_operations_test<BP_tree<int, int, std::less<int>, 64>>(engine, scans_agree);
+
+    BP_tree<int, std::string, std::less<int>, 3> tree(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        tree.emplace(i, std::to_string(i));
+    }
+
+    size_t count = tree.scan(10, 60, [](auto &item) { item.second += "!"; });
+
+    EXPECT_EQ(count, 50);
+    EXPECT_EQ(tree.at(9), "9");
+    EXPECT_EQ(tree.at(10), "10!");
+    EXPECT_EQ(tree.at(59), "59!");
+    EXPECT_EQ(tree.at(60), "60");
+    EXPECT_EQ(tree.scan(60, 10, [](auto const &) {}), 0);
+    EXPECT_EQ(std::as_const(tree).scan(95, 1000, [](auto const &) {}), 5);
+
+    logger->trace("bTreePositiveTests.test10 finished");
+}
+
+TEST(bTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test11 started");
+
+    std::mt19937 engine(11);
+    concurrent_BP_tree<int, int, std::less<int>, 3> tree;
+    std::map<int, int> expected;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        int key = static_cast<int>(engine() % 3000);
+
+        switch (engine() % 5)
+        {
+            case 0:
+                ASSERT_EQ(tree.emplace(key, i), expected.emplace(key, i).second);
+                break;
+            case 1:
+                ASSERT_EQ(tree.insert_or_assign({key, i}), !expected.contains(key));
+                expected.insert_or_assign(key, i);
+                break;
+            case 2:
+                ASSERT_EQ(tree.erase(key), expected.erase(key) == 1);
+                break;
+            case 3:
+            {
+                auto value = tree.lookup(key);
+                auto expected_it = expected.find(key);
+
+                ASSERT_EQ(value.has_value(), expected_it != expected.end());
+
+                if (value)
+                {
+                    ASSERT_EQ(*value, expected_it->second);
+                }
+
+                break;
+            }
+            default:
+            {
+                auto expected_it = expected.lower_bound(key);
+                size_t visited = tree.scan(key, key + 50, [&](auto const &element)
+                {
+                    EXPECT_EQ(element.first, expected_it->first);
+                    EXPECT_EQ(element.second, expected_it->second);
+                    ++expected_it;
+                });
+
+                ASSERT_EQ(visited, static_cast<size_t>(std::distance(expected.lower_bound(key), expected.lower_bound(key + 50))));
+                break;
+            }
+        }
+    }
+
+    ASSERT_EQ(tree.size(), expected.size());
+
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    EXPECT_FALSE(tree.contains(expected.begin()->first));
+
+    // Readers run while writers split and shrink leaves with odd keys, even keys are never touched
+    for (int key = 0; key < 4000; key += 2)
+    {
+        tree.emplace(key, key * 10);
+    }
+
+    std::atomic<bool> stop = false;
+    std::atomic<size_t> failures = 0;
+    std::vector<std::thread> readers;
+    std::vector<std::thread> writers;
+
+    for (int t = 0; t < 2; ++t)
+    {
+        readers.emplace_back([&tree, &stop, &failures, t]
+        {
+            unsigned seed = t;
+
+            while (!stop.load())
+            {
+                int key = (rand_r(&seed) % 2000) * 2;
+
+                if (tree.lookup(key) != key * 10)
+                {
+                    ++failures;
+                }
+
+                int previous = -1;
+                size_t even = 0;
+
+                tree.scan(key, key + 400, [&](auto const &element)
+                {
+                    if (element.first <= previous || (element.first % 2 == 0 && element.second != element.first * 10))
+                    {
+                        ++failures;
+                    }
+
+                    previous = element.first;
+                    even += element.first % 2 == 0;
+                });
+
+                if (even != static_cast<size_t>(std::min(200, 2000 - key / 2)))
+                {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    for (int t = 0; t < 2; ++t)
+    {
+        writers.emplace_back([&tree, t]
+        {
+            unsigned seed = 100 + t;
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                int key = (rand_r(&seed) % 3000) * 2 + 1;
+
+                if (rand_r(&seed) % 3)
+                {
+                    tree.insert_or_assign({key, i});
+                }
+                else
+                {
+                    tree.erase(key);
+                }
+            }
+        });
+    }
+
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+
+    stop = true;
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(tree.scan(-1, 10000, [](auto const &) {}), tree.size());
+
+    logger->trace("bTreePositiveTests.test11 finished");
+}
+
 TEST(bTreeNegativeTests, test1)
 {
     std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <iterator>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 #include <boost/container/static_vector.hpp>
@@ -12,6 +14,13 @@
 #ifndef MP_OS_BS_TREE_H
 #define MP_OS_BS_TREE_H
 
+/** B* tree: a B tree whose nodes other than the root stay at least two thirds full.
+ *  An overflowing node first spills keys to an adjacent sibling that has room, and only when that sibling is full
+ *  the two of them are split into three. An underflowing node first borrows from an adjacent sibling,
+ *  and only when its siblings are at the minimum three of them are merged into two.
+ *  The root still splits in two, so while it has a single key its two children are held to half fill, as in a B tree.
+ *  Iterators keep the path from the root, and any insertion or removal invalidates them
+ */
 template <typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, std::size_t t = 5>
 class BS_tree final : private logger_guardant, private compare
 {
@@ -23,10 +32,18 @@ public:
 
 private:
 
-    // TODO: Another restrictions
-    static constexpr const size_t minimum_keys_in_node = t - 1;
+    static_assert(t >= 2, "B* tree nodes have to be able to give keys to their siblings");
+
     static constexpr const size_t maximum_keys_in_node = 2 * t - 1;
 
+    /** A split of two full nodes into three leaves each of them with two thirds of the keys.
+     *  Nodes of t = 2 split into single key nodes, which have no third sibling to merge with, so they keep the B tree minimum
+     */
+    static constexpr const size_t minimum_keys_in_node = t > 2 ? 2 * maximum_keys_in_node / 3 : t - 1;
+
+    // Children of a node with a single key, which for t > 2 is only the root after it was split in two
+    static constexpr const size_t minimum_keys_in_root_child = t - 1;
+
     // region comparators declaration
 
     inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
@@ -45,6 +62,14 @@ private:
 //        bstree_node(pp_allocator<bstree_node*> al);
     };
 
+    // Element of the iterators' pointer type, keeps the pair of references alive for operator->
+    template<typename reference>
+    struct arrow_proxy
+    {
+        reference _ref;
+        const reference* operator->() const noexcept { return &_ref; }
+    };
+
     pp_allocator<value_type> _allocator;
     logger* _logger;
     bstree_node* _root;
@@ -53,6 +78,9 @@ private:
     logger* get_logger() const noexcept override;
     pp_allocator<value_type> get_allocator() const noexcept;
 
+    using node_path = std::stack<std::pair<bstree_node**, size_t>>;
+    using const_node_path = std::stack<std::pair<bstree_node* const*, size_t>>;
+
 public:
 
     // region constructors declaration
@@ -96,13 +124,13 @@ public:
 
     public:
         using value_type = tree_data_type_const;
-        using reference = value_type&;
-        using pointer = value_type*;
+        using reference = std::pair<const tkey&, tvalue&>;
+        using pointer = arrow_proxy<reference>;
         using iterator_category = std::bidirectional_iterator_tag;
         using difference_type = ptrdiff_t;
         using self = bstree_iterator;
 
-        friend class B_tree;
+        friend class BS_tree;
         friend class bstree_reverse_iterator;
         friend class bstree_const_iterator;
         friend class bstree_const_reverse_iterator;
@@ -136,13 +164,13 @@ public:
     public:
 
         using value_type = tree_data_type_const;
-        using reference = const value_type&;
-        using pointer = const value_type*;
+        using reference = std::pair<const tkey&, const tvalue&>;
+        using pointer = arrow_proxy<reference>;
         using iterator_category = std::bidirectional_iterator_tag;
         using difference_type = ptrdiff_t;
         using self = bstree_const_iterator;
 
-        friend class B_tree;
+        friend class BS_tree;
         friend class bstree_reverse_iterator;
         friend class bstree_iterator;
         friend class bstree_const_reverse_iterator;
@@ -177,13 +205,13 @@ public:
     public:
 
         using value_type = tree_data_type_const;
-        using reference = value_type&;
-        using pointer = value_type*;
+        using reference = std::pair<const tkey&, tvalue&>;
+        using pointer = arrow_proxy<reference>;
         using iterator_category = std::bidirectional_iterator_tag;
         using difference_type = ptrdiff_t;
         using self = bstree_reverse_iterator;
 
-        friend class B_tree;
+        friend class BS_tree;
         friend class bstree_iterator;
         friend class bstree_const_iterator;
         friend class bstree_const_reverse_iterator;
@@ -219,13 +247,13 @@ public:
     public:
 
         using value_type = tree_data_type_const;
-        using reference = const value_type&;
-        using pointer = const value_type*;
+        using reference = std::pair<const tkey&, const tvalue&>;
+        using pointer = arrow_proxy<reference>;
         using iterator_category = std::bidirectional_iterator_tag;
         using difference_type = ptrdiff_t;
         using self = bstree_const_reverse_iterator;
 
-        friend class B_tree;
+        friend class BS_tree;
         friend class bstree_reverse_iterator;
         friend class bstree_const_iterator;
         friend class bstree_iterator;
@@ -355,6 +383,81 @@ public:
     bstree_iterator erase(const tkey& key);
 
     // endregion modifiers declaration
+
+    // region statistics declaration
+
+    // Shape of the tree, fills are shares of maximum_keys_in_node
+    struct fill_statistics
+    {
+        size_t height = 0;
+        size_t nodes = 0;
+        size_t keys = 0;
+        size_t node_bytes = 0;
+        double average_fill = 0;
+
+        // Least filled node held to minimum_keys_in_node, that is any node but the root and the children of a node with one key
+        double minimum_fill = 1;
+    };
+
+    fill_statistics fill() const;
+
+    // endregion statistics declaration
+
+private:
+
+    // region helpers declaration
+
+    // Position of the first key of node that is not less than key, or greater than key with upper
+    template<bool upper>
+    size_t search(const bstree_node* node, const tkey& key) const;
+
+    // Item with key, found without building the iterator path, or nullptr
+    tree_data_type* locate(const tkey& key) const;
+
+    /** Path from root to the position of the first element that is not less than key (greater with upper).
+     *  Ancestors hold the index of the child the path went to, the last node the position in it.
+     *  The path stops at an internal node holding key, and it may end past the last key of a leaf
+     */
+    template<bool upper, typename slot>
+    std::stack<std::pair<slot, size_t>> descend(slot root, const tkey& key) const;
+
+    // Drops the nodes the path has already passed, leaves the path empty at the end of the tree
+    template<typename slot>
+    static void normalize(std::stack<std::pair<slot, size_t>>& path) noexcept;
+
+    template<typename slot>
+    static std::stack<std::pair<slot, size_t>> leftmost_path(slot root);
+
+    template<typename slot>
+    static std::stack<std::pair<slot, size_t>> rightmost_path(slot root);
+
+    template<typename slot>
+    static void step_forward(std::stack<std::pair<slot, size_t>>& path, size_t& index) noexcept;
+
+    template<typename slot>
+    static void step_backward(std::stack<std::pair<slot, size_t>>& path, size_t& index) noexcept;
+
+    template<typename to, typename from>
+    static std::stack<std::pair<to, size_t>> convert_path(std::stack<std::pair<from, size_t>> path);
+
+    std::pair<bstree_iterator, bool> insert_data(tree_data_type&& data, bool assign);
+
+    /** Spreads the keys of from adjacent children of parent, starting at first, together with the separators
+     *  between them, evenly over to children. Allocates or frees the children that are added or removed
+     */
+    void redistribute(bstree_node* parent, size_t first, size_t from, size_t to);
+
+    // Spills or splits the nodes of path that hold too many keys, from the bottom up
+    void fix_overflow(node_path& path);
+
+    // Borrows for or merges the nodes of path that hold too few keys, from the bottom up
+    void fix_underflow(node_path& path);
+
+    static bstree_node* clone_subtree(const bstree_node* node);
+
+    static void destroy_subtree(bstree_node* node) noexcept;
+
+    // endregion helpers declaration
 };
 
 template<std::input_iterator iterator, compator<typename std::iterator_traits<iterator>::value_type::first_type> compare = std::less<typename std::iterator_traits<iterator>::value_type::first_type>,
@@ -374,680 +477,1361 @@ bool BS_tree<tkey, tvalue, compare, t>::compare_pairs(const BS_tree::tree_data_t
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-BS_tree<tkey, tvalue, compare, t>::bstree_node::bstree_node() noexcept
+bool BS_tree<tkey, tvalue, compare, t>::compare_keys(const tkey &lhs, const tkey &rhs) const
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return compare::operator()(lhs, rhs);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+BS_tree<tkey, tvalue, compare, t>::bstree_node::bstree_node() noexcept = default;
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 logger * BS_tree<tkey, tvalue, compare, t>::get_logger() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _logger;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 pp_allocator<typename BS_tree<tkey, tvalue, compare, t>::value_type> BS_tree<tkey, tvalue, compare, t>::
 get_allocator() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _allocator;
 }
 
+// region iterators implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator::reference BS_tree<tkey, tvalue, compare, t>::
 bstree_iterator::operator*() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto& item = (*_path.top().first)->_keys[_index];
+    return reference(item.first, item.second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator::pointer BS_tree<tkey, tvalue, compare, t>::bstree_iterator
 ::operator->() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator::self & BS_tree<tkey, tvalue, compare, t>::bstree_iterator::
 operator++()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_forward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator::self BS_tree<tkey, tvalue, compare, t>::bstree_iterator::
 operator++(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    ++*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator::self & BS_tree<tkey, tvalue, compare, t>::bstree_iterator::
 operator--()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_backward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator::self BS_tree<tkey, tvalue, compare, t>::bstree_iterator::
 operator--(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    --*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_iterator::operator==(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    if (_path.empty() || other._path.empty())
+    {
+        return _path.empty() == other._path.empty();
+    }
+
+    return *_path.top().first == *other._path.top().first && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_iterator::operator!=(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return !(*this == other);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_iterator::depth() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : _path.size() - 1;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_iterator::current_node_keys_count() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : (*_path.top().first)->_keys.size();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_iterator::is_terminate_node() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() || (*_path.top().first)->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_iterator::index() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_iterator::bstree_iterator(
-    const std::stack<std::pair<bstree_node **, size_t>> &path, size_t index)
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
+    const std::stack<std::pair<bstree_node **, size_t>> &path, size_t index) : _path(path), _index(index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::bstree_const_iterator(const bstree_iterator &it) noexcept
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
+    : _path(convert_path<bstree_node* const*>(it._path)), _index(it._index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::reference BS_tree<tkey, tvalue, compare, t>::
 bstree_const_iterator::operator*() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto& item = (*_path.top().first)->_keys[_index];
+    return reference(item.first, item.second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::pointer BS_tree<tkey, tvalue, compare, t>::
 bstree_const_iterator::operator->() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::self & BS_tree<tkey, tvalue, compare, t>::
 bstree_const_iterator::operator++()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_forward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::self BS_tree<tkey, tvalue, compare, t>::
 bstree_const_iterator::operator++(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    ++*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::self & BS_tree<tkey, tvalue, compare, t>::
 bstree_const_iterator::operator--()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_backward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::self BS_tree<tkey, tvalue, compare, t>::
 bstree_const_iterator::operator--(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    --*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::operator==(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    if (_path.empty() || other._path.empty())
+    {
+        return _path.empty() == other._path.empty();
+    }
+
+    return *_path.top().first == *other._path.top().first && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::operator!=(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return !(*this == other);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::depth() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : _path.size() - 1;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::current_node_keys_count() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : (*_path.top().first)->_keys.size();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::is_terminate_node() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() || (*_path.top().first)->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::index() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator::bstree_const_iterator(
-    const std::stack<std::pair<bstree_node * const*, size_t>> &path, size_t index)
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
+    const std::stack<std::pair<bstree_node * const*, size_t>> &path, size_t index) : _path(path), _index(index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::bstree_reverse_iterator(const bstree_iterator &it) noexcept
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
+    : _path(it._path), _index(it._index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::operator BS_tree<tkey, tvalue, compare, t>::bstree_iterator() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return bstree_iterator(_path, _index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::reference BS_tree<tkey, tvalue, compare, t>::
 bstree_reverse_iterator::operator*() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto& item = (*_path.top().first)->_keys[_index];
+    return reference(item.first, item.second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::pointer BS_tree<tkey, tvalue, compare, t>::
 bstree_reverse_iterator::operator->() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::self & BS_tree<tkey, tvalue, compare, t>::
 bstree_reverse_iterator::operator++()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_backward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::self BS_tree<tkey, tvalue, compare, t>::
 bstree_reverse_iterator::operator++(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    ++*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::self & BS_tree<tkey, tvalue, compare, t>::
 bstree_reverse_iterator::operator--()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_forward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::self BS_tree<tkey, tvalue, compare, t>::
 bstree_reverse_iterator::operator--(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    --*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::operator==(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    if (_path.empty() || other._path.empty())
+    {
+        return _path.empty() == other._path.empty();
+    }
+
+    return *_path.top().first == *other._path.top().first && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::operator!=(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return !(*this == other);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::depth() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : _path.size() - 1;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::current_node_keys_count() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : (*_path.top().first)->_keys.size();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::is_terminate_node() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() || (*_path.top().first)->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::index() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator::bstree_reverse_iterator(
-    const std::stack<std::pair<bstree_node **, size_t>> &path, size_t index)
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
+    const std::stack<std::pair<bstree_node **, size_t>> &path, size_t index) : _path(path), _index(index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::bstree_const_reverse_iterator(
-    const bstree_reverse_iterator &it) noexcept
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
+    const bstree_reverse_iterator &it) noexcept : _path(convert_path<bstree_node* const*>(it._path)), _index(it._index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::operator BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return bstree_const_iterator(_path, _index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::reference BS_tree<tkey, tvalue, compare, t>::
 bstree_const_reverse_iterator::operator*() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    auto& item = (*_path.top().first)->_keys[_index];
+    return reference(item.first, item.second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::pointer BS_tree<tkey, tvalue, compare, t>::
 bstree_const_reverse_iterator::operator->() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::self & BS_tree<tkey, tvalue, compare, t>::
 bstree_const_reverse_iterator::operator++()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_backward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::self BS_tree<tkey, tvalue, compare, t>::
 bstree_const_reverse_iterator::operator++(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    ++*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::self & BS_tree<tkey, tvalue, compare, t>::
 bstree_const_reverse_iterator::operator--()
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    step_forward(_path, _index);
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::self BS_tree<tkey, tvalue, compare, t>::
 bstree_const_reverse_iterator::operator--(int)
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    self copy = *this;
+    --*this;
+    return copy;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::operator==(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    if (_path.empty() || other._path.empty())
+    {
+        return _path.empty() == other._path.empty();
+    }
+
+    return *_path.top().first == *other._path.top().first && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::operator!=(const self &other) const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return !(*this == other);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::depth() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : _path.size() - 1;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::current_node_keys_count() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() ? 0 : (*_path.top().first)->_keys.size();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::is_terminate_node() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _path.empty() || (*_path.top().first)->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::index() const noexcept
 {
-    throw not_implemented("too laazyy", "your code should be here...");
+    return _index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator::bstree_const_reverse_iterator(
-    const std::stack<std::pair<bstree_node * const*, size_t>> &path, size_t index)
-{
-    throw not_implemented("too laazyy", "your code should be here...");
-}
+    const std::stack<std::pair<bstree_node * const*, size_t>> &path, size_t index) : _path(path), _index(index) {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool BS_tree<tkey, tvalue, compare, t>::compare_keys(const tkey &lhs, const tkey &rhs) const
-{
-    return compare::operator()(lhs, rhs);
-}
+// endregion iterators implementation
+
+// region constructors implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::BS_tree(const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>::BS_tree(const compare& cmp, pp_allocator<value_type> alloc, logger* logger)", "your code should be here...");
-}
+    : compare(cmp), _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::BS_tree(pp_allocator<value_type> alloc, const compare& comp, logger* logger)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>::BS_tree(pp_allocator<value_type> alloc, const compare& comp, logger* logger)", "your code should be here...");
-}
+    : BS_tree(comp, alloc, logger) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
 BS_tree<tkey, tvalue, compare, t>::BS_tree(iterator begin, iterator end, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
+    : BS_tree(cmp, alloc, logger)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> template<input_iterator_for_pair<tkey, tvalue> iterator> BS_tree<tkey, tvalue, compare, t>::BS_tree(iterator begin, iterator end, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)", "your code should be here...");
+    for (; begin != end; ++begin)
+    {
+        insert(*begin);
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::BS_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>::BS_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* logger)", "your code should be here...");
-}
+    : BS_tree(data.begin(), data.end(), cmp, alloc, logger) {}
+
+// endregion constructors implementation
+
+// region five implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::BS_tree(const BS_tree& other)
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>::BS_tree(const BS_tree& other)", "your code should be here...");
-}
+    : compare(other), _allocator(other._allocator), _logger(other._logger),
+      _root(other._root == nullptr ? nullptr : clone_subtree(other._root)), _size(other._size) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::BS_tree(BS_tree&& other) noexcept
-{
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>::BS_tree(BS_tree&& other) noexcept", "your code should be here...");
-}
+    : compare(std::move(other)), _allocator(std::move(other._allocator)), _logger(other._logger),
+      _root(std::exchange(other._root, nullptr)), _size(std::exchange(other._size, 0)) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>& BS_tree<tkey, tvalue, compare, t>::operator=(const BS_tree& other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>& BS_tree<tkey, tvalue, compare, t>::operator=(const BS_tree& other)", "your code should be here...");
+    if (this != &other)
+    {
+        BS_tree copy(other);
+        *this = std::move(copy);
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>& BS_tree<tkey, tvalue, compare, t>::operator=(BS_tree&& other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>& BS_tree<tkey, tvalue, compare, t>::operator=(BS_tree&& other) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        clear();
+        compare::operator=(std::move(other));
+        _allocator = std::move(other._allocator);
+        _logger = other._logger;
+        _root = std::exchange(other._root, nullptr);
+        _size = std::exchange(other._size, 0);
+    }
+
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 BS_tree<tkey, tvalue, compare, t>::~BS_tree() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> BS_tree<tkey, tvalue, compare, t>::~BS_tree() noexcept", "your code should be here...");
+    clear();
 }
 
+// endregion five implementation
+
+// region element access implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue& BS_tree<tkey, tvalue, compare, t>::at(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> tvalue& BS_tree<tkey, tvalue, compare, t>::at(const tkey& key)", "your code should be here...");
+    tree_data_type* item = locate(key);
+
+    if (item == nullptr)
+    {
+        throw std::out_of_range("Key not found in B* tree");
+    }
+
+    return item->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 const tvalue& BS_tree<tkey, tvalue, compare, t>::at(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> const tvalue& BS_tree<tkey, tvalue, compare, t>::at(const tkey& key) const", "your code should be here...");
+    tree_data_type* item = locate(key);
+
+    if (item == nullptr)
+    {
+        throw std::out_of_range("Key not found in B* tree");
+    }
+
+    return item->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue& BS_tree<tkey, tvalue, compare, t>::operator[](const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> tvalue& BS_tree<tkey, tvalue, compare, t>::operator[](const tkey& key)", "your code should be here...");
+    return emplace(key, tvalue()).first->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue& BS_tree<tkey, tvalue, compare, t>::operator[](tkey&& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> tvalue& BS_tree<tkey, tvalue, compare, t>::operator[](tkey&& key)", "your code should be here...");
+    return emplace(std::move(key), tvalue()).first->second;
 }
 
+// endregion element access implementation
+
+// region iterator begins implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::begin()
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::begin()", "your code should be here...");
+    auto path = leftmost_path(&_root);
+    return bstree_iterator(path, 0);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::end()
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::end()", "your code should be here...");
+    return bstree_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::begin() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::begin() const", "your code should be here...");
+    auto path = leftmost_path(&_root);
+    return bstree_const_iterator(path, 0);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::end() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::end() const", "your code should be here...");
+    return bstree_const_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::cbegin() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::cbegin() const", "your code should be here...");
+    return begin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::cend() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::cend() const", "your code should be here...");
+    return end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rbegin()
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rbegin()", "your code should be here...");
+    auto path = rightmost_path(&_root);
+    return bstree_reverse_iterator(path, path.empty() ? 0 : path.top().second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rend()
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rend()", "your code should be here...");
+    return bstree_reverse_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rbegin() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rbegin() const", "your code should be here...");
+    auto path = rightmost_path(&_root);
+    return bstree_const_reverse_iterator(path, path.empty() ? 0 : path.top().second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rend() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::rend() const", "your code should be here...");
+    return bstree_const_reverse_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::crbegin() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::crbegin() const", "your code should be here...");
+    return rbegin();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::crend() const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_reverse_iterator BS_tree<tkey, tvalue, compare, t>::crend() const", "your code should be here...");
+    return rend();
 }
 
+// endregion iterator begins implementation
+
+// region lookup implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t BS_tree<tkey, tvalue, compare, t>::size() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> size_t BS_tree<tkey, tvalue, compare, t>::size() const noexcept", "your code should be here...");
+    return _size;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::empty() const noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> bool BS_tree<tkey, tvalue, compare, t>::empty() const noexcept", "your code should be here...");
+    return _size == 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::find(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::find(const tkey& key)", "your code should be here...");
+    auto it = lower_bound(key);
+    return it == end() || compare_keys(key, it->first) ? end() : it;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::find(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::find(const tkey& key) const", "your code should be here...");
+    auto it = lower_bound(key);
+    return it == end() || compare_keys(key, it->first) ? end() : it;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key)", "your code should be here...");
+    auto path = descend<false>(&_root, key);
+    normalize(path);
+    return bstree_iterator(path, path.empty() ? 0 : path.top().second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const", "your code should be here...");
+    auto path = descend<false>(&_root, key);
+    normalize(path);
+    return bstree_const_iterator(path, path.empty() ? 0 : path.top().second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key)", "your code should be here...");
+    auto path = descend<true>(&_root, key);
+    normalize(path);
+    return bstree_iterator(path, path.empty() ? 0 : path.top().second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_const_iterator BS_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const", "your code should be here...");
+    auto path = descend<true>(&_root, key);
+    normalize(path);
+    return bstree_const_iterator(path, path.empty() ? 0 : path.top().second);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool BS_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> bool BS_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const", "your code should be here...");
+    return locate(key) != nullptr;
 }
 
+// endregion lookup implementation
+
+// region modifiers implementation
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 void BS_tree<tkey, tvalue, compare, t>::clear() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> void BS_tree<tkey, tvalue, compare, t>::clear() noexcept", "your code should be here...");
+    destroy_subtree(_root);
+    _root = nullptr;
+    _size = 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 std::pair<typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator, bool> BS_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> std::pair<typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator, bool> BS_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data)", "your code should be here...");
+    return insert_data(tree_data_type(data), false);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 std::pair<typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator, bool> BS_tree<tkey, tvalue, compare, t>::insert(tree_data_type&& data)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> std::pair<typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator, bool> BS_tree<tkey, tvalue, compare, t>::insert(tree_data_type&& data)", "your code should be here...");
+    return insert_data(std::move(data), false);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-template <typename ...Args>
+template<typename ...Args>
 std::pair<typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator, bool> BS_tree<tkey, tvalue, compare, t>::emplace(Args&&... args)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> template <typename ...Args> std::pair<typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator, bool> BS_tree<tkey, tvalue, compare, t>::emplace(Args&&... args)", "your code should be here...");
+    return insert_data(tree_data_type(std::forward<Args>(args)...), false);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::insert_or_assign(const tree_data_type& data)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::insert_or_assign(const tree_data_type& data)", "your code should be here...");
+    return insert_data(tree_data_type(data), true).first;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::insert_or_assign(tree_data_type&& data)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::insert_or_assign(tree_data_type&& data)", "your code should be here...");
+    return insert_data(std::move(data), true).first;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-template <typename ...Args>
+template<typename ...Args>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::emplace_or_assign(Args&&... args)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> template <typename ...Args> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::emplace_or_assign(Args&&... args)", "your code should be here...");
+    return insert_data(tree_data_type(std::forward<Args>(args)...), true).first;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_iterator pos)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_iterator pos)", "your code should be here...");
+    return erase(tkey(pos->first));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_const_iterator pos)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_const_iterator pos)", "your code should be here...");
+    return erase(tkey(pos->first));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_iterator beg, bstree_iterator en)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_iterator beg, bstree_iterator en)", "your code should be here...");
+    return erase(bstree_const_iterator(beg), bstree_const_iterator(en));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_const_iterator beg, bstree_const_iterator en)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(bstree_const_iterator beg, bstree_const_iterator en)", "your code should be here...");
+    // Every erase moves keys between nodes, so the range is tracked by the key it stops at
+    if (en == cend())
+    {
+        while (beg != cend())
+        {
+            beg = erase(beg);
+        }
+
+        return end();
+    }
+
+    tkey last = en->first;
+    bstree_iterator current = lower_bound(beg->first);
+
+    while (current != end() && compare_keys(current->first, last))
+    {
+        current = erase(current);
+    }
+
+    return current;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(const tkey& key)
 {
-    throw not_implemented(
-            "template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t> typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator BS_tree<tkey, tvalue, compare, t>::erase(const tkey& key)",
-            "your code should be here...");
+    auto path = descend<false>(&_root, key);
+
+    if (path.empty())
+    {
+        return end();
+    }
+
+    bstree_node* node = *path.top().first;
+    size_t position = path.top().second;
+
+    if (position == node->_keys.size() || compare_keys(key, node->_keys[position].first))
+    {
+        return end();
+    }
+
+    if (node->_pointers.empty())
+    {
+        node->_keys.erase(node->_keys.begin() + position);
+    }
+    else
+    {
+        // A key of an internal node is replaced with its successor, which always lies in a leaf
+        path.top().second = position + 1;
+        bstree_node** slot = &node->_pointers[position + 1];
+
+        while (!(*slot)->_pointers.empty())
+        {
+            path.push({slot, 0});
+            slot = &(*slot)->_pointers.front();
+        }
+        path.push({slot, 0});
+
+        bstree_node* leaf = *slot;
+        node->_keys[position] = std::move(leaf->_keys.front());
+        leaf->_keys.erase(leaf->_keys.begin());
+    }
+
+    --_size;
+    fix_underflow(path);
+
+    return lower_bound(key);
 }
 
-#endif
\ No newline at end of file
+// endregion modifiers implementation
+
+// region statistics implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename BS_tree<tkey, tvalue, compare, t>::fill_statistics BS_tree<tkey, tvalue, compare, t>::fill() const
+{
+    fill_statistics statistics;
+
+    if (_root == nullptr)
+    {
+        return statistics;
+    }
+
+    // Nodes of a level, each with whether it is held to minimum_keys_in_node
+    std::vector<std::pair<const bstree_node*, bool>> level{{_root, false}};
+
+    while (!level.empty())
+    {
+        std::vector<std::pair<const bstree_node*, bool>> next;
+        ++statistics.height;
+
+        for (auto [node, held] : level)
+        {
+            ++statistics.nodes;
+            statistics.keys += node->_keys.size();
+
+            if (held)
+            {
+                statistics.minimum_fill = std::min(statistics.minimum_fill, static_cast<double>(node->_keys.size()) / maximum_keys_in_node);
+            }
+
+            for (const bstree_node* child : node->_pointers)
+            {
+                next.emplace_back(child, node->_keys.size() > 1);
+            }
+        }
+
+        level.swap(next);
+    }
+
+    statistics.node_bytes = statistics.nodes * sizeof(bstree_node);
+    statistics.average_fill = static_cast<double>(statistics.keys) / (statistics.nodes * maximum_keys_in_node);
+
+    return statistics;
+}
+
+// endregion statistics implementation
+
+// region helpers implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<bool upper>
+size_t BS_tree<tkey, tvalue, compare, t>::search(const bstree_node* node, const tkey& key) const
+{
+    auto position = upper
+            ? std::upper_bound(node->_keys.begin(), node->_keys.end(), key, [this](const tkey& lhs, const tree_data_type& rhs)
+            {
+                return compare_keys(lhs, rhs.first);
+            })
+            : std::lower_bound(node->_keys.begin(), node->_keys.end(), key, [this](const tree_data_type& lhs, const tkey& rhs)
+            {
+                return compare_keys(lhs.first, rhs);
+            });
+
+    return position - node->_keys.begin();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename BS_tree<tkey, tvalue, compare, t>::tree_data_type* BS_tree<tkey, tvalue, compare, t>::locate(const tkey& key) const
+{
+    for (bstree_node* node = _root; node != nullptr; )
+    {
+        size_t position = search<false>(node, key);
+
+        if (position < node->_keys.size() && !compare_keys(key, node->_keys[position].first))
+        {
+            return &node->_keys[position];
+        }
+
+        node = node->_pointers.empty() ? nullptr : node->_pointers[position];
+    }
+
+    return nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<bool upper, typename slot>
+std::stack<std::pair<slot, size_t>> BS_tree<tkey, tvalue, compare, t>::descend(slot root, const tkey& key) const
+{
+    std::stack<std::pair<slot, size_t>> path;
+
+    for (slot current = root; *current != nullptr; )
+    {
+        auto* node = *current;
+        size_t position = search<upper>(node, key);
+        path.push({current, position});
+
+        bool found = !upper && position < node->_keys.size() && !compare_keys(key, node->_keys[position].first);
+        if (found || node->_pointers.empty())
+        {
+            break;
+        }
+
+        current = &node->_pointers[position];
+    }
+
+    return path;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename slot>
+void BS_tree<tkey, tvalue, compare, t>::normalize(std::stack<std::pair<slot, size_t>>& path) noexcept
+{
+    while (!path.empty() && path.top().second == (*path.top().first)->_keys.size())
+    {
+        path.pop();
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename slot>
+std::stack<std::pair<slot, size_t>> BS_tree<tkey, tvalue, compare, t>::leftmost_path(slot root)
+{
+    std::stack<std::pair<slot, size_t>> path;
+
+    for (slot current = root; *current != nullptr; current = &(*current)->_pointers.front())
+    {
+        path.push({current, 0});
+        if ((*current)->_pointers.empty())
+        {
+            break;
+        }
+    }
+
+    return path;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename slot>
+std::stack<std::pair<slot, size_t>> BS_tree<tkey, tvalue, compare, t>::rightmost_path(slot root)
+{
+    std::stack<std::pair<slot, size_t>> path;
+
+    for (slot current = root; *current != nullptr; current = &(*current)->_pointers.back())
+    {
+        if ((*current)->_pointers.empty())
+        {
+            path.push({current, (*current)->_keys.size() - 1});
+            break;
+        }
+        path.push({current, (*current)->_pointers.size() - 1});
+    }
+
+    return path;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename slot>
+void BS_tree<tkey, tvalue, compare, t>::step_forward(std::stack<std::pair<slot, size_t>>& path, size_t& index) noexcept
+{
+    if (path.empty())
+    {
+        return;
+    }
+
+    auto* node = *path.top().first;
+
+    if (node->_pointers.empty())
+    {
+        ++path.top().second;
+        normalize(path);
+    }
+    else
+    {
+        // The next key is the leftmost one of the subtree right of the current key
+        slot current = &node->_pointers[++path.top().second];
+
+        while (true)
+        {
+            path.push({current, 0});
+            if ((*current)->_pointers.empty())
+            {
+                break;
+            }
+            current = &(*current)->_pointers.front();
+        }
+    }
+
+    index = path.empty() ? 0 : path.top().second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename slot>
+void BS_tree<tkey, tvalue, compare, t>::step_backward(std::stack<std::pair<slot, size_t>>& path, size_t& index) noexcept
+{
+    if (path.empty())
+    {
+        return;
+    }
+
+    auto* node = *path.top().first;
+
+    if (node->_pointers.empty())
+    {
+        // Goes up to the first ancestor entered through a child with a key to its left
+        while (!path.empty() && path.top().second == 0)
+        {
+            path.pop();
+        }
+
+        if (!path.empty())
+        {
+            --path.top().second;
+        }
+    }
+    else
+    {
+        // The previous key is the rightmost one of the subtree left of the current key
+        slot current = &node->_pointers[path.top().second];
+
+        while (!(*current)->_pointers.empty())
+        {
+            path.push({current, (*current)->_pointers.size() - 1});
+            current = &(*current)->_pointers.back();
+        }
+        path.push({current, (*current)->_keys.size() - 1});
+    }
+
+    index = path.empty() ? 0 : path.top().second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename to, typename from>
+std::stack<std::pair<to, size_t>> BS_tree<tkey, tvalue, compare, t>::convert_path(std::stack<std::pair<from, size_t>> path)
+{
+    std::vector<std::pair<from, size_t>> reversed;
+    reversed.reserve(path.size());
+
+    for (; !path.empty(); path.pop())
+    {
+        reversed.push_back(path.top());
+    }
+
+    std::stack<std::pair<to, size_t>> converted;
+
+    for (auto it = reversed.rbegin(); it != reversed.rend(); ++it)
+    {
+        converted.push({it->first, it->second});
+    }
+
+    return converted;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+std::pair<typename BS_tree<tkey, tvalue, compare, t>::bstree_iterator, bool> BS_tree<tkey, tvalue, compare, t>::insert_data(tree_data_type&& data, bool assign)
+{
+    if (_root == nullptr)
+    {
+        _root = new bstree_node();
+        _root->_keys.push_back(std::move(data));
+        _size = 1;
+        return {begin(), true};
+    }
+
+    auto path = descend<false>(&_root, data.first);
+    bstree_node* node = *path.top().first;
+    size_t position = path.top().second;
+
+    if (position < node->_keys.size() && !compare_keys(data.first, node->_keys[position].first))
+    {
+        if (assign)
+        {
+            node->_keys[position].second = std::move(data.second);
+        }
+
+        return {bstree_iterator(path, position), false};
+    }
+
+    if (node->_keys.size() < maximum_keys_in_node)
+    {
+        node->_keys.insert(node->_keys.begin() + position, std::move(data));
+        ++_size;
+        return {bstree_iterator(path, position), true};
+    }
+
+    // The new key moves along with the spill or split, so it is looked up again
+    tkey key = data.first;
+    node->_keys.insert(node->_keys.begin() + position, std::move(data));
+    ++_size;
+    fix_overflow(path);
+
+    return {find(key), true};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BS_tree<tkey, tvalue, compare, t>::redistribute(bstree_node* parent, size_t first, size_t from, size_t to)
+{
+    std::vector<bstree_node*> nodes(parent->_pointers.begin() + first, parent->_pointers.begin() + first + from);
+    std::vector<tree_data_type> keys;
+    std::vector<bstree_node*> pointers;
+
+    // Everything that can throw is done before the first key moves
+    try
+    {
+        keys.reserve(from * (maximum_keys_in_node + 2));
+        pointers.reserve(from * (maximum_keys_in_node + 2));
+
+        while (nodes.size() < to)
+        {
+            nodes.push_back(new bstree_node());
+        }
+    }
+    catch (...)
+    {
+        for (size_t i = from; i < nodes.size(); ++i)
+        {
+            delete nodes[i];
+        }
+        throw;
+    }
+
+    for (size_t i = 0; i < from; ++i)
+    {
+        std::move(nodes[i]->_keys.begin(), nodes[i]->_keys.end(), std::back_inserter(keys));
+        pointers.insert(pointers.end(), nodes[i]->_pointers.begin(), nodes[i]->_pointers.end());
+        nodes[i]->_keys.clear();
+        nodes[i]->_pointers.clear();
+
+        if (i + 1 < from)
+        {
+            keys.push_back(std::move(parent->_keys[first + i]));
+        }
+    }
+
+    parent->_keys.erase(parent->_keys.begin() + first, parent->_keys.begin() + first + from - 1);
+    parent->_pointers.erase(parent->_pointers.begin() + first + 1, parent->_pointers.begin() + first + from);
+
+    // The first nodes take one key more when the keys do not divide evenly
+    size_t in_nodes = keys.size() - (to - 1);
+    size_t key = 0;
+    size_t pointer = 0;
+
+    for (size_t i = 0; i < to; ++i)
+    {
+        size_t count = in_nodes / to + (i < in_nodes % to ? 1 : 0);
+
+        std::move(keys.begin() + key, keys.begin() + key + count, std::back_inserter(nodes[i]->_keys));
+        key += count;
+
+        if (!pointers.empty())
+        {
+            nodes[i]->_pointers.insert(nodes[i]->_pointers.end(), pointers.begin() + pointer, pointers.begin() + pointer + count + 1);
+            pointer += count + 1;
+        }
+
+        if (i + 1 < to)
+        {
+            parent->_keys.insert(parent->_keys.begin() + first + i, std::move(keys[key++]));
+            parent->_pointers.insert(parent->_pointers.begin() + first + i + 1, nodes[i + 1]);
+        }
+    }
+
+    for (size_t i = to; i < from; ++i)
+    {
+        delete nodes[i];
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BS_tree<tkey, tvalue, compare, t>::fix_overflow(node_path& path)
+{
+    while (true)
+    {
+        bstree_node* node = *path.top().first;
+        path.pop();
+
+        if (node->_keys.size() <= maximum_keys_in_node)
+        {
+            return;
+        }
+
+        if (path.empty())
+        {
+            auto* root = new bstree_node();
+            root->_pointers.push_back(node);
+            _root = root;
+            redistribute(root, 0, 1, 2);
+            return;
+        }
+
+        bstree_node* parent = *path.top().first;
+        size_t index = path.top().second;
+        bool has_right = index + 1 < parent->_pointers.size();
+
+        // A spill to a sibling with room costs no new node
+        if (has_right && parent->_pointers[index + 1]->_keys.size() < maximum_keys_in_node)
+        {
+            redistribute(parent, index, 2, 2);
+            return;
+        }
+
+        if (index > 0 && parent->_pointers[index - 1]->_keys.size() < maximum_keys_in_node)
+        {
+            redistribute(parent, index - 1, 2, 2);
+            return;
+        }
+
+        redistribute(parent, has_right ? index : index - 1, 2, 3);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BS_tree<tkey, tvalue, compare, t>::fix_underflow(node_path& path)
+{
+    while (true)
+    {
+        bstree_node* node = *path.top().first;
+        path.pop();
+
+        if (path.empty())
+        {
+            if (node->_keys.empty())
+            {
+                _root = node->_pointers.empty() ? nullptr : node->_pointers.front();
+                delete node;
+            }
+
+            return;
+        }
+
+        bstree_node* parent = *path.top().first;
+        size_t index = path.top().second;
+
+        // The children of a node with a single key follow the B tree rules: borrow, or merge the two into one
+        if (parent->_keys.size() == 1)
+        {
+            if (node->_keys.size() >= minimum_keys_in_root_child)
+            {
+                return;
+            }
+
+            bool sibling_can_give = parent->_pointers[1 - index]->_keys.size() > minimum_keys_in_root_child;
+            redistribute(parent, 0, 2, sibling_can_give ? 2 : 1);
+
+            if (sibling_can_give)
+            {
+                return;
+            }
+
+            continue;
+        }
+
+        if (node->_keys.size() >= minimum_keys_in_node)
+        {
+            return;
+        }
+
+        if (index + 1 < parent->_pointers.size() && parent->_pointers[index + 1]->_keys.size() > minimum_keys_in_node)
+        {
+            redistribute(parent, index, 2, 2);
+            return;
+        }
+
+        if (index > 0 && parent->_pointers[index - 1]->_keys.size() > minimum_keys_in_node)
+        {
+            redistribute(parent, index - 1, 2, 2);
+            return;
+        }
+
+        // Both neighbours are at the minimum, so three nodes are spread evenly or merged into two
+        size_t first = index == 0 ? 0 : index + 1 == parent->_pointers.size() ? index - 2 : index - 1;
+        size_t keys = 0;
+
+        for (size_t i = first; i < first + 3; ++i)
+        {
+            keys += parent->_pointers[i]->_keys.size();
+        }
+
+        if (keys >= 3 * minimum_keys_in_node)
+        {
+            redistribute(parent, first, 3, 3);
+            return;
+        }
+
+        redistribute(parent, first, 3, 2);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename BS_tree<tkey, tvalue, compare, t>::bstree_node* BS_tree<tkey, tvalue, compare, t>::clone_subtree(const bstree_node* node)
+{
+    auto* copy = new bstree_node();
+
+    try
+    {
+        copy->_keys = node->_keys;
+
+        for (const bstree_node* child : node->_pointers)
+        {
+            copy->_pointers.push_back(clone_subtree(child));
+        }
+    }
+    catch (...)
+    {
+        destroy_subtree(copy);
+        throw;
+    }
+
+    return copy;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void BS_tree<tkey, tvalue, compare, t>::destroy_subtree(bstree_node* node) noexcept
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+
+    for (bstree_node* child : node->_pointers)
+    {
+        destroy_subtree(child);
+    }
+
+    delete node;
+}
+
+// endregion helpers implementation
+
+#endif
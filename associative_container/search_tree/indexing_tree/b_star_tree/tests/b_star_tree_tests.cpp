@@ -1,9 +1,11 @@
 #include "gtest/gtest.h"
 
 #include <list>
+#include <map>
 #include <random>
 #include <vector>
 #include <b_star_tree.h>
+#include <random_operations_test.h>
 #include <client_logger_builder.h>
 
 
@@ -267,15 +269,15 @@ TEST(bTreePositiveTests, test4)
                     test_data<int, std::string>(1, 0, 1, "a"),
                     test_data<int, std::string>(1, 1, 2, "b"),
                     test_data<int, std::string>(1, 2, 3, "d"),
-                    test_data<int, std::string>(0, 0, 4, "e"),
-                    test_data<int, std::string>(1, 0, 15, "c"),
-                    test_data<int, std::string>(1, 1, 24, "g"),
-                    test_data<int, std::string>(1, 2, 45, "k"),
-                    test_data<int, std::string>(0, 1, 100, "f"),
-                    test_data<int, std::string>(1, 0, 101, "j"),
-                    test_data<int, std::string>(1, 1, 193, "l"),
-                    test_data<int, std::string>(1, 2, 456, "h"),
-                    test_data<int, std::string>(1, 3, 534, "m")
+                    test_data<int, std::string>(1, 3, 4, "e"),
+                    test_data<int, std::string>(0, 0, 15, "c"),
+                    test_data<int, std::string>(1, 0, 24, "g"),
+                    test_data<int, std::string>(1, 1, 45, "k"),
+                    test_data<int, std::string>(1, 2, 100, "f"),
+                    test_data<int, std::string>(0, 1, 101, "j"),
+                    test_data<int, std::string>(1, 0, 193, "l"),
+                    test_data<int, std::string>(1, 1, 456, "h"),
+                    test_data<int, std::string>(1, 2, 534, "m")
             };
 
     BS_tree<int, std::string, std::less<int>, 3> tree(std::less<int>(), nullptr, logger.get());
@@ -529,8 +531,8 @@ TEST(bTreePositiveTests, test9)
     tree.emplace(193, std::string("l"));
     tree.emplace(534, std::string("m"));
 
-    auto b = tree.begin();
-    auto e = tree.end();
+    auto b = tree.lower_bound(4);
+    auto e = tree.upper_bound(101);
     std::vector<decltype(tree)::value_type> actual_result(b, e);
 
     EXPECT_TRUE(compare_obtain_results(expected_result, actual_result));
@@ -538,6 +540,52 @@ TEST(bTreePositiveTests, test9)
     logger->trace("bTreePositiveTests.test9 finished");
 }
 
+template<size_t t>
+void fill_test(std::mt19937 &engine)
+{
+    // Spills and three way splits keep every node but the root and its halves two thirds full, nodes of t = 2 at a single key
+    constexpr size_t maximum_keys = 2 * t - 1;
+    constexpr double minimum_fill = static_cast<double>(t > 2 ? 2 * maximum_keys / 3 : 1) / maximum_keys - 1e-9;
+
+    random_operations_test<BS_tree<int, int, std::less<int>, t>>(engine, [minimum_fill](auto const &tree, std::map<int, int> const &expected)
+    {
+        auto fill = tree.fill();
+        ASSERT_EQ(fill.keys, expected.size());
+        ASSERT_GE(fill.minimum_fill, minimum_fill);
+    });
+}
+
+TEST(bTreePositiveTests, test10)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test10 started");
+
+    // Insertions and removals with spills, three way splits, borrows and three to two merges
+    std::mt19937 engine(10);
+    fill_test<2>(engine);
+    fill_test<3>(engine);
+    fill_test<5>(engine);
+    fill_test<16>(engine);
+
+    BS_tree<int, std::string, std::less<int>, 5> tree(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.emplace(i, std::to_string(i));
+    }
+
+    // Ascending insertions spill into the left sibling before splitting, so the nodes stay two thirds full
+    auto fill = tree.fill();
+    EXPECT_EQ(fill.keys, 1000);
+    EXPECT_GE(fill.average_fill, 0.6);
+
+    logger->trace("bTreePositiveTests.test10 finished");
+}
+
 TEST(bTreeNegativeTests, test1)
 {
     std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
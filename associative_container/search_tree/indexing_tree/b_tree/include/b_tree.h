@@ -6,10 +6,15 @@
 #include <search_tree.h>
 
 #include <boost/container/static_vector.hpp>
+#include <algorithm>
 #include <initializer_list>
 #include <iterator>
 #include <stack>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <functional>
 
 template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, std::size_t t = 5>
@@ -26,14 +31,23 @@ private:
 	// region comparators declaration
 
 	inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+	// Mixed comparisons for the lookups by key_like, see transparent_compator
+	template<typename lhs_key, typename rhs_key>
+	inline bool compare_keys(const lhs_key& lhs, const rhs_key& rhs) const;
 	inline bool compare_pairs(const tree_data_type& lhs, const tree_data_type& rhs) const;
 
 	// endregion comparators declaration
 
 
+	/** Keys of a node are stored contiguously, apart from the values, so a search
+	 *  inside a node touches as few cache lines as possible
+	 */
 	struct btree_node {
-		boost::container::static_vector<tree_data_type, maximum_keys_in_node + 1> _keys;
+		boost::container::static_vector<tkey, maximum_keys_in_node + 1> _keys;
+		boost::container::static_vector<tvalue, maximum_keys_in_node + 1> _values;
 		boost::container::static_vector<btree_node*, maximum_keys_in_node + 2> _pointers;
+		btree_node* _parent;
 		btree_node() noexcept;
 		//        std::vector<tree_data_type, pp_allocator<tree_data_type>> _keys;
 		//        std::vector<btree_node*, pp_allocator<btree_node*>> _pointers;
@@ -41,6 +55,23 @@ private:
 		//        btree_node(pp_allocator<value_type> al);
 	};
 
+	/** Search strategy inside a node, chosen from t and tkey. Arithmetic keys in nodes of up to
+	 *  linear_search_max_keys keys are scanned linearly without branches (the compiler turns the scan
+	 *  into SIMD comparisons), arithmetic keys in larger nodes use a branchless binary search.
+	 *  Other keys keep the branching binary search: their comparisons are expensive and
+	 *  speculation past a branch overlaps the loads of the next keys
+	 */
+	static constexpr const size_t linear_search_max_keys = 32;
+	static constexpr const bool linear_node_search = std::is_arithmetic_v<tkey> && maximum_keys_in_node <= linear_search_max_keys;
+	static constexpr const bool branchless_node_search = std::is_arithmetic_v<tkey> && !linear_node_search;
+
+	// Element of the iterators' pointer type, keeps the pair of references alive for operator->
+	template<typename reference>
+	struct arrow_proxy {
+		reference _ref;
+		const reference* operator->() const noexcept { return &_ref; }
+	};
+
 	pp_allocator<value_type> _allocator;
 	logger* _logger;
 	btree_node* _root;
@@ -84,14 +115,17 @@ public:
 	class btree_const_iterator;
 	class btree_const_reverse_iterator;
 
+	/** Iterators are a node and a position in it, they climb through the parent pointers of the nodes,
+	 *  so they are trivially copyable and never allocate
+	 */
 	class btree_iterator final {
-		std::stack<std::pair<btree_node**, size_t>> _path;
+		btree_node* _node;
 		size_t _index;
 
 	public:
 		using value_type = tree_data_type_const;
-		using reference = value_type&;
-		using pointer = value_type*;
+		using reference = std::pair<const tkey&, tvalue&>;
+		using pointer = arrow_proxy<reference>;
 		using iterator_category = std::bidirectional_iterator_tag;
 		using difference_type = ptrdiff_t;
 		using self = btree_iterator;
@@ -118,17 +152,17 @@ public:
 		bool is_terminate_node() const noexcept;
 		size_t index() const noexcept;
 
-		explicit btree_iterator(const std::stack<std::pair<btree_node**, size_t>>& path = std::stack<std::pair<btree_node**, size_t>>(), size_t index = 0);
+		explicit btree_iterator(btree_node* node = nullptr, size_t index = 0) noexcept;
 	};
 
 	class btree_const_iterator final {
-		std::stack<std::pair<btree_node* const*, size_t>> _path;
+		const btree_node* _node;
 		size_t _index;
 
 	public:
 		using value_type = tree_data_type_const;
-		using reference = const value_type&;
-		using pointer = const value_type*;
+		using reference = std::pair<const tkey&, const tvalue&>;
+		using pointer = arrow_proxy<reference>;
 		using iterator_category = std::bidirectional_iterator_tag;
 		using difference_type = ptrdiff_t;
 		using self = btree_const_iterator;
@@ -157,17 +191,17 @@ public:
 		bool is_terminate_node() const noexcept;
 		size_t index() const noexcept;
 
-		explicit btree_const_iterator(const std::stack<std::pair<btree_node* const*, size_t>>& path = std::stack<std::pair<btree_node* const*, size_t>>(), size_t index = 0);
+		explicit btree_const_iterator(const btree_node* node = nullptr, size_t index = 0) noexcept;
 	};
 
 	class btree_reverse_iterator final {
-		std::stack<std::pair<btree_node**, size_t>> _path;
+		btree_node* _node;
 		size_t _index;
 
 	public:
 		using value_type = tree_data_type_const;
-		using reference = value_type&;
-		using pointer = value_type*;
+		using reference = std::pair<const tkey&, tvalue&>;
+		using pointer = arrow_proxy<reference>;
 		using iterator_category = std::bidirectional_iterator_tag;
 		using difference_type = ptrdiff_t;
 		using self = btree_reverse_iterator;
@@ -197,17 +231,17 @@ public:
 		bool is_terminate_node() const noexcept;
 		size_t index() const noexcept;
 
-		explicit btree_reverse_iterator(const std::stack<std::pair<btree_node**, size_t>>& path = std::stack<std::pair<btree_node**, size_t>>(), size_t index = 0);
+		explicit btree_reverse_iterator(btree_node* node = nullptr, size_t index = 0) noexcept;
 	};
 
 	class btree_const_reverse_iterator final {
-		std::stack<std::pair<btree_node* const*, size_t>> _path;
+		const btree_node* _node;
 		size_t _index;
 
 	public:
 		using value_type = tree_data_type_const;
-		using reference = const value_type&;
-		using pointer = const value_type*;
+		using reference = std::pair<const tkey&, const tvalue&>;
+		using pointer = arrow_proxy<reference>;
 		using iterator_category = std::bidirectional_iterator_tag;
 		using difference_type = ptrdiff_t;
 		using self = btree_const_reverse_iterator;
@@ -237,7 +271,7 @@ public:
 		bool is_terminate_node() const noexcept;
 		size_t index() const noexcept;
 
-		explicit btree_const_reverse_iterator(const std::stack<std::pair<btree_node* const*, size_t>>& path = std::stack<std::pair<btree_node* const*, size_t>>(), size_t index = 0);
+		explicit btree_const_reverse_iterator(const btree_node* node = nullptr, size_t index = 0) noexcept;
 	};
 
 	friend class btree_iterator;
@@ -304,6 +338,27 @@ public:
 
 	bool contains(const tkey& key) const;
 
+	/** Lookups by a key of another type that compare orders against tkey (compare::is_transparent),
+	 *  no temporary tkey is built
+	 */
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	btree_iterator find(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	btree_const_iterator find(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	btree_iterator lower_bound(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	btree_const_iterator lower_bound(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	btree_iterator upper_bound(const key_like& key);
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	btree_const_iterator upper_bound(const key_like& key) const;
+
+	template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+	bool contains(const key_like& key) const;
+
 	// endregion lookup declaration
 
 	// region modifiers declaration
@@ -341,8 +396,91 @@ public:
 
 	btree_iterator erase(const tkey& key);
 
+	/** Erases keys in [lo, hi] in O(log n + k) by splitting off and dropping whole subtrees,
+	 *  returns how many were erased
+	 */
+	size_t erase_range(const tkey& lo, const tkey& hi);
+
+	/** Replaces the contents by the elements of [begin, end), built bottom-up in one pass: leaves are filled
+	 *  to fill_factor of their capacity (never below the minimum), inner levels are packed full.
+	 *  Input sorted by key is taken as is, other input is sorted first; of equal keys the first one is kept
+	 */
+	template<input_iterator_for_pair<tkey, tvalue> iterator>
+	void bulk_load(iterator begin, iterator end, double fill_factor = 1.0);
 
 	// endregion modifiers declaration
+
+private:
+	// Searches shared by the lookups by tkey and by key_like
+	template<typename key_like>
+	btree_iterator find_key(const key_like& key);
+	template<typename key_like>
+	btree_const_iterator find_key(const key_like& key) const;
+
+	template<typename key_like>
+	btree_iterator lower_bound_key(const key_like& key);
+	template<typename key_like>
+	btree_const_iterator lower_bound_key(const key_like& key) const;
+
+	template<typename key_like>
+	btree_iterator upper_bound_key(const key_like& key);
+	template<typename key_like>
+	btree_const_iterator upper_bound_key(const key_like& key) const;
+
+	/** Position of the first key of the node that does not precede key:
+	 *  with upper false a key precedes when it is less than key, with upper true when it is not greater
+	 */
+	template<bool upper, typename key_like>
+	size_t search_in_node(const btree_node* node, const key_like& key) const;
+
+	// Position of child among the pointers of parent
+	static size_t child_position(const btree_node* parent, const btree_node* child) noexcept;
+
+	// In-order neighbours of the element at position index of node, {nullptr, 0} past the ends
+	template<typename node_pointer>
+	static std::pair<node_pointer, size_t> next_element(node_pointer node, size_t index) noexcept;
+	template<typename node_pointer>
+	static std::pair<node_pointer, size_t> previous_element(node_pointer node, size_t index) noexcept;
+
+	// Moves the key and the value at position index of from to position to_index of to
+	static void move_element(btree_node* from, size_t index, btree_node* to, size_t to_index);
+
+	// Restores the minimum fill of node, whose parent reaches it by child_index, by borrowing from or merging with a sibling;
+	// true when it was merged
+	bool rebalance(btree_node* parent, size_t child_index);
+
+	// Borrows for the child at child_index of parent until it has the minimum fill or gets merged
+	void fill_child(btree_node* parent, size_t child_index);
+
+	// Splits an overflowing node around its middle key, which goes to the parent (a new root when there is none);
+	// returns the parent
+	btree_node* split_node(btree_node* node);
+
+	// Rebalances from node up to root after a removal from node; returns the root, collapsed when left without keys
+	btree_node* restore_after_removal(btree_node* node, btree_node* root);
+
+	// Builds the tree over elements sorted by key without equal keys, level by level from the leaves
+	void build_from_sorted(std::vector<tree_data_type>&& data, size_t leaf_keys);
+
+	/** Split and join of detached subtrees (roots without parent, nullptr when empty) for erase_range.
+	 *  Splitting gives the elements less than key (not greater when upper) and the rest; joining requires the keys of left
+	 *  to be less than the separator and the keys of right to be greater
+	 */
+	template<bool upper, typename key_like>
+	std::pair<btree_node*, btree_node*> split_subtree(btree_node* node, const key_like& key);
+	btree_node* join_subtrees(btree_node* left, tkey&& key, tvalue&& value, btree_node* right);
+	btree_node* join_subtrees(btree_node* left, btree_node* right);
+
+	// Root of a subtree cut out of a node: the node detached, its only child when it has no keys, or nullptr
+	static btree_node* detach(btree_node* node) noexcept;
+	static size_t height(const btree_node* node) noexcept;
+
+	// Deletes the nodes of a subtree, returns the number of elements it held
+	static size_t destroy_subtree(btree_node* node) noexcept;
+
+	// Erases the keys from lo up to *hi, included when hi_included, or up to the end when hi is nullptr;
+	// returns how many were erased
+	size_t erase_span(const tkey& lo, const tkey* hi, bool hi_included);
 };
 
 template<std::input_iterator iterator, compator<typename std::iterator_traits<iterator>::value_type::first_type> compare = std::less<typename std::iterator_traits<iterator>::value_type::first_type>,
@@ -365,9 +503,15 @@ bool B_tree<tkey, tvalue, compare, t>::compare_keys(const tkey& lhs, const tkey&
 	return compare::operator()(lhs, rhs);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename lhs_key, typename rhs_key>
+bool B_tree<tkey, tvalue, compare, t>::compare_keys(const lhs_key& lhs, const rhs_key& rhs) const {
+	return compare::operator()(lhs, rhs);
+}
+
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_node::btree_node() noexcept {
+B_tree<tkey, tvalue, compare, t>::btree_node::btree_node() noexcept : _parent(nullptr) {
 	_keys.reserve(maximum_keys_in_node + 1);
 	_pointers.reserve(maximum_keys_in_node + 2);
 }
@@ -403,18 +547,14 @@ B_tree<tkey, tvalue, compare, t>::B_tree(iterator begin, iterator end,
 										 pp_allocator<value_type> alloc,
 										 logger* logger) : _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {
 	compare::operator=(cmp);
-	for (auto it = begin; it != end; ++it) {
-		insert(*it);
-	}
+	bulk_load(begin, end);
 }
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 B_tree<tkey, tvalue, compare, t>::B_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp,
 										 pp_allocator<value_type> alloc,
 										 logger* logger) : _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {
 	compare::operator=(cmp);
-	for (const auto& pair: data) {
-		insert(pair);
-	}
+	bulk_load(data.begin(), data.end());
 }
 
 // endregion constructors implementation
@@ -483,67 +623,85 @@ B_tree<tkey, tvalue, compare, t>& B_tree<tkey, tvalue, compare, t>::operator=(B_
 // region iterators implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_iterator::btree_iterator(
-		const std::stack<std::pair<btree_node**, size_t>>& path, size_t index) : _path(path), _index(index) {}
+size_t B_tree<tkey, tvalue, compare, t>::child_position(const btree_node* parent, const btree_node* child) noexcept {
+	size_t position = 0;
+	while (parent->_pointers[position] != child)
+		++position;
+	return position;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename node_pointer>
+std::pair<node_pointer, size_t> B_tree<tkey, tvalue, compare, t>::next_element(node_pointer node, size_t index) noexcept {
+	if (!node->_pointers.empty()) {
+		node = node->_pointers[index + 1];
+		while (!node->_pointers.empty())
+			node = node->_pointers[0];
+		return {node, 0};
+	}
+
+	if (index + 1 < node->_keys.size())
+		return {node, index + 1};
+
+	// The last element of a leaf is followed by the separator of the first ancestor entered from the left
+	while (node->_parent) {
+		size_t position = child_position(node->_parent, node);
+		node = node->_parent;
+		if (position < node->_keys.size())
+			return {node, position};
+	}
+	return {nullptr, 0};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename node_pointer>
+std::pair<node_pointer, size_t> B_tree<tkey, tvalue, compare, t>::previous_element(node_pointer node, size_t index) noexcept {
+	if (!node->_pointers.empty()) {
+		node = node->_pointers[index];
+		while (!node->_pointers.empty())
+			node = node->_pointers.back();
+		return {node, node->_keys.size() - 1};
+	}
+
+	if (index > 0)
+		return {node, index - 1};
+
+	while (node->_parent) {
+		size_t position = child_position(node->_parent, node);
+		node = node->_parent;
+		if (position > 0)
+			return {node, position - 1};
+	}
+	return {nullptr, 0};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+B_tree<tkey, tvalue, compare, t>::btree_iterator::btree_iterator(btree_node* node, size_t index) noexcept : _node(node), _index(index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator::reference
 B_tree<tkey, tvalue, compare, t>::btree_iterator::operator*() const noexcept {
-	return (*(_path.top().first))->_keys[_path.top().second];
+	return reference(_node->_keys[_index], _node->_values[_index]);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator::pointer
 B_tree<tkey, tvalue, compare, t>::btree_iterator::operator->() const noexcept {
-	return &((*(_path.top().first))->_keys[_path.top().second]);
+	return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_iterator::operator++() {
-	if (_path.empty()) return *this;
-
-	auto& [node_ptr, pointer_idx] = _path.top();
-	btree_node* node = *node_ptr;
-
-	if (!node->_pointers.empty()) {
-		_path.top().second = _path.top().second + 1;
-		_path.push({ &node->_pointers[_index + 1], 0 });
-		node = *(_path.top().first);
-		while (!node->_pointers.empty()) {
-			_path.push({ &node->_pointers[0], 0 });
-			node = *(_path.top().first);
-		}
-		_index = 0;
-		return *this;
-	}
-
-	if (_index + 1 < node->_keys.size()) {
-		++_index;
-		_path.top().second = _index;
-		return *this;
-	}
-
-	_path.pop();
-	while (!_path.empty()) {
-		auto& [parent_ptr, child_idx] = _path.top();
-		btree_node* parent = *parent_ptr;
-		if (child_idx < parent->_keys.size()) {
-			_index = child_idx;
-
-			return *this;
-		}
-		_path.pop();
-	}
-
-	_index = 0;
+	if (_node)
+		std::tie(_node, _index) = next_element(_node, _index);
 	return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator
 B_tree<tkey, tvalue, compare, t>::btree_iterator::operator++(int) {
-	btree_iterator temp = *this;
+	self temp = *this;
 	++(*this);
 	return temp;
 }
@@ -551,64 +709,22 @@ B_tree<tkey, tvalue, compare, t>::btree_iterator::operator++(int) {
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_iterator::operator--() {
-	if (_path.empty()) {
-		return *this;
-	}
-
-	auto* node = *_path.top().first;
-	if (_index > 0) {
-		--_index;
-		_path.top().second = _index;
-		return *this;
-	}
-
-	if (node->_pointers.empty()) {
-		while (!_path.empty()) {
-			auto [ptr, idx_in_parent] = _path.top();
-			_path.pop();
-			if (_path.empty()) {
-				_path = {};
-				_index = 0;
-				return *this;
-			}
-			auto* parent = *_path.top().first;
-			size_t pos = ptr - parent->_pointers.data();
-			if (pos > 0) {
-				_index = pos - 1;
-				_path.top().second = _index;
-				return *this;
-			}
-		}
-	} else {
-		_path.push({&node->_pointers[_index], 0});
-		node = *_path.top().first;
-		while (!node->_pointers.empty()) {
-			_path.push({&node->_pointers[node->_pointers.size() - 1], 0});
-			node = *_path.top().first;
-		}
-		_index = node->_keys.size() - 1;
-		_path.top().second = _index;
-	}
+	if (_node)
+		std::tie(_node, _index) = previous_element(_node, _index);
 	return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator
 B_tree<tkey, tvalue, compare, t>::btree_iterator::operator--(int) {
-	btree_iterator temp = *this;
+	self temp = *this;
 	--(*this);
 	return temp;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool B_tree<tkey, tvalue, compare, t>::btree_iterator::operator==(const self& other) const noexcept {
-	if (_path.empty() && other._path.empty()) {
-		return true;
-	}
-	if (_path.empty() || other._path.empty()) {
-		return false;
-	}
-	return _path.top().first == other._path.top().first && _index == other._index;
+	return _node == other._node && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -618,23 +734,20 @@ bool B_tree<tkey, tvalue, compare, t>::btree_iterator::operator!=(const self& ot
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_iterator::depth() const noexcept {
-	return _path.size() - 1;
+	size_t depth = 0;
+	for (auto* node = _node; node && node->_parent; node = node->_parent)
+		++depth;
+	return depth;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_iterator::current_node_keys_count() const noexcept {
-	if (_path.empty()) {
-		return 0;
-	}
-	return (*_path.top().first)->_keys.size();
+	return _node ? _node->_keys.size() : 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool B_tree<tkey, tvalue, compare, t>::btree_iterator::is_terminate_node() const noexcept {
-	if (_path.empty()) {
-		return true;
-	}
-	return (*_path.top().first)->_pointers.empty();
+	return !_node || _node->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -643,117 +756,58 @@ size_t B_tree<tkey, tvalue, compare, t>::btree_iterator::index() const noexcept
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::btree_const_iterator(
-		const std::stack<std::pair<btree_node* const*, size_t>>& path, size_t index) : _path(path), _index(index) {}
+B_tree<tkey, tvalue, compare, t>::btree_const_iterator::btree_const_iterator(const btree_node* node, size_t index) noexcept : _node(node), _index(index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::btree_const_iterator(
-		const btree_iterator& it) noexcept : _path(it._path), _index(it._index) {}
+B_tree<tkey, tvalue, compare, t>::btree_const_iterator::btree_const_iterator(const btree_iterator& it) noexcept : _node(it._node), _index(it._index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator::reference
 B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator*() const noexcept {
-	return (*(_path.top().first))->_keys[_path.top().second];
+	return reference(_node->_keys[_index], _node->_values[_index]);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator::pointer
 B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator->() const noexcept {
-	return &((*(_path.top().first))->_keys[_path.top().second]);
+	return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator++() {
-	if (_path.empty()) return *this;
-
-	auto& [node_ptr, pointer_idx] = _path.top();
-	btree_node* node = *node_ptr;
-
-	if (!node->_pointers.empty()) {
-		_path.top().second = _path.top().second + 1;
-		_path.push({ &node->_pointers[_index + 1], 0 });
-		node = *(_path.top().first);
-		while (!node->_pointers.empty()) {
-			_path.push({ &node->_pointers[0], 0 });
-			node = *(_path.top().first);
-		}
-		_index = 0;
-		return *this;
-	}
-
-	if (_index + 1 < node->_keys.size()) {
-		++_index;
-		_path.top().second = _index;
-		return *this;
-	}
-
-	_path.pop();
-	while (!_path.empty()) {
-		auto& [parent_ptr, child_idx] = _path.top();
-		btree_node* parent = *parent_ptr;
-		if (child_idx < parent->_keys.size()) {
-			_index = child_idx;
-
-			return *this;
-		}
-		_path.pop();
-	}
-
-	_index = 0;
+	if (_node)
+		std::tie(_node, _index) = next_element(_node, _index);
 	return *this;
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator
+B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator++(int) {
+	self temp = *this;
+	++(*this);
+	return temp;
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator--() {
-	if (_path.empty()) {
-		return *this;
-	}
-
-	auto* node = *_path.top().first;
-	if (_index > 0) {
-		--_index;
-		_path.top().second = _index;
-		return *this;
-	}
-
-	if (node->_pointers.empty()) {
-		while (!_path.empty()) {
-			auto [ptr, idx_in_parent] = _path.top();
-			_path.pop();
-			if (_path.empty()) {
-				_path = {};
-				_index = 0;
-				return *this;
-			}
-			auto* parent = *_path.top().first;
-			size_t pos = ptr - parent->_pointers.data();
-			if (pos > 0) {
-				_index = pos - 1;
-				_path.top().second = _index;
-				return *this;
-			}
-		}
-	} else {
-		_path.push({&node->_pointers[_index], 0});
-		node = *_path.top().first;
-		while (!node->_pointers.empty()) {
-			_path.push({&node->_pointers[node->_pointers.size() - 1], 0});
-			node = *_path.top().first;
-		}
-		_index = node->_keys.size() - 1;
-		_path.top().second = _index;
-	}
+	if (_node)
+		std::tie(_node, _index) = previous_element(_node, _index);
 	return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator==(const self& other) const noexcept {
-	if (_path.empty() && other._path.empty()) return true;
-	if (_path.empty() || other._path.empty()) return false;
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator
+B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator--(int) {
+	self temp = *this;
+	--(*this);
+	return temp;
+}
 
-	return _path.top().first == other._path.top().first && _index == other._index;
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+bool B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator==(const self& other) const noexcept {
+	return _node == other._node && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -763,19 +817,20 @@ bool B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator!=(const se
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_const_iterator::depth() const noexcept {
-	return _path.size() - 1;
+	size_t depth = 0;
+	for (auto* node = _node; node && node->_parent; node = node->_parent)
+		++depth;
+	return depth;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_const_iterator::current_node_keys_count() const noexcept {
-	if (_path.empty()) return 0;
-	return (*_path.top().first)->_keys.size();
+	return _node ? _node->_keys.size() : 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool B_tree<tkey, tvalue, compare, t>::btree_const_iterator::is_terminate_node() const noexcept {
-	if (_path.empty()) return true;
-	return (*_path.top().first)->_pointers.empty();
+	return !_node || _node->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -784,70 +839,63 @@ size_t B_tree<tkey, tvalue, compare, t>::btree_const_iterator::index() const noe
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::btree_reverse_iterator(
-		const std::stack<std::pair<btree_node**, size_t>>& path, size_t index) : _path(path), _index(index) {}
+B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::btree_reverse_iterator(btree_node* node, size_t index) noexcept : _node(node), _index(index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::btree_reverse_iterator(
-		const btree_iterator& it) noexcept : _path(it._path), _index(it._index) {}
+B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::btree_reverse_iterator(const btree_iterator& it) noexcept : _node(it._node), _index(it._index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator B_tree<tkey, tvalue, compare, t>::btree_iterator() const noexcept {
-	return btree_iterator(_path, _index);
+	return btree_iterator(_node, _index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::reference
 B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator*() const noexcept {
-	return (*_path.top().first)->_keys[_index];
+	return reference(_node->_keys[_index], _node->_values[_index]);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::pointer
 B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator->() const noexcept {
-	return &((*_path.top().first)->_keys[_index]);
+	return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator++() {
-	auto fwd = static_cast<btree_iterator>(*this);
-	--fwd;
-	*this = btree_reverse_iterator(fwd);
+	if (_node)
+		std::tie(_node, _index) = previous_element(_node, _index);
 	return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator
 B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator++(int) {
-	btree_const_iterator temp = *this;
-	--(*this);
+	self temp = *this;
+	++(*this);
 	return temp;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator--() {
-	auto fwd = static_cast<btree_iterator>(*this);
-	++fwd;
-	*this = btree_reverse_iterator(fwd);
+	if (_node)
+		std::tie(_node, _index) = next_element(_node, _index);
 	return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator
 B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator--(int) {
-	btree_const_iterator temp = *this;
-	++(*this);
+	self temp = *this;
+	--(*this);
 	return temp;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator==(const self& other) const noexcept {
-	if (_path.empty() && other._path.empty()) return true;
-	if (_path.empty() || other._path.empty()) return false;
-
-	return _path.top().first == other._path.top().first && _index == other._index;
+	return _node == other._node && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -857,19 +905,20 @@ bool B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator!=(const
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::depth() const noexcept {
-	return _path.size() - 1;
+	size_t depth = 0;
+	for (auto* node = _node; node && node->_parent; node = node->_parent)
+		++depth;
+	return depth;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::current_node_keys_count() const noexcept {
-	if (_path.empty()) return 0;
-	return (*_path.top().first)->_keys.size();
+	return _node ? _node->_keys.size() : 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::is_terminate_node() const noexcept {
-	if (_path.empty()) return true;
-	return (*_path.top().first)->_pointers.empty();
+	return !_node || _node->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -878,71 +927,63 @@ size_t B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::index() const n
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::btree_const_reverse_iterator(
-		const std::stack<std::pair<btree_node* const*, size_t>>& path, size_t index) : _path(path), _index(index) {}
-
+B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::btree_const_reverse_iterator(const btree_node* node, size_t index) noexcept : _node(node), _index(index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::btree_const_reverse_iterator(
-		const btree_reverse_iterator& it) noexcept : _path(it._path), _index(it._index) {}
+B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::btree_const_reverse_iterator(const btree_reverse_iterator& it) noexcept : _node(it._node), _index(it._index) {}
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator B_tree<tkey, tvalue, compare, t>::btree_const_iterator() const noexcept {
-	return btree_const_iterator(_path, _index);
+	return btree_const_iterator(_node, _index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::reference
 B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator*() const noexcept {
-	return (*_path.top().first)->_keys[_index];
+	return reference(_node->_keys[_index], _node->_values[_index]);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::pointer
 B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator->() const noexcept {
-	return &((*_path.top().first)->_keys[_index]);
+	return pointer{**this};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator++() {
-	auto fwd = static_cast<btree_iterator>(*this);
-	--fwd;
-	*this = btree_reverse_iterator(fwd);
+	if (_node)
+		std::tie(_node, _index) = previous_element(_node, _index);
 	return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator
 B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator++(int) {
-	btree_const_iterator temp = *this;
-	--(*this);
+	self temp = *this;
+	++(*this);
 	return temp;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator&
 B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator--() {
-	auto fwd = static_cast<btree_iterator>(*this);
-	++fwd;
-	*this = btree_reverse_iterator(fwd);
+	if (_node)
+		std::tie(_node, _index) = next_element(_node, _index);
 	return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator
 B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator--(int) {
-	btree_const_iterator temp = *this;
-	++(*this);
+	self temp = *this;
+	--(*this);
 	return temp;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator==(const self& other) const noexcept {
-	if (_path.empty() && other._path.empty()) return true;
-	if (_path.empty() || other._path.empty()) return false;
-
-	return _path.top().first == other._path.top().first && _index == other._index;
+	return _node == other._node && _index == other._index;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -952,19 +993,20 @@ bool B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator!=(
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::depth() const noexcept {
-	return _path.size() - 1;
+	size_t depth = 0;
+	for (auto* node = _node; node && node->_parent; node = node->_parent)
+		++depth;
+	return depth;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 size_t B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::current_node_keys_count() const noexcept {
-	if (_path.empty()) return 0;
-	return (*_path.top().first)->_keys.size();
+	return _node ? _node->_keys.size() : 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 bool B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::is_terminate_node() const noexcept {
-	if (_path.empty()) return true;
-	return (*_path.top().first)->_pointers.empty();
+	return !_node || _node->_pointers.empty();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -1022,40 +1064,30 @@ typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, c
 	if (!_root) {
 		return end();
 	}
-	std::stack<std::pair<btree_node**, size_t>> path;
-	btree_node* current = _root;
-	while (!current->_pointers.empty()) {
-		path.push(std::make_pair(&current, 0));
-		current = current->_pointers[0];
+	btree_node* node = _root;
+	while (!node->_pointers.empty()) {
+		node = node->_pointers[0];
 	}
-	path.push(std::make_pair(&current, 0));
-	return btree_iterator(path, 0);
+	return btree_iterator(node, 0);
 }
 
-
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::end() {
 	return btree_iterator();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator
-B_tree<tkey, tvalue, compare, t>::begin() const {
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::begin() const {
 	if (!_root) {
 		return end();
 	}
-	std::stack<std::pair<btree_node* const*, size_t>> path;
-	btree_node* const* node_ptr = &_root;
-	while (!(*node_ptr)->_pointers.empty()) {
-		path.push(std::make_pair(node_ptr, 0));
-		node_ptr = &((*node_ptr)->_pointers[0]);
+	const btree_node* node = _root;
+	while (!node->_pointers.empty()) {
+		node = node->_pointers[0];
 	}
-	path.push(std::make_pair(node_ptr, 0));
-	return btree_const_iterator(path, 0);
+	return btree_const_iterator(node, 0);
 }
 
-
-
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::end() const {
 	return btree_const_iterator();
@@ -1076,14 +1108,11 @@ typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator B_tree<tkey, t
 	if (!_root) {
 		return rend();
 	}
-	std::stack<std::pair<btree_node**, size_t>> path;
-	btree_node* current = _root;
-	while (!current->_pointers.empty()) {
-		path.push({&current, current->_keys.size()});
-		current = current->_pointers[current->_pointers.size() - 1];
+	btree_node* node = _root;
+	while (!node->_pointers.empty()) {
+		node = node->_pointers.back();
 	}
-	path.push({&current, current->_keys.size() - 1});
-	return btree_reverse_iterator(path, current->_keys.size() - 1);
+	return btree_reverse_iterator(node, node->_keys.size() - 1);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -1096,14 +1125,11 @@ typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator B_tree<t
 	if (!_root) {
 		return rend();
 	}
-	std::stack<std::pair<btree_node* const*, size_t>> path;
-	const btree_node* current = _root;
-	while (!current->_pointers.empty()) {
-		path.push({&current, current->_keys.size()});
-		current = current->_pointers[current->_pointers.size() - 1];
+	const btree_node* node = _root;
+	while (!node->_pointers.empty()) {
+		node = node->_pointers.back();
 	}
-	path.push({&current, current->_keys.size() - 1});
-	return btree_const_reverse_iterator(path, current->_keys.size() - 1);
+	return btree_const_reverse_iterator(node, node->_keys.size() - 1);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -1136,171 +1162,207 @@ bool B_tree<tkey, tvalue, compare, t>::empty() const noexcept {
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) {
-	if (!_root)
-		return end();
-
-	// будем хранить в path «настоящие» адреса указателей на узлы
-	std::stack<std::pair<btree_node**, size_t>> path;
-	btree_node** ptr = &_root;
-	btree_node* node = *ptr;
+template<bool upper, typename key_like>
+size_t B_tree<tkey, tvalue, compare, t>::search_in_node(const btree_node* node, const key_like& key) const {
+	auto precedes = [this, &key](const tkey& node_key) -> bool {
+		if constexpr (upper)
+			return !compare_keys(key, node_key);
+		else
+			return compare_keys(node_key, key);
+	};
 
-	while (true) {
-		size_t lo = 0, hi = node->_keys.size();
-		// стандартный двоичный поиск позиции
+	const tkey* keys = node->_keys.data();
+	size_t count = node->_keys.size();
+
+	if constexpr (linear_node_search) {
+		// Keys are sorted, so the number of preceding keys is the position. The scan has no early exit
+		// and goes by fixed-size blocks, which the compiler turns into SIMD comparisons
+		constexpr size_t block = 16 / sizeof(tkey) > 1 ? 16 / sizeof(tkey) : 1;
+		size_t position = 0;
+		size_t i = 0;
+		for (; i + block <= count; i += block) {
+			size_t block_position = 0;
+			for (size_t j = 0; j < block; ++j)
+				block_position += precedes(keys[i + j]);
+			position += block_position;
+		}
+		for (; i < count; ++i)
+			position += precedes(keys[i]);
+		return position;
+	} else if constexpr (branchless_node_search) {
+		if (count == 0)
+			return 0;
+		// The halving step is a conditional move, its length does not depend on the comparisons
+		const tkey* base = keys;
+		while (count > 1) {
+			size_t half = count / 2;
+			base = precedes(base[half]) ? base + half : base;
+			count -= half;
+		}
+		return (base - keys) + precedes(*base);
+	} else {
+		size_t lo = 0, hi = count;
 		while (lo < hi) {
 			size_t mid = (lo + hi) / 2;
-			if (compare_keys(node->_keys[mid].first, key))
+			if (precedes(keys[mid]))
 				lo = mid + 1;
 			else
 				hi = mid;
 		}
-		// если нашли точное совпадение
-		if (lo < node->_keys.size()
-			&& !compare_keys(key, node->_keys[lo].first)
-			&& !compare_keys(node->_keys[lo].first, key)) {
-			path.emplace(ptr, lo);
-			return btree_iterator(path, lo);
-		}
-		// если дальше спускаемcя в потомков
-		if (node->_pointers.empty())
-			break;
+		return lo;
+	}
+}
 
-		// запоминаем текущую позицию и «перенаправляем» ptr
-		path.emplace(ptr, lo);
-		ptr = &node->_pointers[lo];
-		node = *ptr;
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find_key(const key_like& key) {
+	btree_node* node = _root;
+	while (node) {
+		size_t index = search_in_node<false>(node, key);
+		if (index < node->_keys.size() && !compare_keys(key, node->_keys[index]))
+			return btree_iterator(node, index);
+		node = node->_pointers.empty() ? nullptr : node->_pointers[index];
 	}
 	return end();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) const {
-	if (!_root) return cend();
-	std::stack<std::pair<btree_node* const*, size_t>> path;
-	btree_node* const* node_ptr = &_root;
-	while (true) {
-		btree_node* node = *node_ptr;
-		size_t lo = 0, hi = node->_keys.size();
-		while (lo < hi) {
-			size_t mid = (lo + hi) / 2;
-			if (compare_keys(node->_keys[mid].first, key))
-				lo = mid + 1;
-			else
-				hi = mid;
-		}
-		if (lo < node->_keys.size() &&
-			!compare_keys(key, node->_keys[lo].first) &&
-			!compare_keys(node->_keys[lo].first, key)) {
-			path.emplace(node_ptr, lo);
-			return btree_const_iterator(path, lo);
-		}
-		if (node->_pointers.empty()) break;
-		path.emplace(node_ptr, lo);
-		node_ptr = &node->_pointers[lo];
+template<typename key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find_key(const key_like& key) const {
+	const btree_node* node = _root;
+	while (node) {
+		size_t index = search_in_node<false>(node, key);
+		if (index < node->_keys.size() && !compare_keys(key, node->_keys[index]))
+			return btree_const_iterator(node, index);
+		node = node->_pointers.empty() ? nullptr : node->_pointers[index];
 	}
 	return cend();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) {
-	if (!_root) return end();
-	std::stack<std::pair<btree_node**, size_t>> path;
+template<typename key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound_key(const key_like& key) {
+	// Past the end of a leaf the bound is the separator of the nearest ancestor that has one
+	btree_iterator bound;
 	btree_node* node = _root;
-	while (true) {
-		size_t lo = 0, hi = node->_keys.size();
-		while (lo < hi) {
-			size_t mid = (lo + hi) / 2;
-			if (compare_keys(node->_keys[mid].first, key))
-				lo = mid + 1;
-			else
-				hi = mid;
-		}
-		path.emplace(&node, lo);
-		if (node->_pointers.empty()) {
-			if (lo < node->_keys.size())
-				return btree_iterator(path, lo);
-			else
-				return end();
-		}
-		node = node->_pointers[lo];
+	while (node) {
+		size_t index = search_in_node<false>(node, key);
+		if (index < node->_keys.size())
+			bound = btree_iterator(node, index);
+		node = node->_pointers.empty() ? nullptr : node->_pointers[index];
 	}
+	return bound;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const {
-	if (!_root) return cend();
-	std::stack<std::pair<btree_node* const*, size_t>> path;
-	btree_node* const* node_ptr = &_root;
-	while (true) {
-		btree_node* node = *node_ptr;
-		size_t lo = 0, hi = node->_keys.size();
-		while (lo < hi) {
-			size_t mid = (lo + hi) / 2;
-			if (compare_keys(node->_keys[mid].first, key))
-				lo = mid + 1;
-			else
-				hi = mid;
-		}
-		path.emplace(node_ptr, lo);
-		if (node->_pointers.empty()) {
-			if (lo < node->_keys.size())
-				return btree_const_iterator(path, lo);
-			else
-				return cend();
-		}
-		node_ptr = &node->_pointers[lo];
+template<typename key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound_key(const key_like& key) const {
+	// Past the end of a leaf the bound is the separator of the nearest ancestor that has one
+	btree_const_iterator bound;
+	const btree_node* node = _root;
+	while (node) {
+		size_t index = search_in_node<false>(node, key);
+		if (index < node->_keys.size())
+			bound = btree_const_iterator(node, index);
+		node = node->_pointers.empty() ? nullptr : node->_pointers[index];
 	}
+	return bound;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) {
-	if (!_root) return end();
-	std::stack<std::pair<btree_node**, size_t>> path;
+template<typename key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound_key(const key_like& key) {
+	// Past the end of a leaf the bound is the separator of the nearest ancestor that has one
+	btree_iterator bound;
 	btree_node* node = _root;
-	while (true) {
-		size_t lo = 0, hi = node->_keys.size();
-		while (lo < hi) {
-			size_t mid = (lo + hi) / 2;
-			if (!compare_keys(key, node->_keys[mid].first))
-				lo = mid + 1;
-			else
-				hi = mid;
-		}
-		path.emplace(&node, lo);
-		if (node->_pointers.empty()) {
-			if (lo < node->_keys.size())
-				return btree_iterator(path, lo);
-			else
-				return end();
-		}
-		node = node->_pointers[lo];
+	while (node) {
+		size_t index = search_in_node<true>(node, key);
+		if (index < node->_keys.size())
+			bound = btree_iterator(node, index);
+		node = node->_pointers.empty() ? nullptr : node->_pointers[index];
 	}
+	return bound;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const {
-	if (!_root) return cend();
-	std::stack<std::pair<btree_node* const*, size_t>> path;
-	btree_node* const* node_ptr = &_root;
-	while (true) {
-		btree_node* node = *node_ptr;
-		size_t lo = 0, hi = node->_keys.size();
-		while (lo < hi) {
-			if (!compare_keys(key, node->_keys[(lo + hi) / 2].first))
-				lo = (lo + hi) / 2 + 1;
-			else
-				hi = (lo + hi) / 2;
-		}
-		path.emplace(node_ptr, lo);
-		if (node->_pointers.empty()) {
-			if (lo < node->_keys.size())
-				return btree_const_iterator(path, lo);
-			else
-				return cend();
-		}
-		node_ptr = &node->_pointers[lo];
+template<typename key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound_key(const key_like& key) const {
+	// Past the end of a leaf the bound is the separator of the nearest ancestor that has one
+	btree_const_iterator bound;
+	const btree_node* node = _root;
+	while (node) {
+		size_t index = search_in_node<true>(node, key);
+		if (index < node->_keys.size())
+			bound = btree_const_iterator(node, index);
+		node = node->_pointers.empty() ? nullptr : node->_pointers[index];
 	}
+	return bound;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) {
+	return find_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) const {
+	return find_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) {
+	return lower_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const {
+	return lower_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) {
+	return upper_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const {
+	return upper_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const key_like& key) {
+	return find_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const key_like& key) const {
+	return find_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const key_like& key) {
+	return lower_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const key_like& key) const {
+	return lower_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const key_like& key) {
+	return upper_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const key_like& key) const {
+	return upper_bound_key(key);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -1308,118 +1370,76 @@ bool B_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const {
 	return find(key) != end();
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename key_like> requires transparent_compator<compare, tkey, key_like>
+bool B_tree<tkey, tvalue, compare, t>::contains(const key_like& key) const {
+	return find_key(key) != end();
+}
+
 // endregion lookup implementation
 
 // region modifiers implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 void B_tree<tkey, tvalue, compare, t>::clear() noexcept {
-	if (_root) {
-		std::stack<btree_node*> nodes;
-		nodes.push(_root);
-		while (!nodes.empty()) {
-			auto* current = nodes.top();
-			nodes.pop();
-			for (auto* child: current->_pointers) {
-				if (child) {
-					nodes.push(child);
-				}
-			}
-			delete current;
-		}
-		_root = nullptr;
-		_size = 0;
-	}
+	destroy_subtree(_root);
+	_root = nullptr;
+	_size = 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 std::pair<typename B_tree<tkey, tvalue, compare, t>::btree_iterator, bool>
 B_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data) {
+	return insert(tree_data_type(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+std::pair<typename B_tree<tkey, tvalue, compare, t>::btree_iterator, bool>
+B_tree<tkey, tvalue, compare, t>::insert(tree_data_type&& data) {
 	if (!_root) {
 		_root = new btree_node();
-		_root->_keys.push_back(data);
+		_root->_keys.push_back(std::move(data.first));
+		_root->_values.push_back(std::move(data.second));
 		_size = 1;
-		return {btree_iterator(), true};
+		return {begin(), true};
 	}
 
-	std::stack<std::pair<btree_node*, size_t>> path_stack;
-	btree_node* cur = _root;
-
+	btree_node* node = _root;
+	size_t index;
 	while (true) {
-		size_t idx = 0;
-		while (idx < cur->_keys.size() && compare_keys(cur->_keys[idx].first, data.first)) {
-			++idx;
-		}
-		path_stack.push({cur, idx});
-		if (cur->_pointers.empty()) break;
-		cur = cur->_pointers[idx];
+		index = search_in_node<false>(node, data.first);
+		if (index < node->_keys.size() && !compare_keys(data.first, node->_keys[index]))
+			return {btree_iterator(node, index), false};
+		if (node->_pointers.empty())
+			break;
+		node = node->_pointers[index];
 	}
 
-	auto& keys = cur->_keys;
-	auto it = std::lower_bound(
-			keys.begin(), keys.end(), data,
-			[this](auto const& a, auto const& b) { return compare_pairs(a, b); }
-	);
-	if (it != keys.end() &&
-		!compare_keys(data.first, it->first) &&
-		!compare_keys(it->first, data.first)) {
-		return {btree_iterator(), false};
-	}
-	keys.insert(it, data);
+	node->_keys.insert(node->_keys.begin() + index, std::move(data.first));
+	node->_values.insert(node->_values.begin() + index, std::move(data.second));
 	++_size;
 
-	while (!path_stack.empty()) {
-		auto [node, child_idx] = path_stack.top();
-		path_stack.pop();
-
-		if (node->_keys.size() <= maximum_keys_in_node) break;
-
-		size_t mid = t;
-		auto mid_key = node->_keys[mid];
-		btree_node* right = new btree_node();
-		right->_keys.assign(
-				node->_keys.begin() + mid + 1,
-				node->_keys.end()
-		);
-		node->_keys.resize(mid);
-
-		if (!node->_pointers.empty()) {
-			right->_pointers.assign(
-					node->_pointers.begin() + mid + 1,
-					node->_pointers.end()
-			);
-			node->_pointers.resize(mid + 1);
-		}
-
-		if (path_stack.empty()) {
-			btree_node* new_root = new btree_node();
-			new_root->_keys.push_back(mid_key);
-			new_root->_pointers.push_back(node);
-			new_root->_pointers.push_back(right);
-			_root = new_root;
-		} else {
-			auto [parent, ignored] = path_stack.top();
-
-			auto insert_it = std::lower_bound(
-					parent->_keys.begin(),
-					parent->_keys.end(),
-					mid_key,
-					[this](auto const& a, auto const& b){ return compare_pairs(a, b); }
-			);
-			size_t pos = std::distance(parent->_keys.begin(), insert_it);
-
-			parent->_keys.insert(parent->_keys.begin() + pos, mid_key);
-			parent->_pointers.insert(parent->_pointers.begin() + pos + 1, right);
+	// Overflowing nodes are split bottom-up, the inserted element is followed through the splits
+	btree_node* holder = node;
+	size_t position = index;
+
+	while (node->_keys.size() > maximum_keys_in_node) {
+		btree_node* parent = split_node(node);
+		size_t child_index = child_position(parent, node);
+		if (holder == node && position == t) {
+			holder = parent;
+			position = child_index;
+		} else if (holder == node && position > t) {
+			holder = parent->_pointers[child_index + 1];
+			position -= t + 1;
 		}
+		node = parent;
+	}
+	if (!node->_parent) {
+		_root = node;
 	}
 
-	return {btree_iterator(), true};
-}
-
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-std::pair<typename B_tree<tkey, tvalue, compare, t>::btree_iterator, bool>
-B_tree<tkey, tvalue, compare, t>::insert(tree_data_type&& data) {
-	return insert(data);
+	return {btree_iterator(holder, position), true};
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -1462,31 +1482,33 @@ template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator
 B_tree<tkey, tvalue, compare, t>::erase(btree_iterator pos) {
 	if (pos == end()) return pos;
-	tkey key = pos->first;
-	++pos;
-	erase(key);
-	return pos;
+	// The key is copied: the removal moves elements between nodes
+	return erase(tkey(pos->first));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator
 B_tree<tkey, tvalue, compare, t>::erase(btree_const_iterator pos) {
-	return erase(btree_iterator(pos));
+	return erase(btree_iterator(const_cast<btree_node*>(pos._node), pos._index));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator
 B_tree<tkey, tvalue, compare, t>::erase(btree_iterator first, btree_iterator last) {
-	while (first != last) {
-		first = erase(first);
+	if (first == last) return last;
+	if (last == end()) {
+		erase_span(tkey(first->first), nullptr, false);
+		return end();
 	}
-	return last;
+	tkey hi(last->first);
+	erase_span(tkey(first->first), &hi, false);
+	return lower_bound_key(hi);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator
 B_tree<tkey, tvalue, compare, t>::erase(btree_const_iterator beg, btree_const_iterator en) {
-	return erase(btree_iterator(beg), btree_iterator(en));
+	return erase(btree_iterator(const_cast<btree_node*>(beg._node), beg._index), btree_iterator(const_cast<btree_node*>(en._node), en._index));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -1494,53 +1516,419 @@ typename B_tree<tkey, tvalue, compare, t>::btree_iterator
 B_tree<tkey, tvalue, compare, t>::erase(const tkey& key) {
 	if (!_root) return end();
 
-	std::function<bool(btree_node*, const tkey&)> remove_key;
-	remove_key = [this, &remove_key](btree_node* node, const tkey& k) -> bool {
-		size_t idx = 0;
-		while (idx < node->_keys.size() && compare_keys(node->_keys[idx].first, k)) ++idx;
-		if (idx < node->_keys.size() && !compare_keys(k, node->_keys[idx].first) && !compare_keys(node->_keys[idx].first, k)) {
-			if (node->_pointers.empty()) {
-				node->_keys.erase(node->_keys.begin() + idx);
-				--_size;
-				return node->_keys.size() < minimum_keys_in_node;
-			} else {
-				btree_node* pred = node->_pointers[idx];
-				while (!pred->_pointers.empty()) pred = pred->_pointers.back();
-				auto pred_pair = pred->_keys.back();
-				node->_keys[idx] = pred_pair;
-				bool underflow = remove_key(node->_pointers[idx], pred_pair.first);
-
-				if (underflow) {
-					node->_pointers[idx]->_keys.push_back({});
+	btree_node* node = _root;
+	size_t index;
+	while (true) {
+		index = search_in_node<false>(node, key);
+		if (index < node->_keys.size() && !compare_keys(key, node->_keys[index]))
+			break;
+		if (node->_pointers.empty())
+			return end();
+		node = node->_pointers[index];
+	}
+
+	if (!node->_pointers.empty()) {
+		// An inner element is replaced by its predecessor, which is then removed from its leaf
+		btree_node* leaf = node->_pointers[index];
+		while (!leaf->_pointers.empty()) {
+			leaf = leaf->_pointers.back();
+		}
+		node->_keys[index] = std::move(leaf->_keys.back());
+		node->_values[index] = std::move(leaf->_values.back());
+		node = leaf;
+		index = leaf->_keys.size() - 1;
+	}
+
+	node->_keys.erase(node->_keys.begin() + index);
+	node->_values.erase(node->_values.begin() + index);
+	--_size;
+
+	_root = restore_after_removal(node, _root);
+
+	return lower_bound_key(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+size_t B_tree<tkey, tvalue, compare, t>::erase_range(const tkey& lo, const tkey& hi) {
+	if (compare_keys(hi, lo)) return 0;
+	return erase_span(lo, &hi, true);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+size_t B_tree<tkey, tvalue, compare, t>::erase_span(const tkey& lo, const tkey* hi, bool hi_included) {
+	if (!_root) return 0;
+
+	auto [left, middle] = split_subtree<false>(_root, lo);
+	btree_node* right = nullptr;
+	if (hi && middle) {
+		std::tie(middle, right) = hi_included ? split_subtree<true>(middle, *hi) : split_subtree<false>(middle, *hi);
+	}
+
+	size_t erased = destroy_subtree(middle);
+	_size -= erased;
+	_root = join_subtrees(left, right);
+	return erased;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+void B_tree<tkey, tvalue, compare, t>::bulk_load(iterator begin, iterator end, double fill_factor) {
+	if (!(fill_factor > 0 && fill_factor <= 1)) {
+		throw std::invalid_argument("Fill factor must be in (0, 1]");
+	}
+
+	std::vector<tree_data_type> data(begin, end);
+	auto not_ascending = [this](const tree_data_type& lhs, const tree_data_type& rhs) { return !compare_keys(lhs.first, rhs.first); };
+	if (std::adjacent_find(data.begin(), data.end(), not_ascending) != data.end()) {
+		std::stable_sort(data.begin(), data.end(), [this](const tree_data_type& lhs, const tree_data_type& rhs) { return compare_keys(lhs.first, rhs.first); });
+		data.erase(std::unique(data.begin(), data.end(), [this](const tree_data_type& lhs, const tree_data_type& rhs) { return !compare_keys(lhs.first, rhs.first); }), data.end());
+	}
+
+	size_t leaf_keys = static_cast<size_t>(fill_factor * maximum_keys_in_node);
+	leaf_keys = std::clamp<size_t>(leaf_keys, std::max<size_t>(minimum_keys_in_node, 1), maximum_keys_in_node);
+
+	clear();
+	build_from_sorted(std::move(data), leaf_keys);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void B_tree<tkey, tvalue, compare, t>::build_from_sorted(std::vector<tree_data_type>&& data, size_t leaf_keys) {
+	if (data.empty()) return;
+	_size = data.size();
+
+	std::vector<btree_node*> children;
+	size_t node_keys = leaf_keys;
+	while (true) {
+		// Every node of the level but the last is followed by a separator that goes one level up.
+		// The node count is the one closest to node_keys per node that keeps every node in [minimum, maximum]
+		size_t count = data.size();
+		size_t nodes = (count + 1 + (node_keys + 1) / 2) / (node_keys + 1);
+		nodes = std::max(nodes, (count + maximum_keys_in_node + 1) / (maximum_keys_in_node + 1));
+		nodes = std::max<size_t>(std::min(nodes, (count + 1) / (minimum_keys_in_node + 1)), 1);
+
+		size_t keys_per_node = (count - (nodes - 1)) / nodes;
+		size_t longer_nodes = (count - (nodes - 1)) % nodes;
+
+		std::vector<tree_data_type> separators;
+		std::vector<btree_node*> level;
+		separators.reserve(nodes - 1);
+		level.reserve(nodes);
+
+		auto element = data.begin();
+		auto child = children.begin();
+		for (size_t i = 0; i < nodes; ++i) {
+			auto* node = new btree_node();
+			size_t keys = keys_per_node + (i < longer_nodes);
+			for (size_t j = 0; j < keys; ++j, ++element) {
+				node->_keys.push_back(std::move(element->first));
+				node->_values.push_back(std::move(element->second));
+			}
+			if (!children.empty()) {
+				for (size_t j = 0; j <= keys; ++j, ++child) {
+					(*child)->_parent = node;
+					node->_pointers.push_back(*child);
 				}
-				return false;
+			}
+			level.push_back(node);
+			if (i + 1 < nodes) {
+				separators.push_back(std::move(*element++));
 			}
 		}
 
-		if (node->_pointers.empty()) {
-			return node->_keys.size() < minimum_keys_in_node;
+		if (nodes == 1) {
+			_root = level.front();
+			return;
 		}
+		data = std::move(separators);
+		children = std::move(level);
+		node_keys = maximum_keys_in_node;
+	}
+}
 
-		bool underflow = remove_key(node->_pointers[idx], k);
-		if (underflow) {
-			//borrow / merge
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_node* B_tree<tkey, tvalue, compare, t>::split_node(btree_node* node) {
+	btree_node* parent = node->_parent;
+	if (!parent) {
+		parent = new btree_node();
+		parent->_pointers.push_back(node);
+		node->_parent = parent;
+	}
+	size_t child_index = child_position(parent, node);
+
+	btree_node* right = new btree_node();
+	right->_parent = parent;
+	right->_keys.assign(std::make_move_iterator(node->_keys.begin() + t + 1), std::make_move_iterator(node->_keys.end()));
+	right->_values.assign(std::make_move_iterator(node->_values.begin() + t + 1), std::make_move_iterator(node->_values.end()));
+	node->_keys.erase(node->_keys.begin() + t + 1, node->_keys.end());
+	node->_values.erase(node->_values.begin() + t + 1, node->_values.end());
+	if (!node->_pointers.empty()) {
+		right->_pointers.assign(node->_pointers.begin() + t + 1, node->_pointers.end());
+		node->_pointers.erase(node->_pointers.begin() + t + 1, node->_pointers.end());
+		for (auto* child: right->_pointers) {
+			child->_parent = right;
 		}
-		return false;
-	};
+	}
+
+	move_element(node, t, parent, child_index);
+	parent->_pointers.insert(parent->_pointers.begin() + child_index + 1, right);
+	return parent;
+}
 
-	remove_key(_root, key);
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_node* B_tree<tkey, tvalue, compare, t>::restore_after_removal(btree_node* node, btree_node* root) {
+	while (node->_parent && node->_keys.size() < minimum_keys_in_node) {
+		btree_node* parent = node->_parent;
+		rebalance(parent, child_position(parent, node));
+		node = parent;
+	}
 
-	if (_root->_keys.empty()) {
-		btree_node* old = _root;
-		if (!_root->_pointers.empty()) {
-			_root = _root->_pointers[0];
-		} else {
-			_root = nullptr;
+	if (root->_keys.empty()) {
+		btree_node* old = root;
+		root = old->_pointers.empty() ? nullptr : old->_pointers[0];
+		if (root) {
+			root->_parent = nullptr;
 		}
 		delete old;
 	}
+	return root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void B_tree<tkey, tvalue, compare, t>::fill_child(btree_node* parent, size_t child_index) {
+	while (parent->_pointers[child_index]->_keys.size() < minimum_keys_in_node && !rebalance(parent, child_index)) {
+	}
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<bool upper, typename key_like>
+std::pair<typename B_tree<tkey, tvalue, compare, t>::btree_node*, typename B_tree<tkey, tvalue, compare, t>::btree_node*>
+B_tree<tkey, tvalue, compare, t>::split_subtree(btree_node* node, const key_like& key) {
+	size_t index = search_in_node<upper>(node, key);
+
+	// node keeps the keys before index, right takes the others
+	btree_node* right = new btree_node();
+	right->_keys.assign(std::make_move_iterator(node->_keys.begin() + index), std::make_move_iterator(node->_keys.end()));
+	right->_values.assign(std::make_move_iterator(node->_values.begin() + index), std::make_move_iterator(node->_values.end()));
+	node->_keys.erase(node->_keys.begin() + index, node->_keys.end());
+	node->_values.erase(node->_values.begin() + index, node->_values.end());
+
+	if (node->_pointers.empty()) {
+		return {detach(node), detach(right)};
+	}
+
+	auto [child_left, child_right] = split_subtree<upper>(node->_pointers[index], key);
+	right->_pointers.assign(node->_pointers.begin() + index + 1, node->_pointers.end());
+	node->_pointers.erase(node->_pointers.begin() + index, node->_pointers.end());
+	for (auto* child: right->_pointers) {
+		child->_parent = right;
+	}
+
+	// The last key of node separates it from the left half of the split child, the first key of right
+	// separates the right half of the split child from right
+	btree_node* left_part;
+	if (node->_keys.empty()) {
+		delete node;
+		left_part = child_left;
+	} else {
+		tkey separator = std::move(node->_keys.back());
+		tvalue value = std::move(node->_values.back());
+		node->_keys.pop_back();
+		node->_values.pop_back();
+		left_part = join_subtrees(detach(node), std::move(separator), std::move(value), child_left);
+	}
+
+	btree_node* right_part;
+	if (right->_keys.empty()) {
+		delete right;
+		right_part = child_right;
+	} else {
+		tkey separator = std::move(right->_keys.front());
+		tvalue value = std::move(right->_values.front());
+		right->_keys.erase(right->_keys.begin());
+		right->_values.erase(right->_values.begin());
+		right_part = join_subtrees(child_right, std::move(separator), std::move(value), detach(right));
+	}
+
+	return {left_part, right_part};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_node*
+B_tree<tkey, tvalue, compare, t>::join_subtrees(btree_node* left, tkey&& key, tvalue&& value, btree_node* right) {
+	if (!left && !right) {
+		auto* node = new btree_node();
+		node->_keys.push_back(std::move(key));
+		node->_values.push_back(std::move(value));
+		return node;
+	}
+
+	size_t left_height = left ? height(left) + 1 : 0;
+	size_t right_height = right ? height(right) + 1 : 0;
+
+	if (left_height == right_height) {
+		auto* root = new btree_node();
+		root->_keys.push_back(std::move(key));
+		root->_values.push_back(std::move(value));
+		root->_pointers.push_back(left);
+		root->_pointers.push_back(right);
+		left->_parent = root;
+		right->_parent = root;
+		fill_child(root, 0);
+		if (root->_pointers.size() == 2) {
+			fill_child(root, 1);
+		}
+		return restore_after_removal(root, root);
+	}
 
-	return find(key);
+	// The lower subtree (or the lone separator) is hung on the spine of the higher one facing it,
+	// at the level just above its own
+	btree_node* node;
+	if (left_height > right_height) {
+		node = left;
+		for (size_t level = left_height; level > right_height + 1; --level) {
+			node = node->_pointers.back();
+		}
+		node->_keys.push_back(std::move(key));
+		node->_values.push_back(std::move(value));
+		if (right) {
+			node->_pointers.push_back(right);
+			right->_parent = node;
+			fill_child(node, node->_pointers.size() - 1);
+		}
+	} else {
+		node = right;
+		for (size_t level = right_height; level > left_height + 1; --level) {
+			node = node->_pointers.front();
+		}
+		node->_keys.insert(node->_keys.begin(), std::move(key));
+		node->_values.insert(node->_values.begin(), std::move(value));
+		if (left) {
+			node->_pointers.insert(node->_pointers.begin(), left);
+			left->_parent = node;
+			fill_child(node, 0);
+		}
+	}
+
+	while (node->_keys.size() > maximum_keys_in_node) {
+		node = split_node(node);
+	}
+	while (node->_parent) {
+		node = node->_parent;
+	}
+	return node;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_node* B_tree<tkey, tvalue, compare, t>::join_subtrees(btree_node* left, btree_node* right) {
+	if (!left) return right;
+	if (!right) return left;
+
+	// The minimum of right becomes the separator
+	btree_node* leaf = right;
+	while (!leaf->_pointers.empty()) {
+		leaf = leaf->_pointers.front();
+	}
+	tkey key = std::move(leaf->_keys.front());
+	tvalue value = std::move(leaf->_values.front());
+	leaf->_keys.erase(leaf->_keys.begin());
+	leaf->_values.erase(leaf->_values.begin());
+	right = restore_after_removal(leaf, right);
+
+	return join_subtrees(left, std::move(key), std::move(value), right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+typename B_tree<tkey, tvalue, compare, t>::btree_node* B_tree<tkey, tvalue, compare, t>::detach(btree_node* node) noexcept {
+	btree_node* root = node;
+	if (node->_keys.empty()) {
+		root = node->_pointers.empty() ? nullptr : node->_pointers.front();
+		delete node;
+	}
+	if (root) {
+		root->_parent = nullptr;
+	}
+	return root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+size_t B_tree<tkey, tvalue, compare, t>::height(const btree_node* node) noexcept {
+	size_t height = 0;
+	for (; !node->_pointers.empty(); node = node->_pointers.front()) {
+		++height;
+	}
+	return height;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+size_t B_tree<tkey, tvalue, compare, t>::destroy_subtree(btree_node* node) noexcept {
+	if (!node) return 0;
+
+	size_t elements = 0;
+	std::stack<btree_node*> nodes;
+	nodes.push(node);
+	while (!nodes.empty()) {
+		auto* current = nodes.top();
+		nodes.pop();
+		elements += current->_keys.size();
+		for (auto* child: current->_pointers) {
+			nodes.push(child);
+		}
+		delete current;
+	}
+	return elements;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+void B_tree<tkey, tvalue, compare, t>::move_element(btree_node* from, size_t index, btree_node* to, size_t to_index) {
+	to->_keys.insert(to->_keys.begin() + to_index, std::move(from->_keys[index]));
+	to->_values.insert(to->_values.begin() + to_index, std::move(from->_values[index]));
+	from->_keys.erase(from->_keys.begin() + index);
+	from->_values.erase(from->_values.begin() + index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+bool B_tree<tkey, tvalue, compare, t>::rebalance(btree_node* parent, size_t child_index) {
+	btree_node* node = parent->_pointers[child_index];
+	btree_node* left = child_index > 0 ? parent->_pointers[child_index - 1] : nullptr;
+	btree_node* right = child_index + 1 < parent->_pointers.size() ? parent->_pointers[child_index + 1] : nullptr;
+
+	if (left && left->_keys.size() > minimum_keys_in_node) {
+		move_element(parent, child_index - 1, node, 0);
+		move_element(left, left->_keys.size() - 1, parent, child_index - 1);
+		if (!left->_pointers.empty()) {
+			node->_pointers.insert(node->_pointers.begin(), left->_pointers.back());
+			node->_pointers.front()->_parent = node;
+			left->_pointers.pop_back();
+		}
+		return false;
+	}
+
+	if (right && right->_keys.size() > minimum_keys_in_node) {
+		move_element(parent, child_index, node, node->_keys.size());
+		move_element(right, 0, parent, child_index);
+		if (!right->_pointers.empty()) {
+			node->_pointers.push_back(right->_pointers.front());
+			node->_pointers.back()->_parent = node;
+			right->_pointers.erase(right->_pointers.begin());
+		}
+		return false;
+	}
+
+	// Neither sibling can lend: the node is merged with one of them through their separator
+	size_t separator = left ? child_index - 1 : child_index;
+	btree_node* merged = parent->_pointers[separator];
+	btree_node* absorbed = parent->_pointers[separator + 1];
+
+	move_element(parent, separator, merged, merged->_keys.size());
+	merged->_keys.insert(merged->_keys.end(), std::make_move_iterator(absorbed->_keys.begin()), std::make_move_iterator(absorbed->_keys.end()));
+	merged->_values.insert(merged->_values.end(), std::make_move_iterator(absorbed->_values.begin()), std::make_move_iterator(absorbed->_values.end()));
+	for (auto* child: absorbed->_pointers) {
+		child->_parent = merged;
+		merged->_pointers.push_back(child);
+	}
+	parent->_pointers.erase(parent->_pointers.begin() + separator + 1);
+	delete absorbed;
+	return true;
 }
 
 // endregion modifiers implementation
@@ -1,9 +1,12 @@
 #include "gtest/gtest.h"
 
 #include <list>
+#include <map>
 #include <random>
+#include <string_view>
 #include <vector>
 #include <b_tree.h>
+#include <random_operations_test.h>
 #include <client_logger_builder.h>
 
 
@@ -496,6 +499,218 @@ TEST(bTreePositiveTests, test8)
     logger->trace("bTreePositiveTests.test8 finished");
 }
 
+TEST(bTreePositiveTests, test9)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test9 started");
+
+    B_tree<std::string, int, std::less<>, 3> tree(std::less<>(), nullptr, logger.get());
+    std::map<std::string, int> expected;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string key = "a long key that does not fit in place " + std::to_string(i * 2);
+        tree.emplace(key, i);
+        expected.emplace(key, i);
+    }
+
+    // Lookups by std::string_view agree with std::map lookups by std::string, bounds included
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string key = "a long key that does not fit in place " + std::to_string(i);
+        std::string_view view = key;
+
+        ASSERT_EQ(tree.contains(view), expected.contains(key));
+        ASSERT_EQ(tree.find(view) == tree.end(), !expected.contains(key));
+
+        auto lower = expected.lower_bound(key);
+        auto upper = expected.upper_bound(key);
+
+        ASSERT_EQ(tree.lower_bound(view) == tree.end(), lower == expected.end());
+        ASSERT_EQ(tree.upper_bound(view) == tree.end(), upper == expected.end());
+
+        if (lower != expected.end())
+        {
+            ASSERT_EQ(tree.lower_bound(view)->first, lower->first);
+            ASSERT_EQ(tree.lower_bound(key)->first, lower->first);
+        }
+
+        if (upper != expected.end())
+        {
+            ASSERT_EQ(tree.upper_bound(view)->first, upper->first);
+        }
+    }
+
+    auto const &view_tree = tree;
+    EXPECT_EQ(view_tree.find(std::string_view("a long key that does not fit in place 10"))->second, 5);
+    EXPECT_TRUE(view_tree.lower_bound(std::string_view("b")) == view_tree.end());
+
+    logger->trace("bTreePositiveTests.test9 finished");
+}
+
+TEST(bTreePositiveTests, test10)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test10 started");
+
+    // Insertions and removals with node splits, borrows and merges, both node search strategies included
+    std::mt19937 engine(10);
+    random_operations_test<B_tree<int, int, std::less<int>, 2>>(engine);
+    random_operations_test<B_tree<int, int, std::less<int>, 3>>(engine);
+    random_operations_test<B_tree<int, int, std::less<int>, 16>>(engine);
+    random_operations_test<B_tree<int, int, std::less<int>, 64>>(engine);
+
+    B_tree<std::string, int, std::less<std::string>, 4> tree(std::less<std::string>(), nullptr, logger.get());
+    std::map<std::string, int> expected;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string key = std::to_string(i * 7919 % 1000);
+        if (i % 4 == 3)
+        {
+            tree.erase(key);
+            expected.erase(key);
+        }
+        else
+        {
+            tree.insert_or_assign(std::make_pair(key, i));
+            expected.insert_or_assign(key, i);
+        }
+    }
+
+    EXPECT_TRUE(agrees_with_map(tree, expected));
+
+    logger->trace("bTreePositiveTests.test10 finished");
+}
+
+TEST(bTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test11 started");
+
+    using tree_type = B_tree<int, int, std::less<int>, 2>;
+
+    static_assert(std::is_trivially_copyable_v<tree_type::btree_iterator>);
+    static_assert(std::is_trivially_copyable_v<tree_type::btree_const_reverse_iterator>);
+
+    tree_type tree(std::less<int>(), nullptr, logger.get());
+    for (int i = 0; i < 300; ++i)
+    {
+        tree.emplace(i * 37 % 300, i);
+    }
+
+    // Forward and backward walks visit every element in order, across leaves and inner nodes
+    int expected = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++expected)
+    {
+        ASSERT_EQ(it->first, expected);
+    }
+    EXPECT_EQ(expected, 300);
+
+    auto const &const_tree = tree;
+    for (auto it = const_tree.rbegin(); it != const_tree.rend(); ++it)
+    {
+        ASSERT_EQ((*it).first, --expected);
+    }
+    EXPECT_EQ(expected, 0);
+
+    auto it = tree.find(150);
+    auto copy = it;
+    --it;
+    ++it;
+    EXPECT_TRUE(it == copy);
+    EXPECT_EQ((--copy)->first, 149);
+    EXPECT_EQ(tree.begin().depth(), tree.rbegin().depth());
+
+    logger->trace("bTreePositiveTests.test11 finished");
+}
+
+template<size_t t>
+void bulk_operations_test(std::mt19937 &engine, double fill_factor)
+{
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 3000; ++i)
+    {
+        data.emplace_back(i * 2, i);
+    }
+
+    B_tree<int, int, std::less<int>, t> tree;
+    tree.bulk_load(data.begin(), data.end(), fill_factor);
+    std::map<int, int, std::less<int>> expected(data.begin(), data.end());
+
+    ASSERT_TRUE(agrees_with_map(tree, expected));
+
+    std::uniform_int_distribution<int> bounds(-10, 6010);
+    for (int i = 0; i < 40; ++i)
+    {
+        int lo = bounds(engine);
+        int hi = lo + bounds(engine) % (i % 4 == 0 ? 3000 : 60);
+
+        // The range is closed, an empty one (hi < lo) erases nothing
+        size_t expected_erased = 0;
+        if (lo <= hi)
+        {
+            auto expected_first = expected.lower_bound(lo);
+            auto expected_last = expected.upper_bound(hi);
+            expected_erased = std::distance(expected_first, expected_last);
+            expected.erase(expected_first, expected_last);
+        }
+
+        ASSERT_EQ(tree.erase_range(lo, hi), expected_erased);
+        ASSERT_TRUE(agrees_with_map(tree, expected));
+
+        // The tree stays valid for the per-key operations after the subtree surgery
+        int key = bounds(engine);
+        ASSERT_EQ(tree.emplace(key, -key).second, expected.emplace(key, -key).second);
+        key = bounds(engine);
+        tree.erase(key);
+        expected.erase(key);
+    }
+
+    ASSERT_TRUE(agrees_with_map(tree, expected));
+}
+
+TEST(bTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test12 started");
+
+    std::mt19937 engine(12);
+    bulk_operations_test<2>(engine, 1.0);
+    bulk_operations_test<3>(engine, 0.5);
+    bulk_operations_test<5>(engine, 0.7);
+    bulk_operations_test<32>(engine, 0.1);
+
+    // Unsorted input is sorted, of equal keys the first one is kept, as with insert
+    B_tree<int, std::string, std::less<int>, 3> tree({ {5, "a"}, {1, "b"}, {5, "c"}, {3, "d"}, {1, "e"} }, std::less<int>(), nullptr, logger.get());
+    std::vector<std::pair<int, std::string>> contents(tree.begin(), tree.end());
+    std::vector<std::pair<int, std::string>> expected = { {1, "b"}, {3, "d"}, {5, "a"} };
+    EXPECT_EQ(contents, expected);
+
+    EXPECT_THROW(tree.bulk_load(expected.begin(), expected.end(), 0.0), std::invalid_argument);
+
+    tree.erase(tree.begin(), tree.end());
+    EXPECT_TRUE(tree.empty());
+
+    logger->trace("bTreePositiveTests.test12 finished");
+}
+
 TEST(bTreeNegativeTests, test1)
 {
     std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
@@ -0,0 +1,137 @@
+#ifndef MP_OS_INDEXING_TREE_RANDOM_OPERATIONS_TEST_H
+#define MP_OS_INDEXING_TREE_RANDOM_OPERATIONS_TEST_H
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <utility>
+
+/** Whether the tree holds the same items as expected in the same order,
+ *  walking backwards as well when the tree has reverse iterators
+ */
+template<typename tree_type, typename tkey, typename tvalue, typename comp>
+bool agrees_with_map(
+        tree_type const &tree,
+        std::map<tkey, tvalue, comp> const &expected)
+{
+    if (tree.size() != expected.size())
+    {
+        return false;
+    }
+
+    auto it = tree.cbegin();
+
+    for (auto const &item: expected)
+    {
+        if (it == tree.cend() || it->first != item.first || it->second != item.second)
+        {
+            return false;
+        }
+
+        ++it;
+    }
+
+    if (it != tree.cend())
+    {
+        return false;
+    }
+
+    if constexpr (requires { tree.crbegin(); })
+    {
+        auto reverse_it = tree.crbegin();
+
+        for (auto item = expected.rbegin(); item != expected.rend(); ++item)
+        {
+            if (reverse_it == tree.crend() || reverse_it->first != item->first)
+            {
+                return false;
+            }
+
+            ++reverse_it;
+        }
+
+        return reverse_it == tree.crend();
+    }
+
+    return true;
+}
+
+/** Random insertions and removals checked against std::map, then lookups, copying, range removal
+ *  and removal from the front. check(tree, expected) adds the checks of a particular tree,
+ *  it runs after the random operations and after the range removal
+ */
+template<typename tree_type, typename checks>
+void random_operations_test(std::mt19937 &engine, checks &&check)
+{
+    tree_type tree;
+    std::map<int, int> expected;
+    std::uniform_int_distribution<int> keys(0, 2000);
+
+    for (int i = 0; i < 4000; ++i)
+    {
+        int key = keys(engine);
+
+        if (i % 3 == 2)
+        {
+            auto next = tree.erase(key);
+            auto expected_next = expected.erase(key) ? expected.lower_bound(key) : expected.end();
+
+            ASSERT_EQ(next == tree.end(), expected_next == expected.end());
+            if (expected_next != expected.end())
+            {
+                ASSERT_EQ(next->first, expected_next->first);
+            }
+        }
+        else
+        {
+            ASSERT_EQ(tree.emplace(key, i).second, expected.emplace(key, i).second);
+            ASSERT_EQ(tree.at(key), expected.at(key));
+        }
+    }
+
+    ASSERT_TRUE(agrees_with_map(tree, expected));
+
+    for (int key = -1; key <= 2001; ++key)
+    {
+        auto lower = expected.lower_bound(key);
+        ASSERT_EQ(tree.lower_bound(key) == tree.end(), lower == expected.end());
+        if (lower != expected.end())
+        {
+            ASSERT_EQ(tree.lower_bound(key)->first, lower->first);
+        }
+        ASSERT_EQ(tree.contains(key), expected.contains(key));
+    }
+
+    check(std::as_const(tree), std::as_const(expected));
+    ASSERT_FALSE(::testing::Test::HasFatalFailure());
+
+    auto copy = tree;
+    ASSERT_TRUE(agrees_with_map(copy, expected));
+
+    copy.erase(copy.lower_bound(500), copy.lower_bound(1500));
+    ASSERT_TRUE(agrees_with_map(tree, expected));
+    expected.erase(expected.lower_bound(500), expected.lower_bound(1500));
+    ASSERT_TRUE(agrees_with_map(copy, expected));
+
+    check(std::as_const(copy), std::as_const(expected));
+    ASSERT_FALSE(::testing::Test::HasFatalFailure());
+
+    while (!expected.empty())
+    {
+        int key = expected.begin()->first;
+        copy.erase(copy.begin());
+        expected.erase(key);
+    }
+
+    ASSERT_TRUE(copy.empty());
+    ASSERT_TRUE(copy.begin() == copy.end());
+}
+
+template<typename tree_type>
+void random_operations_test(std::mt19937 &engine)
+{
+    random_operations_test<tree_type>(engine, [](tree_type const &, std::map<int, int> const &) {});
+}
+
+#endif //MP_OS_INDEXING_TREE_RANDOM_OPERATIONS_TEST_H
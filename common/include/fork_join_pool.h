@@ -0,0 +1,180 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_FORK_JOIN_POOL_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_FORK_JOIN_POOL_H
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Work-stealing pool for nested fork-join parallelism.
+ *  Every worker owns a deque: forked tasks are pushed and popped at its back,
+ *  idle workers steal from the front of the others. A thread waiting for a stolen task
+ *  runs other tasks meanwhile, so nested invoke calls never block a worker.
+ *  Threads outside of the pool share one extra deque and help the same way.
+ */
+class fork_join_pool final
+{
+
+private:
+
+    struct task
+    {
+        void (*run)(task &) noexcept;
+
+        std::atomic<bool> done;
+
+        std::exception_ptr error;
+
+        explicit task(void (*r)(task &) noexcept) noexcept :
+            run(r), done(false), error(nullptr) {}
+    };
+
+    template<typename F>
+    struct bound_task final :
+        task
+    {
+        F &function;
+
+        explicit bound_task(F &f) noexcept :
+            task(&bound_task::execute), function(f) {}
+
+        static void execute(task &t) noexcept
+        {
+            auto &self = static_cast<bound_task &>(t);
+
+            try
+            {
+                self.function();
+            }
+            catch (...)
+            {
+                self.error = std::current_exception();
+            }
+
+            self.done.store(true, std::memory_order_release);
+        }
+    };
+
+    struct task_deque
+    {
+        std::mutex mutex;
+
+        std::deque<task *> tasks;
+    };
+
+    std::vector<std::unique_ptr<task_deque>> _deques;
+
+    std::vector<std::thread> _workers;
+
+    std::atomic<size_t> _queued = 0;
+
+    std::mutex _idle_mutex;
+
+    std::condition_variable _idle;
+
+    bool _stop = false;
+
+public:
+
+    /** threads counts the calling thread, so threads - 1 workers are started.
+     *  0 means std::thread::hardware_concurrency()
+     */
+    explicit fork_join_pool(
+        size_t threads = 0);
+
+    fork_join_pool(
+        fork_join_pool const &other) = delete;
+
+    fork_join_pool &operator=(
+        fork_join_pool const &other) = delete;
+
+    ~fork_join_pool() noexcept;
+
+    size_t concurrency() const noexcept;
+
+    /** Runs left and right, possibly in parallel, and returns when both are done.
+     *  If any of them throws, the exception is rethrown after both have finished, left one first
+     */
+    template<std::invocable Left, std::invocable Right>
+    void invoke(
+        Left &&left,
+        Right &&right);
+
+private:
+
+    size_t own_deque() const noexcept;
+
+    void push(
+        size_t deque,
+        task *t);
+
+    // Takes t back if nobody stole it yet
+    bool take_back(
+        size_t deque,
+        task *t) noexcept;
+
+    task *pop(
+        size_t deque) noexcept;
+
+    task *steal(
+        size_t thief) noexcept;
+
+    // Runs other tasks until t is done
+    void help_while_pending(
+        size_t deque,
+        task &t);
+
+    void work(
+        size_t index);
+
+    void shut_down() noexcept;
+
+};
+
+template<std::invocable Left, std::invocable Right>
+void fork_join_pool::invoke(
+    Left &&left,
+    Right &&right)
+{
+    bound_task<Right> forked(right);
+    size_t deque = own_deque();
+
+    push(deque, &forked);
+
+    std::exception_ptr left_error;
+
+    try
+    {
+        left();
+    }
+    catch (...)
+    {
+        left_error = std::current_exception();
+    }
+
+    if (take_back(deque, &forked))
+    {
+        bound_task<Right>::execute(forked);
+    }
+    else
+    {
+        help_while_pending(deque, forked);
+    }
+
+    if (left_error)
+    {
+        std::rethrow_exception(left_error);
+    }
+
+    if (forked.error)
+    {
+        std::rethrow_exception(forked.error);
+    }
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_FORK_JOIN_POOL_H
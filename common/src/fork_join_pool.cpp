@@ -0,0 +1,215 @@
+#include "../include/fork_join_pool.h"
+
+#include <algorithm>
+
+namespace
+{
+
+    struct worker_identity
+    {
+        fork_join_pool const *pool = nullptr;
+
+        size_t deque = 0;
+    };
+
+    thread_local worker_identity current_worker;
+
+}
+
+fork_join_pool::fork_join_pool(
+    size_t threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    // Deque 0 is shared by threads outside of the pool
+    for (size_t i = 0; i < threads; ++i)
+    {
+        _deques.push_back(std::make_unique<task_deque>());
+    }
+
+    _workers.reserve(threads - 1);
+
+    try
+    {
+        for (size_t i = 1; i < threads; ++i)
+        {
+            _workers.emplace_back(&fork_join_pool::work, this, i);
+        }
+    }
+    catch (...)
+    {
+        shut_down();
+        throw;
+    }
+}
+
+fork_join_pool::~fork_join_pool() noexcept
+{
+    shut_down();
+}
+
+void fork_join_pool::shut_down() noexcept
+{
+    {
+        std::lock_guard lock(_idle_mutex);
+        _stop = true;
+    }
+
+    _idle.notify_all();
+
+    for (auto &worker: _workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+size_t fork_join_pool::concurrency() const noexcept
+{
+    return _workers.size() + 1;
+}
+
+size_t fork_join_pool::own_deque() const noexcept
+{
+    return current_worker.pool == this
+        ? current_worker.deque
+        : 0;
+}
+
+void fork_join_pool::push(
+    size_t deque,
+    task *t)
+{
+    {
+        std::lock_guard lock(_deques[deque]->mutex);
+        _deques[deque]->tasks.push_back(t);
+        _queued.fetch_add(1, std::memory_order_release);
+    }
+
+    // Taking the mutex orders the push before a worker that is about to sleep checks _queued
+    {
+        std::lock_guard lock(_idle_mutex);
+    }
+
+    _idle.notify_one();
+}
+
+bool fork_join_pool::take_back(
+    size_t deque,
+    task *t) noexcept
+{
+    std::lock_guard lock(_deques[deque]->mutex);
+    auto &tasks = _deques[deque]->tasks;
+
+    // The task is at the back unless another outside thread pushed to the shared deque after it
+    auto it = std::find(tasks.rbegin(), tasks.rend(), t);
+
+    if (it == tasks.rend())
+    {
+        return false;
+    }
+
+    tasks.erase(std::next(it).base());
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+fork_join_pool::task *fork_join_pool::pop(
+    size_t deque) noexcept
+{
+    std::lock_guard lock(_deques[deque]->mutex);
+    auto &tasks = _deques[deque]->tasks;
+
+    if (tasks.empty())
+    {
+        return nullptr;
+    }
+
+    task *t = tasks.back();
+    tasks.pop_back();
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+
+    return t;
+}
+
+fork_join_pool::task *fork_join_pool::steal(
+    size_t thief) noexcept
+{
+    // The oldest task of a deque is the largest piece of work it holds
+    for (size_t i = 1; i < _deques.size(); ++i)
+    {
+        auto &victim = *_deques[(thief + i) % _deques.size()];
+        std::lock_guard lock(victim.mutex);
+
+        if (!victim.tasks.empty())
+        {
+            task *t = victim.tasks.front();
+            victim.tasks.pop_front();
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+
+            return t;
+        }
+    }
+
+    return nullptr;
+}
+
+void fork_join_pool::help_while_pending(
+    size_t deque,
+    task &t)
+{
+    while (!t.done.load(std::memory_order_acquire))
+    {
+        task *other = pop(deque);
+
+        if (!other)
+        {
+            other = steal(deque);
+        }
+
+        if (other)
+        {
+            other->run(*other);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void fork_join_pool::work(
+    size_t index)
+{
+    current_worker = {this, index};
+
+    while (true)
+    {
+        task *t = pop(index);
+
+        if (!t)
+        {
+            t = steal(index);
+        }
+
+        if (t)
+        {
+            t->run(*t);
+            continue;
+        }
+
+        std::unique_lock lock(_idle_mutex);
+        _idle.wait(lock, [this] { return _stop || _queued.load(std::memory_order_acquire) > 0; });
+
+        if (_stop)
+        {
+            return;
+        }
+    }
+}